@@ -215,6 +215,85 @@ uint16_t TM_ADC_ReadVbat(ADC_TypeDef* ADCx) {
 }
 #endif
 
+#if defined(STM32F4xx) || defined(STM32F7xx)
+uint8_t TM_ADC_DoubleBufferStart(ADC_TypeDef* ADCx, TM_ADC_Channel_t channel, TM_DMA_DB_t* DB, uint16_t* Buffer0, uint16_t* Buffer1, uint16_t Length, uint32_t Trigger, TM_DMA_DB_Callback_t Callback, void* UserParameters) {
+	ADC_ChannelConfTypeDef sConfig;
+	DMA_Stream_TypeDef* Stream;
+	uint32_t Channel;
+	__IO uint32_t counter;
+	
+	/* Get DMA settings */
+	Stream = ADC1_DMA_STREAM;
+	Channel = ADC1_DMA_CHANNEL;
+#if defined(ADC2)
+	if (ADCx == ADC2) {
+		Stream = ADC2_DMA_STREAM;
+		Channel = ADC2_DMA_CHANNEL;
+	}
+#endif
+#if defined(ADC3)
+	if (ADCx == ADC3) {
+		Stream = ADC3_DMA_STREAM;
+		Channel = ADC3_DMA_CHANNEL;
+	}
+#endif
+
+	/* Check if stream is free */
+	if (Stream->CR & DMA_SxCR_EN) {
+		return 0;
+	}
+	
+	/* Init pin and ADC */
+	TM_ADC_Init(ADCx, channel);
+	
+	/* Configure ADC regular channel */  
+	sConfig.Channel = (uint8_t) channel;
+	sConfig.Rank = 1;
+	sConfig.SamplingTime = ADC_SAMPLETIME_15CYCLES;
+	sConfig.Offset = 0;
+	AdcHandle.Instance = ADCx;
+	HAL_ADC_ConfigChannel(&AdcHandle, &sConfig);
+	
+	/* Start DMA in double buffer mode */
+	TM_DMA_DB_Init(DB, Stream, Channel, DMA_PERIPH_TO_MEMORY, (uint32_t) &ADCx->DR, 2);
+	if (!TM_DMA_DB_Start(DB, Buffer0, Buffer1, Length, Callback, UserParameters)) {
+		return 0;
+	}
+	
+	/* Set trigger and continuous DMA requests */
+	ADCx->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_EXTEN | ADC_CR2_EXTSEL);
+	ADCx->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;
+	if (Trigger == ADC_SOFTWARE_START) {
+		ADCx->CR2 |= ADC_CR2_CONT;
+	} else {
+		ADCx->CR2 |= Trigger | ADC_EXTERNALTRIGCONVEDGE_RISING;
+	}
+	
+	/* Enable ADC and wait for stabilization */
+	if (!(ADCx->CR2 & ADC_CR2_ADON)) {
+		ADCx->CR2 |= ADC_CR2_ADON;
+		counter = ADC_STAB_DELAY_US * (SystemCoreClock / 1000000);
+		while (counter--);
+	}
+	
+	/* Start conversions */
+	if (Trigger == ADC_SOFTWARE_START) {
+		ADCx->CR2 |= ADC_CR2_SWSTART;
+	}
+	
+	/* Sampling has started */
+	return 1;
+}
+
+void TM_ADC_DoubleBufferStop(ADC_TypeDef* ADCx, TM_DMA_DB_t* DB) {
+	/* Stop conversions and DMA requests */
+	ADCx->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_EXTEN | ADC_CR2_DMA | ADC_CR2_DDS);
+	
+	/* Stop DMA */
+	TM_DMA_DB_Stop(DB);
+}
+#endif
+
 /* Private functions */
 static void TM_ADC_INT_Channel_0_Init(ADC_TypeDef* ADCx) {
 	TM_ADC_INT_InitPin(GPIOA, GPIO_PIN_0);
@@ -35,7 +35,7 @@
 @endverbatim
  */
 #ifndef TM_ADC_H
-#define TM_ADC_H 100
+#define TM_ADC_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -90,12 +90,31 @@ CHANNEL   ADC1   ADC2   ADC3
  *
  * Circuit for battery is integrated inside STM32 device.
  * It can measure a battery, connected to VBAT pin, meant for RTC and backup purpose only.
+ *
+ * \par Continuous acquisition with DMA double buffer
+ *
+ * On STM32F4xx and STM32F7xx devices, one channel can be sampled continuously to 2 buffers with DMA in double buffer mode,
+ * check @ref TM_ADC_DoubleBufferStart. Conversions are started by ADC itself (continuous mode) or by external trigger, like timer TRGO.
+ *
+ * Default DMA streams and channels:
+ *
+\verbatim
+ADCx     | DMA  | DMA Stream   | DMA Channel
+
+ADC1     | DMA2 | DMA Stream 4 | DMA Channel 0
+ADC2     | DMA2 | DMA Stream 2 | DMA Channel 1
+ADC3     | DMA2 | DMA Stream 1 | DMA Channel 2
+\endverbatim
  *
  * \par Changelog
  *
 @verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added continuous acquisition with DMA in double buffer mode for STM32F4xx and STM32F7xx
 @endverbatim
  *
  * \par Dependencies
@@ -104,11 +123,15 @@ CHANNEL   ADC1   ADC2   ADC3
  - STM32Fxxx HAL
  - defines.h
  - TM GPIO
+ - TM DMA (STM32F4xx and STM32F7xx only)
 @endverbatim
  */
 #include "stm32fxxx_hal.h"
 #include "defines.h"
 #include "tm_stm32_gpio.h"
+#if defined(STM32F4xx) || defined(STM32F7xx)
+#include "tm_stm32_dma.h"
+#endif
 
 /**
  * @defgroup TM_ADC_Macros
@@ -132,6 +155,24 @@ CHANNEL   ADC1   ADC2   ADC3
 #define ADC_VBAT_MULTI			4
 #endif
 
+/* ADC1 DMA default settings */
+#ifndef ADC1_DMA_STREAM
+#define ADC1_DMA_STREAM         DMA2_Stream4
+#define ADC1_DMA_CHANNEL        DMA_CHANNEL_0
+#endif
+
+/* ADC2 DMA default settings */
+#ifndef ADC2_DMA_STREAM
+#define ADC2_DMA_STREAM         DMA2_Stream2
+#define ADC2_DMA_CHANNEL        DMA_CHANNEL_1
+#endif
+
+/* ADC3 DMA default settings */
+#ifndef ADC3_DMA_STREAM
+#define ADC3_DMA_STREAM         DMA2_Stream1
+#define ADC3_DMA_CHANNEL        DMA_CHANNEL_2
+#endif
+
 /**
  * @}
  */
@@ -221,6 +262,36 @@ void TM_ADC_DisableVbat(void);
  */
 uint16_t TM_ADC_ReadVbat(ADC_TypeDef* ADCx);
 
+#if defined(STM32F4xx) || defined(STM32F7xx) || defined(__DOXYGEN__)
+/**
+ * @brief  Starts continuous sampling of one channel to 2 buffers using DMA in double buffer mode
+ * @note   Callback is called from DMA interrupt each time one buffer is full.
+ *            Buffer passed to callback can be processed until next buffer is full
+ * @param  *ADCx: ADCx peripheral to operate with
+ * @param  channel: channel for ADCx. This parameter can be a value of @ref TM_ADC_Channel_t enumeration
+ * @param  *DB: Pointer to empty @ref TM_DMA_DB_t structure
+ * @param  *Buffer0: Pointer to first buffer
+ * @param  *Buffer1: Pointer to second buffer
+ * @param  Length: Number of samples in each buffer
+ * @param  Trigger: Conversion trigger. Use ADC_SOFTWARE_START for continuous conversions at maximal rate
+ *            or ADC_EXTERNALTRIGCONV_xxx for conversions on external trigger rising edge
+ * @param  Callback: Buffer full callback function. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Start status:
+ *            - 0: DMA stream is busy
+ *            - > 0: Sampling has started
+ */
+uint8_t TM_ADC_DoubleBufferStart(ADC_TypeDef* ADCx, TM_ADC_Channel_t channel, TM_DMA_DB_t* DB, uint16_t* Buffer0, uint16_t* Buffer1, uint16_t Length, uint32_t Trigger, TM_DMA_DB_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Stops continuous sampling started with @ref TM_ADC_DoubleBufferStart
+ * @param  *ADCx: ADCx peripheral to operate with
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure used on start
+ * @retval None
+ */
+void TM_ADC_DoubleBufferStop(ADC_TypeDef* ADCx, TM_DMA_DB_t* DB);
+#endif
+
 /**
  * @}
  */
@@ -0,0 +1,169 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_clock.h"
+
+/* Clock base, updated in timer interrupt */
+typedef struct {
+	uint64_t Base;                   /*!< Clock value when DWT had Last value */
+	uint32_t Last;                   /*!< DWT counter value in last update */
+} TM_CLOCK_Base_t;
+
+/* Two copies, sequence number tells which one is valid */
+static volatile TM_CLOCK_Base_t CLOCK_Base[2];
+static __IO uint32_t CLOCK_Seq = 0;
+
+/* Clock frequency */
+static uint32_t CLOCK_Frequency = 0;
+
+/* Real time reference */
+static uint64_t CLOCK_RefCycles = 0;
+static uint64_t CLOCK_RefNanos = 0;
+
+uint8_t TM_CLOCK_Init(void) {
+	uint32_t clk;
+	
+	/* Enable DWT counter, it is not reset and keeps running from current value */
+	if (!TM_GENERAL_DWTCounterEnable()) {
+		return 0;
+	}
+	
+	/* Reset clock, start counting from current DWT value */
+	CLOCK_Base[0].Base = 0;
+	CLOCK_Base[0].Last = DWT->CYCCNT;
+	CLOCK_Seq = 0;
+	CLOCK_Frequency = HAL_RCC_GetHCLKFreq();
+	
+	/* Get timer clock */
+	if ((uint32_t)CLOCK_TIM >= APB2PERIPH_BASE) {
+		clk = HAL_RCC_GetPCLK2Freq();
+		if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1) {
+			clk *= 2;
+		}
+	} else {
+		clk = HAL_RCC_GetPCLK1Freq();
+		if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+			clk *= 2;
+		}
+	}
+	
+	/* Update interrupt every second, much less than DWT overflow */
+	CLOCK_TIM_CLK_ENABLE();
+	CLOCK_TIM->CR1 = 0;
+	CLOCK_TIM->PSC = clk / 10000 - 1;
+	CLOCK_TIM->ARR = 10000 - 1;
+	CLOCK_TIM->EGR = TIM_EGR_UG;
+	CLOCK_TIM->SR = 0;
+	CLOCK_TIM->DIER = TIM_DIER_UIE;
+	
+	/* Enable interrupt */
+	HAL_NVIC_SetPriority(CLOCK_TIM_IRQ, CLOCK_TIM_NVIC_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(CLOCK_TIM_IRQ);
+	
+	/* Start timer */
+	CLOCK_TIM->CR1 = TIM_CR1_CEN;
+	
+	/* Return OK */
+	return 1;
+}
+
+uint64_t TM_CLOCK_GetCycles(void) {
+	uint32_t seq, last, cnt;
+	uint64_t base;
+	
+	/* Read until base was not changed while reading */
+	do {
+		seq = CLOCK_Seq;
+		base = CLOCK_Base[seq & 1].Base;
+		last = CLOCK_Base[seq & 1].Last;
+		cnt = DWT->CYCCNT;
+	} while (seq != CLOCK_Seq);
+	
+	/* Add cycles since last update */
+	return base + (uint32_t)(cnt - last);
+}
+
+uint32_t TM_CLOCK_GetFrequency(void) {
+	/* Return frequency */
+	return CLOCK_Frequency;
+}
+
+uint64_t TM_CLOCK_CyclesToNanos(uint64_t Cycles) {
+	/* Split to seconds and remainder to prevent overflow */
+	return (Cycles / CLOCK_Frequency) * 1000000000ULL + ((Cycles % CLOCK_Frequency) * 1000000000ULL) / CLOCK_Frequency;
+}
+
+uint64_t TM_CLOCK_CyclesToMicros(uint64_t Cycles) {
+	/* Split to seconds and remainder to prevent overflow */
+	return (Cycles / CLOCK_Frequency) * 1000000ULL + ((Cycles % CLOCK_Frequency) * 1000000ULL) / CLOCK_Frequency;
+}
+
+void TM_CLOCK_SetUnixReference(uint64_t Cycles, uint32_t Unix, uint32_t Nanos) {
+	/* Save reference */
+	CLOCK_RefCycles = Cycles;
+	CLOCK_RefNanos = (uint64_t)Unix * 1000000000ULL + Nanos;
+}
+
+uint32_t TM_CLOCK_ToUnix(uint64_t Cycles, uint32_t* Nanos) {
+	uint64_t ns;
+	
+	/* Get real time in nanoseconds */
+	if (Cycles >= CLOCK_RefCycles) {
+		ns = CLOCK_RefNanos + TM_CLOCK_CyclesToNanos(Cycles - CLOCK_RefCycles);
+	} else {
+		ns = CLOCK_RefNanos - TM_CLOCK_CyclesToNanos(CLOCK_RefCycles - Cycles);
+	}
+	
+	/* Save nanoseconds part */
+	if (Nanos) {
+		*Nanos = (uint32_t)(ns % 1000000000ULL);
+	}
+	
+	/* Return seconds */
+	return (uint32_t)(ns / 1000000000ULL);
+}
+
+/***************************************************/
+/*                Interrupt handler                */
+/***************************************************/
+void CLOCK_TIM_IRQ_HANDLER(void) {
+	uint32_t seq, cnt;
+	
+	/* Check update interrupt */
+	if (CLOCK_TIM->SR & TIM_SR_UIF) {
+		/* Clear flag */
+		CLOCK_TIM->SR = ~TIM_SR_UIF;
+		
+		/* Write new base to unused copy */
+		seq = CLOCK_Seq;
+		cnt = DWT->CYCCNT;
+		CLOCK_Base[(seq + 1) & 1].Base = CLOCK_Base[seq & 1].Base + (uint32_t)(cnt - CLOCK_Base[seq & 1].Last);
+		CLOCK_Base[(seq + 1) & 1].Last = cnt;
+		
+		/* Make new copy valid */
+		__DMB();
+		CLOCK_Seq = seq + 1;
+	}
+}
@@ -0,0 +1,265 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   64-bit monotonic clock with CPU cycle resolution for STM32F4xx and STM32F7xx devices
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_CLOCK_H
+#define TM_CLOCK_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_CLOCK
+ * @brief    64-bit monotonic clock with CPU cycle resolution for STM32F4xx and STM32F7xx devices
+ * @{
+ *
+ * Library extends 32-bit DWT cycle counter to 64-bit value which never overflows in lifetime of device.
+ *
+ * \par How it works
+ *
+ * DWT counter counts CPU cycles and overflows every few seconds (about 20 seconds at 216MHz).
+ * Hardware timer makes update interrupt every second, where current DWT value is added to 64-bit base.
+ * When clock is read, difference between DWT counter and value saved in last interrupt is added to base,
+ * so value is correct even if timer interrupt is pending or blocked, as long as it is not delayed more than one DWT overflow period.
+ *
+ * Two copies of base values are used, one is updated in interrupt and sequence number tells which is valid.
+ * This allows reading clock from main loop and from any interrupt, also with higher priority than timer interrupt,
+ * without disabling interrupts.
+ *
+ * \par Default timer
+ *
+ * By default, TIM7 is used. STM32F401, STM32F410 and STM32F411 devices do not have TIM7,
+ * TIM11 is used there, it is available on all STM32F4xx and STM32F7xx devices.
+ * TIM11 shares interrupt handler with TIM1 trigger and commutation interrupt, so do not use this TIM1 interrupt together with library.
+ * If you want to use other timer, set macros in defines.h file:
+ *
+@code
+//Use TIM6 for clock extension
+#define CLOCK_TIM                 TIM6
+#define CLOCK_TIM_CLK_ENABLE()    __HAL_RCC_TIM6_CLK_ENABLE()
+#define CLOCK_TIM_IRQ             TIM6_DAC_IRQn
+#define CLOCK_TIM_IRQ_HANDLER     TIM6_DAC_IRQHandler
+@endcode
+ *
+ * \par RTC time
+ *
+ * Clock starts at zero on @ref TM_CLOCK_Init. To convert timestamps to real time,
+ * reference point is set from RTC once and later all timestamps are converted to unix time with nanoseconds.
+ *
+@code
+TM_RTC_t RTC_Data;
+uint32_t unix, nanos;
+
+//Get RTC time, subseconds count down from RTC_SYNC_PREDIV in TM RTC library
+TM_RTC_GetDateTime(&RTC_Data, TM_RTC_Format_BIN);
+TM_CLOCK_SetUnixReference(TM_CLOCK_GetCycles(), RTC_Data.Unix, (uint32_t)((RTC_SYNC_PREDIV - RTC_Data.Subseconds) * 1000000000ULL / (RTC_SYNC_PREDIV + 1)));
+
+//Later, convert event timestamp to unix time
+unix = TM_CLOCK_ToUnix(Event_Timestamp, &nanos);
+@endcode
+ *
+ * \note  DWT counter does not count in STOP mode, so clock can not be used together with @ref TM_DELAY_TicklessSleep.
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+
+ Version 1.1
+  - October 19, 2026
+  - TIM11 is default timer on devices without TIM7
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - TM GENERAL
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+
+/* Cortex-M0 does not have DWT cycle counter */
+#if defined(STM32F0xx)
+#error "TM CLOCK library is not supported on STM32F0xx devices"
+#endif
+
+#include "tm_stm32_general.h"
+
+/**
+ * @defgroup TM_CLOCK_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Timer used to extend DWT counter
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CLOCK_TIM
+#if defined(TIM7)
+#define CLOCK_TIM                 TIM7
+#define CLOCK_TIM_CLK_ENABLE()    __HAL_RCC_TIM7_CLK_ENABLE()
+#define CLOCK_TIM_IRQ             TIM7_IRQn
+#define CLOCK_TIM_IRQ_HANDLER     TIM7_IRQHandler
+#else
+/* STM32F401, STM32F410 and STM32F411 do not have TIM7 */
+#define CLOCK_TIM                 TIM11
+#define CLOCK_TIM_CLK_ENABLE()    __HAL_RCC_TIM11_CLK_ENABLE()
+#define CLOCK_TIM_IRQ             TIM1_TRG_COM_TIM11_IRQn
+#define CLOCK_TIM_IRQ_HANDLER     TIM1_TRG_COM_TIM11_IRQHandler
+#endif
+#endif
+
+/**
+ * @brief  NVIC preemption priority for timer interrupt
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CLOCK_TIM_NVIC_PRIORITY
+#define CLOCK_TIM_NVIC_PRIORITY   0x00
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_CLOCK_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes DWT counter and timer for 64-bit clock
+ * @note   Clock starts with zero value
+ * @param  None
+ * @retval DWT counter start status:
+ *           - 0: DWT counter did not start, clock won't work
+ *           - > 0: Clock is ready to use
+ */
+uint8_t TM_CLOCK_Init(void);
+
+/**
+ * @brief  Gets current clock value in units of CPU cycles
+ * @note   Function can be called from any context
+ * @param  None
+ * @retval Number of CPU cycles since @ref TM_CLOCK_Init
+ */
+uint64_t TM_CLOCK_GetCycles(void);
+
+/**
+ * @brief  Gets clock frequency in units of Hz
+ * @param  None
+ * @retval CPU frequency saved on @ref TM_CLOCK_Init
+ */
+uint32_t TM_CLOCK_GetFrequency(void);
+
+/**
+ * @brief  Converts CPU cycles to nanoseconds
+ * @param  Cycles: Number of CPU cycles
+ * @retval Number of nanoseconds
+ */
+uint64_t TM_CLOCK_CyclesToNanos(uint64_t Cycles);
+
+/**
+ * @brief  Converts CPU cycles to microseconds
+ * @param  Cycles: Number of CPU cycles
+ * @retval Number of microseconds
+ */
+uint64_t TM_CLOCK_CyclesToMicros(uint64_t Cycles);
+
+/**
+ * @brief  Gets current clock value in units of nanoseconds
+ * @param  None
+ * @retval Number of nanoseconds since @ref TM_CLOCK_Init
+ * @note   Defined as macro for faster execution
+ */
+#define TM_CLOCK_GetNanos()       TM_CLOCK_CyclesToNanos(TM_CLOCK_GetCycles())
+
+/**
+ * @brief  Gets current clock value in units of microseconds
+ * @param  None
+ * @retval Number of microseconds since @ref TM_CLOCK_Init
+ * @note   Defined as macro for faster execution
+ */
+#define TM_CLOCK_GetMicros()      TM_CLOCK_CyclesToMicros(TM_CLOCK_GetCycles())
+
+/**
+ * @brief  Sets relation between clock and real time
+ * @param  Cycles: Clock value at the moment when real time was read
+ * @param  Unix: Seconds from 01.01.1970 00:00:00 at that moment
+ * @param  Nanos: Nanoseconds part of real time
+ * @retval None
+ */
+void TM_CLOCK_SetUnixReference(uint64_t Cycles, uint32_t Unix, uint32_t Nanos);
+
+/**
+ * @brief  Converts clock value to real time
+ * @note   @ref TM_CLOCK_SetUnixReference must be called first
+ * @param  Cycles: Clock value to convert
+ * @param  *Nanos: Pointer to variable to store nanoseconds part of time. Set to NULL if not used
+ * @retval Seconds from 01.01.1970 00:00:00
+ */
+uint32_t TM_CLOCK_ToUnix(uint64_t Cycles, uint32_t* Nanos);
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,6 +25,16 @@
  */
 #include "tm_stm32_cpu_load.h"
 
+#if CPULOAD_PROFILE
+#include "stdio.h"
+
+/* Profiler probes */
+static TM_CPULOAD_Probe_t CPULOAD_Probes[CPULOAD_PROFILE_PROBES];
+
+/* Time of last reset in milliseconds */
+static uint32_t CPULOAD_ProfileTime = 0;
+#endif
+
 uint8_t TM_CPULOAD_Init(TM_CPULOAD_t* CPU_Load) {
 	/* Set values to 0 */
 	CPU_Load->Load = 0;
@@ -39,8 +49,9 @@ uint8_t TM_CPULOAD_Init(TM_CPULOAD_t* CPU_Load) {
 uint8_t TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load) {
 	uint32_t t;
 	static uint32_t l = 0;
-	static uint32_t WorkingTime = 0;
-	static uint32_t SleepingTime = 0;
+	static uint64_t WorkingTime = 0;
+	static uint64_t SleepingTime = 0;
+	uint64_t total;
 	uint8_t irq_status;
 	
 	/* Add to working time */
@@ -55,9 +66,14 @@ uint8_t TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load) {
 	/* Disable interrupts */
 	__disable_irq();
 	
+#if CPULOAD_TICKLESS
+	/* Go to STOP mode until next timer expires, DWT does not count there */
+	SleepingTime += (uint64_t)TM_DELAY_TicklessSleep() * (HAL_RCC_GetHCLKFreq() / 1000);
+#else
 	/* Go to sleep mode */
 	/* Wait for wake up interrupt, systick can do it too */
 	__WFI();
+#endif
 	
 	/* Increase number of sleeping time in CPU cycles */
 	SleepingTime += DWT->CYCCNT - t;
@@ -74,13 +90,23 @@ uint8_t TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load) {
 	CPU_Load->Updated = 0;
 	
 	/* Every 1000ms print CPU load via USART */
-	if ((SleepingTime + WorkingTime) >= HAL_RCC_GetHCLKFreq()) {
-		/* Save values */
-		CPU_Load->SCNT = SleepingTime;
-		CPU_Load->WCNT = WorkingTime;
-		CPU_Load->Load = ((float)WorkingTime / (float)(SleepingTime + WorkingTime) * 100);
+	total = SleepingTime + WorkingTime;
+	if (total >= HAL_RCC_GetHCLKFreq()) {
+		/* Calculate load */
+		CPU_Load->Load = ((float)WorkingTime / (float)total * 100);
 		CPU_Load->Updated = 1;
 		
+		/* Long tickless sleep can exceed 32 bits, scale both values down */
+		while (total > 0xFFFFFFFFULL) {
+			SleepingTime >>= 1;
+			WorkingTime >>= 1;
+			total >>= 1;
+		}
+		
+		/* Save values */
+		CPU_Load->SCNT = (uint32_t)SleepingTime;
+		CPU_Load->WCNT = (uint32_t)WorkingTime;
+		
 		/* Reset time */
 		SleepingTime = 0;
 		WorkingTime = 0;
@@ -89,3 +115,125 @@ uint8_t TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load) {
 	/* Return updated status */
 	return CPU_Load->Updated;
 }
+
+#if CPULOAD_PROFILE
+void TM_CPULOAD_ProfileAdd(uint8_t id, uint32_t cycles) {
+	TM_CPULOAD_Probe_t* probe;
+	uint32_t irq;
+	
+	/* Check ID */
+	if (id >= CPULOAD_PROFILE_PROBES) {
+		return;
+	}
+	probe = &CPULOAD_Probes[id];
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Update values */
+	if (!probe->Count || cycles < probe->Min) {
+		probe->Min = cycles;
+	}
+	if (cycles > probe->Max) {
+		probe->Max = cycles;
+	}
+	probe->Total += cycles;
+	probe->Count++;
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+}
+
+void TM_CPULOAD_ProfileSetName(uint8_t id, const char* name) {
+	/* Set name */
+	if (id < CPULOAD_PROFILE_PROBES) {
+		CPULOAD_Probes[id].Name = name;
+	}
+}
+
+uint8_t TM_CPULOAD_ProfileGet(uint8_t id, TM_CPULOAD_Probe_t* Probe) {
+	uint32_t irq;
+	
+	/* Check ID */
+	if (id >= CPULOAD_PROFILE_PROBES) {
+		return 0;
+	}
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Copy values */
+	*Probe = CPULOAD_Probes[id];
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Return status */
+	return Probe->Count > 0;
+}
+
+void TM_CPULOAD_ProfileReset(void) {
+	uint8_t i;
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Reset all probes */
+	for (i = 0; i < CPULOAD_PROFILE_PROBES; i++) {
+		CPULOAD_Probes[i].Count = 0;
+		CPULOAD_Probes[i].Min = 0;
+		CPULOAD_Probes[i].Max = 0;
+		CPULOAD_Probes[i].Total = 0;
+	}
+	CPULOAD_ProfileTime = HAL_GetTick();
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+}
+
+void TM_CPULOAD_ProfileDump(void (*Output)(const char*)) {
+	TM_CPULOAD_Probe_t probe;
+	uint64_t time;
+	uint32_t load;
+	uint8_t i;
+	char str[100];
+	
+	/* Get number of cycles since reset */
+	time = (uint64_t)(HAL_GetTick() - CPULOAD_ProfileTime) * (HAL_RCC_GetHCLKFreq() / 1000);
+	
+	/* Print header */
+	Output("Probe            Calls        Min        Avg        Max    Load\n");
+	
+	/* Print all used probes */
+	for (i = 0; i < CPULOAD_PROFILE_PROBES; i++) {
+		if (!TM_CPULOAD_ProfileGet(i, &probe)) {
+			continue;
+		}
+		
+		/* Load in units of 0.01% */
+		load = time ? (uint32_t)(probe.Total * 10000 / time) : 0;
+		
+		/* Format line */
+		sprintf(str, "%-12.12s %9lu %10lu %10lu %10lu %3lu.%02lu%%\n",
+			probe.Name ? probe.Name : "-",
+			(unsigned long)probe.Count,
+			(unsigned long)probe.Min,
+			(unsigned long)(probe.Total / probe.Count),
+			(unsigned long)probe.Max,
+			(unsigned long)(load / 100),
+			(unsigned long)(load % 100)
+		);
+		Output(str);
+	}
+}
+#endif
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_CPU_LOAD_H
-#define TM_CPU_LOAD_H 100
+#define TM_CPU_LOAD_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -51,12 +51,55 @@ extern "C" {
  * @defgroup TM_CPULOAD
  * @brief    CPU load monitoring for STM32F4/7xx - http://stm32f4-discovery.net/2015/08/hal-library-19-cpu-load-monitor-for-stm32fxxx/
  * @{
+ *
+ * \par Tickless sleep
+ *
+ * When <code>CPULOAD_TICKLESS</code> is set to 1, @ref TM_CPULOAD_GoToSleepMode uses @ref TM_DELAY_TicklessSleep
+ * and device goes to STOP mode until next software timer expires. DWT counter does not count in STOP mode,
+ * so time spent there is added to sleeping time from returned number of milliseconds.
+ *
+ * \par Profiler
+ *
+ * CPU load only tells how much time CPU works. To find out which interrupt or function takes this time,
+ * code can be instrumented with probes. Each probe has ID from 0 to <code>CPULOAD_PROFILE_PROBES - 1</code>
+ * and collects number of calls, minimal, maximal and total number of cycles between enter and exit.
+ *
+ * Start cycle is saved to local variable, so probes can be nested and same probe can be used in reentrant code.
+ * When <code>CPULOAD_PROFILE</code> is 0, probe macros are empty and do not add any code.
+ *
+@code
+//Enable profiler in defines.h
+#define CPULOAD_PROFILE         1
+
+//Probe IDs
+#define PROBE_USART_RX          0
+#define PROBE_SYSTICK           1
+
+void USART1_IRQHandler(void) {
+	TM_CPULOAD_PROFILE_ENTER(PROBE_USART_RX);
+	//Interrupt processing
+	TM_CPULOAD_PROFILE_EXIT(PROBE_USART_RX);
+}
+
+//Set names once and print report periodically
+TM_CPULOAD_ProfileSetName(PROBE_USART_RX, "USART RX");
+TM_CPULOAD_ProfileDump(Print_Function);
+@endcode
  *
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added optional tickless sleep using TM DELAY library
+
+ Version 1.2
+  - October 19, 2026
+  - Added per interrupt and per function cycle profiler
+  - Cycles are accumulated in 64-bit, long tickless sleep does not overflow anymore
 \endverbatim
  *
  * \par Dependencies
@@ -65,6 +108,7 @@ extern "C" {
  - STM32Fxxx HAL
  - defines.h
  - TM GENERAL
+ - TM DELAY, when CPULOAD_TICKLESS is used
 \endverbatim
  */
 
@@ -77,7 +121,35 @@ extern "C" {
  * @brief    Library defines
  * @{
  */
-/* Macros here */
+
+/**
+ * @brief  Set to 1 to use STOP mode with @ref TM_DELAY_TicklessSleep instead of sleep mode
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CPULOAD_TICKLESS
+#define CPULOAD_TICKLESS    0
+#endif
+
+#if CPULOAD_TICKLESS
+#include "tm_stm32_delay.h"
+#endif
+
+/**
+ * @brief  Set to 1 to enable profiler probes
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CPULOAD_PROFILE
+#define CPULOAD_PROFILE     0
+#endif
+
+/**
+ * @brief  Number of profiler probes
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CPULOAD_PROFILE_PROBES
+#define CPULOAD_PROFILE_PROBES  16
+#endif
+
 /**
  * @}
  */
@@ -94,10 +166,21 @@ extern "C" {
 typedef struct {
 	float Load;      /*!< CPU load percentage */
 	uint8_t Updated; /*!< Set to 1 when new CPU load is calculated */
-	uint32_t WCNT;   /*!< Number of working cycles in one period. Meant for private use */
-	uint32_t SCNT;   /*!< Number of sleeping cycles in one period. Meant for private use */
+	uint32_t WCNT;   /*!< Number of working cycles in one period, scaled down together with SCNT when period is longer than 32-bit. Meant for private use */
+	uint32_t SCNT;   /*!< Number of sleeping cycles in one period, scaled down together with WCNT when period is longer than 32-bit. Meant for private use */
 } TM_CPULOAD_t;
 
+/**
+ * @brief  Profiler probe structure
+ */
+typedef struct {
+	const char* Name; /*!< Probe name used in report */
+	uint32_t Count;   /*!< Number of calls */
+	uint32_t Min;     /*!< Minimal number of cycles in one call */
+	uint32_t Max;     /*!< Maximal number of cycles in one call */
+	uint64_t Total;   /*!< Total number of cycles in all calls */
+} TM_CPULOAD_Probe_t;
+
 /**
  * @}
  */
@@ -128,6 +211,71 @@ uint8_t TM_CPULOAD_Init(TM_CPULOAD_t* CPU_Load);
  */
 uint8_t TM_CPULOAD_GoToSleepMode(TM_CPULOAD_t* CPU_Load);
 
+#if CPULOAD_PROFILE || defined(__DOXYGEN__)
+
+/**
+ * @brief  Starts measurement for probe
+ * @note   Must be used at the beginning of block, it declares local variable
+ * @param  id: Probe ID, must be name or number
+ * @retval None
+ */
+#define TM_CPULOAD_PROFILE_ENTER(id)      uint32_t TM_CPULOAD_Probe_##id = DWT->CYCCNT
+
+/**
+ * @brief  Ends measurement for probe and adds result to probe
+ * @param  id: Probe ID, same as used in @ref TM_CPULOAD_PROFILE_ENTER
+ * @retval None
+ */
+#define TM_CPULOAD_PROFILE_EXIT(id)       TM_CPULOAD_ProfileAdd((id), DWT->CYCCNT - TM_CPULOAD_Probe_##id)
+
+/**
+ * @brief  Adds measured number of cycles to probe
+ * @note   Called from @ref TM_CPULOAD_PROFILE_EXIT macro
+ * @param  id: Probe ID
+ * @param  cycles: Number of cycles for one call
+ * @retval None
+ */
+void TM_CPULOAD_ProfileAdd(uint8_t id, uint32_t cycles);
+
+/**
+ * @brief  Sets probe name used in report
+ * @param  id: Probe ID
+ * @param  *name: Pointer to constant name string
+ * @retval None
+ */
+void TM_CPULOAD_ProfileSetName(uint8_t id, const char* name);
+
+/**
+ * @brief  Gets copy of probe values
+ * @param  id: Probe ID
+ * @param  *Probe: Pointer to @ref TM_CPULOAD_Probe_t structure to save values to
+ * @retval Copy status:
+ *           - 0: Probe ID is not valid or probe was not called yet
+ *           - > 0: Values are copied
+ */
+uint8_t TM_CPULOAD_ProfileGet(uint8_t id, TM_CPULOAD_Probe_t* Probe);
+
+/**
+ * @brief  Resets values of all probes, names are kept
+ * @param  None
+ * @retval None
+ */
+void TM_CPULOAD_ProfileReset(void);
+
+/**
+ * @brief  Prints report of all used probes, one line per probe
+ * @note   Line contains name, number of calls, minimal, average and maximal cycles per call
+ *            and percentage of CPU time since last reset
+ * @param  *Output: Pointer to function which prints one line
+ * @retval None
+ */
+void TM_CPULOAD_ProfileDump(void (*Output)(const char*));
+
+#else
+#define TM_CPULOAD_PROFILE_ENTER(id)
+#define TM_CPULOAD_PROFILE_EXIT(id)
+#endif
+
 /**
  * @}
  */
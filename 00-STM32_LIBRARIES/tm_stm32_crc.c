@@ -25,6 +25,54 @@
  */
 #include "tm_stm32_crc.h"
 
+/* Predefined CRC specifications */
+const TM_CRC_Spec_t TM_CRC_Spec_CRC8_Maxim = {8, 1, 1, 0x31, 0x00, 0x00, 0xA1};
+const TM_CRC_Spec_t TM_CRC_Spec_CRC16_Modbus = {16, 1, 1, 0x8005, 0xFFFF, 0x0000, 0x4B37};
+const TM_CRC_Spec_t TM_CRC_Spec_CRC16_CCITT = {16, 0, 0, 0x1021, 0xFFFF, 0x0000, 0x29B1};
+const TM_CRC_Spec_t TM_CRC_Spec_CRC32_ISO_HDLC = {32, 1, 1, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, 0xCBF43926};
+
+/* Mask for CRC width */
+#define CRC_MASK(width)       ((width) >= 32 ? 0xFFFFFFFFUL : ((1UL << (width)) - 1))
+
+/* Check if CRC unit can calculate CRC with programmable polynomial */
+#if defined(CRC_POL_POL)
+#define CRC_HW_SPEC(spec)     ((spec)->Width == 7 || (spec)->Width == 8 || (spec)->Width == 16 || (spec)->Width == 32)
+#else
+#define CRC_HW_SPEC(spec)     0
+#endif
+
+static uint32_t TM_CRC_INT_Reflect(uint32_t Value, uint8_t Bits);
+static void TM_CRC_INT_SoftUpdate(TM_CRC_Ctx_t* Ctx, const uint8_t* Data, uint32_t Length);
+#if defined(CRC_POL_POL)
+static void TM_CRC_INT_HardUpdate(TM_CRC_Ctx_t* Ctx, const uint8_t* Data, uint32_t Length);
+#endif
+
+#if defined(STM32F4xx) || defined(STM32F7xx)
+/* Maximal number of words in one DMA transfer */
+#define CRC_DMA_MAX_ITEMS     0xFFFF
+
+/* DMA calculation state */
+typedef struct {
+	const uint8_t* Source;      /*!< Next address to feed */
+	uint32_t Words;             /*!< Remaining words for DMA */
+	uint8_t Tail;               /*!< Remaining bytes at the end, written by CPU */
+	__IO uint8_t Busy;          /*!< Set to 1 while DMA calculation is in progress */
+	TM_CRC_Callback_t Callback; /*!< Finished callback */
+	void* UserParameters;       /*!< User parameters for callback */
+} TM_CRC_DMA_t;
+
+static TM_CRC_DMA_t CRC_DMA;
+
+/* Private functions */
+static void TM_CRC_INT_DMAStart(void);
+static uint8_t TM_CRC_INT_DMAHandler(DMA_Stream_TypeDef* DMA_Stream, uint32_t Flags, void* Param);
+
+/* CRC unit is used by DMA calculation */
+#define CRC_HW_BUSY()         (CRC_DMA.Busy)
+#else
+#define CRC_HW_BUSY()         0
+#endif
+
 void TM_CRC_Init(void) {
 	/* Enable CRC clock */
 	__HAL_RCC_CRC_CLK_ENABLE();
@@ -119,3 +167,358 @@ uint32_t TM_CRC_Calculate32(uint32_t* arr, uint32_t count, uint8_t reset) {
 	/* Return data */
 	return CRC->DR;
 }
+
+#if defined(STM32F4xx) || defined(STM32F7xx)
+TM_CRC_Result_t TM_CRC_CalculateDMA(const uint8_t* arr, uint32_t count, uint8_t reset, TM_CRC_Callback_t Callback, void* UserParameters) {
+	uint32_t value;
+	
+	/* Check if CRC unit is in use */
+	if (CRC_DMA.Busy) {
+		return TM_CRC_Result_Busy;
+	}
+	
+	/* Calculate small or not aligned buffers by CPU */
+	if (count < CRC_DMA_THRESHOLD || ((uint32_t)arr & 0x03)) {
+		value = TM_CRC_Calculate8((uint8_t *)arr, count, reset);
+		if (Callback) {
+			Callback(value, 0, UserParameters);
+		}
+		return TM_CRC_Result_CPU;
+	}
+	
+	/* Reset CRC data register if necessary */
+	if (reset) {
+		CRC->CR = CRC_CR_RESET;
+	}
+	
+	/* Save parameters */
+	CRC_DMA.Source = arr;
+	CRC_DMA.Words = count >> 2;
+	CRC_DMA.Tail = count & 0x03;
+	CRC_DMA.Callback = Callback;
+	CRC_DMA.UserParameters = UserParameters;
+	CRC_DMA.Busy = 1;
+	
+#if defined(STM32F7xx)
+	/* Write data from cache to memory */
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_CleanDCache_by_Addr((uint32_t *)((uint32_t)arr & ~0x1FUL), count + ((uint32_t)arr & 0x1F));
+	}
+#endif
+	
+	/* Enable DMA clock and take stream interrupts */
+	CRC_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+	while (CRC_DMA_STREAM->CR & DMA_SxCR_EN);
+	TM_DMA_Init(CRC_DMA_STREAM, NULL);
+	TM_DMA_SetHandler(CRC_DMA_STREAM, TM_CRC_INT_DMAHandler, NULL);
+	TM_DMA_EnableInterrupts(CRC_DMA_STREAM);
+	
+	/* Start first transfer */
+	TM_CRC_INT_DMAStart();
+	
+	/* Return started */
+	return TM_CRC_Result_DMA;
+}
+
+uint8_t TM_CRC_DMABusy(void) {
+	/* Return busy status */
+	return CRC_DMA.Busy;
+}
+
+/* Starts DMA transfer of next part of buffer */
+static void TM_CRC_INT_DMAStart(void) {
+	uint32_t items = CRC_DMA.Words > CRC_DMA_MAX_ITEMS ? CRC_DMA_MAX_ITEMS : CRC_DMA.Words;
+	
+	/* Clear flags */
+	TM_DMA_ClearFlag(CRC_DMA_STREAM, DMA_FLAG_ALL);
+	
+	/* Source is on peripheral port with increment, CRC data register is fixed destination */
+	CRC_DMA_STREAM->PAR = (uint32_t)CRC_DMA.Source;
+	CRC_DMA_STREAM->M0AR = (uint32_t)&CRC->DR;
+	CRC_DMA_STREAM->NDTR = items;
+	CRC_DMA_STREAM->FCR = DMA_SxFCR_DMDIS | DMA_FIFO_THRESHOLD_FULL;
+	CRC_DMA_STREAM->CR = CRC_DMA_CHANNEL | DMA_MEMORY_TO_MEMORY | DMA_PINC_ENABLE |
+		DMA_PDATAALIGN_WORD | DMA_MDATAALIGN_WORD | DMA_PRIORITY_LOW | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	
+	/* Update state */
+	CRC_DMA.Source += items * 4;
+	CRC_DMA.Words -= items;
+	
+	/* Start */
+	CRC_DMA_STREAM->CR |= DMA_SxCR_EN;
+}
+
+/* Called from DMA interrupt */
+static uint8_t TM_CRC_INT_DMAHandler(DMA_Stream_TypeDef* DMA_Stream, uint32_t Flags, void* Param) {
+	uint8_t error = 0;
+	
+	/* Stream is not in use */
+	if (!CRC_DMA.Busy) {
+		return 0;
+	}
+	
+	/* Check for errors */
+	if (Flags & DMA_FLAG_TEIF) {
+		DMA_Stream->CR &= ~DMA_SxCR_EN;
+		error = 1;
+	} else if (Flags & DMA_FLAG_TCIF) {
+		/* Continue with next part */
+		if (CRC_DMA.Words) {
+			TM_CRC_INT_DMAStart();
+			return 1;
+		}
+		
+		/* Write remaining bytes */
+		for (; CRC_DMA.Tail; CRC_DMA.Tail--) {
+			*((__IO uint8_t *)&CRC->DR) = *CRC_DMA.Source++;
+		}
+	} else {
+		/* Not finished yet */
+		return 1;
+	}
+	
+	/* Calculation finished */
+	CRC_DMA.Busy = 0;
+	if (CRC_DMA.Callback) {
+		CRC_DMA.Callback(CRC->DR, error, CRC_DMA.UserParameters);
+	}
+	
+	/* Interrupt handled */
+	return 1;
+}
+#endif
+
+void TM_CRC_SpecInit(TM_CRC_Ctx_t* Ctx, const TM_CRC_Spec_t* Spec, uint32_t* Table) {
+	uint32_t i, j, c, poly;
+	
+	/* Save parameters */
+	Ctx->Spec = Spec;
+	Ctx->Table = NULL;
+	
+	/* Build tables for software calculation */
+	if (!CRC_HW_SPEC(Spec) && Table != NULL) {
+		if (Spec->RefIn) {
+			/* Reflected register, LSB first */
+			poly = TM_CRC_INT_Reflect(Spec->Poly, Spec->Width);
+			for (i = 0; i < 256; i++) {
+				c = i;
+				for (j = 0; j < 8; j++) {
+					c = (c & 1) ? ((c >> 1) ^ poly) : (c >> 1);
+				}
+				Table[i] = c;
+			}
+			for (i = 256; i < TM_CRC_TABLE_SIZE; i++) {
+				Table[i] = (Table[i - 256] >> 8) ^ Table[Table[i - 256] & 0xFF];
+			}
+		} else {
+			/* Register aligned to MSB, MSB first */
+			poly = Spec->Poly << (32 - Spec->Width);
+			for (i = 0; i < 256; i++) {
+				c = i << 24;
+				for (j = 0; j < 8; j++) {
+					c = (c & 0x80000000UL) ? ((c << 1) ^ poly) : (c << 1);
+				}
+				Table[i] = c;
+			}
+			for (i = 256; i < TM_CRC_TABLE_SIZE; i++) {
+				Table[i] = (Table[i - 256] << 8) ^ Table[Table[i - 256] >> 24];
+			}
+		}
+		Ctx->Table = Table;
+	}
+	
+	/* Start calculation */
+	TM_CRC_SpecStart(Ctx);
+}
+
+void TM_CRC_SpecStart(TM_CRC_Ctx_t* Ctx) {
+	const TM_CRC_Spec_t* spec = Ctx->Spec;
+	
+	/* Set initial register value */
+	if (CRC_HW_SPEC(spec)) {
+		Ctx->Value = spec->Init & CRC_MASK(spec->Width);
+	} else if (spec->RefIn) {
+		Ctx->Value = TM_CRC_INT_Reflect(spec->Init, spec->Width);
+	} else {
+		Ctx->Value = spec->Init << (32 - spec->Width);
+	}
+}
+
+void TM_CRC_SpecUpdate(TM_CRC_Ctx_t* Ctx, const void* Data, uint32_t Length) {
+#if defined(CRC_POL_POL)
+	const TM_CRC_Spec_t* spec = Ctx->Spec;
+	
+	/* Use hardware if possible */
+	if (CRC_HW_SPEC(spec)) {
+		if (!CRC_HW_BUSY()) {
+			TM_CRC_INT_HardUpdate(Ctx, (const uint8_t *)Data, Length);
+			return;
+		}
+		
+		/* CRC unit is used by DMA, continue in software, convert register to software format and back */
+		Ctx->Value = spec->RefIn ? TM_CRC_INT_Reflect(Ctx->Value, spec->Width) : (Ctx->Value << (32 - spec->Width));
+		TM_CRC_INT_SoftUpdate(Ctx, (const uint8_t *)Data, Length);
+		Ctx->Value = spec->RefIn ? TM_CRC_INT_Reflect(Ctx->Value, spec->Width) : (Ctx->Value >> (32 - spec->Width));
+		return;
+	}
+#endif
+	
+	/* Software calculation */
+	TM_CRC_INT_SoftUpdate(Ctx, (const uint8_t *)Data, Length);
+}
+
+uint32_t TM_CRC_SpecFinish(TM_CRC_Ctx_t* Ctx) {
+	const TM_CRC_Spec_t* spec = Ctx->Spec;
+	uint32_t value;
+	
+	/* Get register value, reflected register is already in output order */
+	if (!CRC_HW_SPEC(spec) && spec->RefIn) {
+		value = spec->RefOut ? Ctx->Value : TM_CRC_INT_Reflect(Ctx->Value, spec->Width);
+	} else {
+		value = CRC_HW_SPEC(spec) ? Ctx->Value : (Ctx->Value >> (32 - spec->Width));
+		if (spec->RefOut) {
+			value = TM_CRC_INT_Reflect(value, spec->Width);
+		}
+	}
+	
+	/* Final XOR */
+	return (value ^ spec->XorOut) & CRC_MASK(spec->Width);
+}
+
+uint32_t TM_CRC_SpecCalculate(TM_CRC_Ctx_t* Ctx, const void* Data, uint32_t Length) {
+	/* Calculate in one call */
+	TM_CRC_SpecStart(Ctx);
+	TM_CRC_SpecUpdate(Ctx, Data, Length);
+	return TM_CRC_SpecFinish(Ctx);
+}
+
+uint8_t TM_CRC_SpecCheck(TM_CRC_Ctx_t* Ctx) {
+	/* Compare with check value */
+	return TM_CRC_SpecCalculate(Ctx, "123456789", 9) == Ctx->Spec->Check;
+}
+
+/* Reflects lowest bits of value */
+static uint32_t TM_CRC_INT_Reflect(uint32_t Value, uint8_t Bits) {
+	uint32_t res = 0;
+	
+	/* Swap bits */
+	while (Bits--) {
+		res = (res << 1) | (Value & 1);
+		Value >>= 1;
+	}
+	return res;
+}
+
+/* Software calculation with slicing-by-8 tables or bit by bit */
+static void TM_CRC_INT_SoftUpdate(TM_CRC_Ctx_t* Ctx, const uint8_t* Data, uint32_t Length) {
+	const uint32_t* t = Ctx->Table;
+	uint32_t crc = Ctx->Value;
+	uint32_t poly;
+	uint8_t i;
+	
+	if (Ctx->Spec->RefIn) {
+		if (t) {
+			/* 8 bytes at a time */
+			for (; Length >= 8; Length -= 8, Data += 8) {
+				crc ^= (uint32_t)Data[0] | ((uint32_t)Data[1] << 8) | ((uint32_t)Data[2] << 16) | ((uint32_t)Data[3] << 24);
+				crc = t[7 * 256 + (crc & 0xFF)] ^ t[6 * 256 + ((crc >> 8) & 0xFF)] ^
+				      t[5 * 256 + ((crc >> 16) & 0xFF)] ^ t[4 * 256 + (crc >> 24)] ^
+				      t[3 * 256 + Data[4]] ^ t[2 * 256 + Data[5]] ^ t[256 + Data[6]] ^ t[Data[7]];
+			}
+			
+			/* Remaining bytes */
+			while (Length--) {
+				crc = (crc >> 8) ^ t[(crc ^ *Data++) & 0xFF];
+			}
+		} else {
+			/* Bit by bit */
+			poly = TM_CRC_INT_Reflect(Ctx->Spec->Poly, Ctx->Spec->Width);
+			while (Length--) {
+				crc ^= *Data++;
+				for (i = 0; i < 8; i++) {
+					crc = (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+				}
+			}
+		}
+	} else {
+		if (t) {
+			/* 8 bytes at a time */
+			for (; Length >= 8; Length -= 8, Data += 8) {
+				crc ^= ((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | (uint32_t)Data[3];
+				crc = t[7 * 256 + (crc >> 24)] ^ t[6 * 256 + ((crc >> 16) & 0xFF)] ^
+				      t[5 * 256 + ((crc >> 8) & 0xFF)] ^ t[4 * 256 + (crc & 0xFF)] ^
+				      t[3 * 256 + Data[4]] ^ t[2 * 256 + Data[5]] ^ t[256 + Data[6]] ^ t[Data[7]];
+			}
+			
+			/* Remaining bytes */
+			while (Length--) {
+				crc = (crc << 8) ^ t[(crc >> 24) ^ *Data++];
+			}
+		} else {
+			/* Bit by bit */
+			poly = Ctx->Spec->Poly << (32 - Ctx->Spec->Width);
+			while (Length--) {
+				crc ^= (uint32_t)*Data++ << 24;
+				for (i = 0; i < 8; i++) {
+					crc = (crc & 0x80000000UL) ? ((crc << 1) ^ poly) : (crc << 1);
+				}
+			}
+		}
+	}
+	
+	/* Save register */
+	Ctx->Value = crc;
+}
+
+#if defined(CRC_POL_POL)
+/* Hardware calculation with programmable polynomial */
+static void TM_CRC_INT_HardUpdate(TM_CRC_Ctx_t* Ctx, const uint8_t* Data, uint32_t Length) {
+	const TM_CRC_Spec_t* spec = Ctx->Spec;
+	uint32_t cr;
+	
+	/* Set polynomial size */
+	if (spec->Width == 7) {
+		cr = CRC_CR_POLYSIZE_0 | CRC_CR_POLYSIZE_1;
+	} else if (spec->Width == 8) {
+		cr = CRC_CR_POLYSIZE_1;
+	} else if (spec->Width == 16) {
+		cr = CRC_CR_POLYSIZE_0;
+	} else {
+		cr = 0;
+	}
+	
+	/* Reflect input bytes, output is reflected in software */
+	if (spec->RefIn) {
+		cr |= CRC_CR_REV_IN_0;
+	}
+	
+	/* Continue from saved register value */
+	CRC->POL = spec->Poly & CRC_MASK(spec->Width);
+	CRC->INIT = Ctx->Value;
+	CRC->CR = cr | CRC_CR_RESET;
+	
+	/* Write bytes until address is aligned */
+	while (Length && ((uint32_t)Data & 0x03)) {
+		*((__IO uint8_t *)&CRC->DR) = *Data++;
+		Length--;
+	}
+	
+	/* Write words, first byte must be processed first */
+	for (; Length >= 4; Length -= 4, Data += 4) {
+		CRC->DR = __REV(*(const uint32_t *)Data);
+	}
+	
+	/* Write remaining bytes */
+	while (Length--) {
+		*((__IO uint8_t *)&CRC->DR) = *Data++;
+	}
+	
+	/* Save register */
+	Ctx->Value = CRC->DR & CRC_MASK(spec->Width);
+	
+	/* Set default configuration for other functions */
+	CRC->CR = 0;
+	CRC->POL = 0x04C11DB7;
+	CRC->INIT = 0xFFFFFFFF;
+}
+#endif
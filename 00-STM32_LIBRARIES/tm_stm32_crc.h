@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_CRC_H
-#define TM_CRC_H 100
+#define TM_CRC_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -54,11 +54,83 @@ extern "C" {
  *
  * Library uses hardware CRC unit in STM32Fxxx device
  *
+ * \par DMA calculation
+ *
+ * On STM32F4xx and STM32F7xx devices, large buffers can be fed to CRC unit with DMA2 stream in memory-to-memory mode.
+ * CPU is free while DMA writes words to CRC data register and callback is called from DMA interrupt with result.
+ *
+ * Buffers which are shorter than <code>CRC_DMA_THRESHOLD</code> bytes or not aligned to 4 bytes are calculated by CPU immediately.
+ * Remaining 1 to 3 bytes at the end of buffer are written by CPU before callback is called.
+ *
+ * CRC unit must not be used by other functions while DMA calculation is in progress.
+ *
+@code
+//DMA2 stream and channel for CRC, set in defines.h
+#define CRC_DMA_STREAM          DMA2_Stream5
+#define CRC_DMA_CHANNEL         DMA_CHANNEL_0
+
+//Called from DMA interrupt
+void CRC_Done(uint32_t Value, uint8_t Error, void* UserParameters) {
+	if (!Error) {
+		//Use CRC value
+	}
+}
+
+//Start calculation of 64kB firmware image
+TM_CRC_CalculateDMA((uint8_t *)0x08020000, 0x10000, 1, CRC_Done, NULL);
+@endcode
+ *
+ * \par CRC with custom parameters
+ *
+ * Functions with <code>Spec</code> in name calculate any CRC described with @ref TM_CRC_Spec_t structure
+ * (width, polynomial, initial value, input and output reflection and final XOR value).
+ * Specifications for common protocols are already available:
+ *
+\verbatim
+ - TM_CRC_Spec_CRC8_Maxim:    1-Wire devices, DS18B20 ROM and scratchpad
+ - TM_CRC_Spec_CRC16_Modbus:  Modbus RTU frames
+ - TM_CRC_Spec_CRC16_CCITT:   CRC-16/CCITT-FALSE, nRF24L01+ and XMODEM-like frames
+ - TM_CRC_Spec_CRC32_ISO_HDLC: Ethernet, ZIP, PNG
+\endverbatim
+ *
+ * On devices with programmable polynomial in CRC unit (STM32F0x2/F0x1/F09x and STM32F7xx), hardware is used for 7, 8, 16 and 32-bit CRCs.
+ * On other devices and widths, software implementation with slicing-by-8 tables is used.
+ * Tables need 8kB of RAM per context and are optional, without them CRC is calculated bit by bit.
+ * Software and hardware give the same results.
+ *
+ * After each hardware calculation, CRC unit is set back to default configuration for other functions in library.
+ * While @ref TM_CRC_CalculateDMA is in progress, CRC unit is not touched and CRC is calculated in software, bit by bit.
+ *
+@code
+TM_CRC_Ctx_t Modbus;
+uint32_t Modbus_Table[TM_CRC_TABLE_SIZE];
+
+//Init context, table is not used on devices with programmable CRC unit
+TM_CRC_SpecInit(&Modbus, &TM_CRC_Spec_CRC16_Modbus, Modbus_Table);
+
+//Calculate CRC of frame
+crc = TM_CRC_SpecCalculate(&Modbus, frame, frame_length);
+@endcode
+ *
+ * Each specification has check value, CRC of ASCII string <code>"123456789"</code>, as in CRC catalogues.
+ * @ref TM_CRC_SpecCheck compares it with calculated value, so custom parameters and hardware/software paths can be verified on target.
+ * Same check is done on host computer with <code>tools/tm_crc_check.c</code> program.
+ *
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added asynchronous CRC calculation with DMA on STM32F4xx and STM32F7xx
+
+ Version 1.2
+  - October 19, 2026
+  - Added CRC calculation with custom parameters and predefined specifications
+  - Added check values to specifications and TM_CRC_SpecCheck function
+  - Custom CRC uses software while DMA calculation is in progress
 \endverbatim
  *
  * \par Dependencies
@@ -66,10 +138,114 @@ extern "C" {
 \verbatim
  - STM32Fxxx HAL
  - defines.h
+ - TM DMA, on STM32F4xx and STM32F7xx
 \endverbatim
  */
 #include "stm32fxxx_hal.h"
 #include "defines.h"
+#if defined(STM32F4xx) || defined(STM32F7xx)
+#include "tm_stm32_dma.h"
+#endif
+
+/**
+ * @defgroup TM_CRC_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+#if defined(STM32F4xx) || defined(STM32F7xx) || defined(__DOXYGEN__)
+/**
+ * @brief  DMA2 stream and channel used for CRC calculation
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CRC_DMA_STREAM
+#define CRC_DMA_STREAM          DMA2_Stream5
+#endif
+#ifndef CRC_DMA_CHANNEL
+#define CRC_DMA_CHANNEL         DMA_CHANNEL_0
+#endif
+
+/**
+ * @brief  Buffers shorter than this number of bytes are calculated by CPU in @ref TM_CRC_CalculateDMA
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef CRC_DMA_THRESHOLD
+#define CRC_DMA_THRESHOLD       256
+#endif
+#endif
+
+/**
+ * @brief  Number of 32-bit entries in slicing-by-8 table for @ref TM_CRC_SpecInit
+ */
+#define TM_CRC_TABLE_SIZE       (8 * 256)
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_CRC_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Results for @ref TM_CRC_CalculateDMA function
+ */
+typedef enum {
+	TM_CRC_Result_DMA = 0x00, /*!< DMA calculation has started, callback is called from DMA interrupt */
+	TM_CRC_Result_CPU,        /*!< CRC was calculated by CPU and callback was already called */
+	TM_CRC_Result_Busy        /*!< DMA calculation is already in progress */
+} TM_CRC_Result_t;
+
+/**
+ * @brief  CRC calculation finished callback
+ * @param  Value: Calculated CRC value
+ * @param  Error: Set to 1 when DMA transfer error happened and value is not valid
+ * @param  *UserParameters: Pointer to user parameters
+ */
+typedef void (*TM_CRC_Callback_t)(uint32_t Value, uint8_t Error, void* UserParameters);
+
+/**
+ * @brief  CRC parameters
+ */
+typedef struct {
+	uint8_t Width;    /*!< CRC width in units of bits, from 1 to 32 */
+	uint8_t RefIn;    /*!< Set to 1 if input bytes are reflected, LSB first */
+	uint8_t RefOut;   /*!< Set to 1 if result is reflected before final XOR */
+	uint32_t Poly;    /*!< Polynomial, without highest bit */
+	uint32_t Init;    /*!< Initial value */
+	uint32_t XorOut;  /*!< Value XOR-ed with final result */
+	uint32_t Check;   /*!< CRC of ASCII string "123456789", used by @ref TM_CRC_SpecCheck */
+} TM_CRC_Spec_t;
+
+/**
+ * @brief  CRC calculation context
+ */
+typedef struct {
+	const TM_CRC_Spec_t* Spec;  /*!< Pointer to CRC parameters */
+	uint32_t* Table;            /*!< Pointer to slicing-by-8 table or NULL */
+	uint32_t Value;             /*!< Current CRC register value. Meant for private use */
+} TM_CRC_Ctx_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_CRC_Variables
+ * @brief    Library variables
+ * @{
+ */
+
+extern const TM_CRC_Spec_t TM_CRC_Spec_CRC8_Maxim;     /*!< CRC-8/MAXIM-DOW, check value 0xA1 */
+extern const TM_CRC_Spec_t TM_CRC_Spec_CRC16_Modbus;   /*!< CRC-16/MODBUS, check value 0x4B37 */
+extern const TM_CRC_Spec_t TM_CRC_Spec_CRC16_CCITT;    /*!< CRC-16/IBM-3740 (CCITT-FALSE), check value 0x29B1 */
+extern const TM_CRC_Spec_t TM_CRC_Spec_CRC32_ISO_HDLC; /*!< CRC-32/ISO-HDLC, check value 0xCBF43926 */
+
+/**
+ * @}
+ */
 
 /**
  * @defgroup TM_CRC_Functions
@@ -124,6 +300,80 @@ uint32_t TM_CRC_Calculate16(uint16_t* arr, uint32_t count, uint8_t reset);
  */
 uint32_t TM_CRC_Calculate32(uint32_t* arr, uint32_t count, uint8_t reset);
 
+#if defined(STM32F4xx) || defined(STM32F7xx) || defined(__DOXYGEN__)
+/**
+ * @brief  Starts CRC calculation of 8-bit input array with DMA
+ * @note   Result is the same as with @ref TM_CRC_Calculate8 function
+ * @param  *arr: Pointer to 8-bit data array for CRC calculation. It must stay valid until callback is called
+ * @param  count: Number of elements in array for calculation
+ * @param  reset: Reset CRC peripheral to 0 state before starting new calculations
+ * @param  Callback: Function called when calculation is finished
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Member of @ref TM_CRC_Result_t enumeration
+ */
+TM_CRC_Result_t TM_CRC_CalculateDMA(const uint8_t* arr, uint32_t count, uint8_t reset, TM_CRC_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Checks if DMA calculation is in progress
+ * @param  None
+ * @retval 1 if DMA calculation is in progress, 0 otherwise
+ */
+uint8_t TM_CRC_DMABusy(void);
+#endif
+
+/**
+ * @brief  Initializes CRC context with parameters and starts new calculation
+ * @param  *Ctx: Pointer to empty @ref TM_CRC_Ctx_t context
+ * @param  *Spec: Pointer to @ref TM_CRC_Spec_t parameters, it must stay valid while context is used
+ * @param  *Table: Pointer to @ref TM_CRC_TABLE_SIZE entries for software calculation or NULL for calculation bit by bit.
+ *            It is not used when hardware can calculate CRC
+ * @retval None
+ */
+void TM_CRC_SpecInit(TM_CRC_Ctx_t* Ctx, const TM_CRC_Spec_t* Spec, uint32_t* Table);
+
+/**
+ * @brief  Starts new calculation with initial value
+ * @param  *Ctx: Pointer to @ref TM_CRC_Ctx_t context
+ * @retval None
+ */
+void TM_CRC_SpecStart(TM_CRC_Ctx_t* Ctx);
+
+/**
+ * @brief  Adds data to calculation
+ * @param  *Ctx: Pointer to @ref TM_CRC_Ctx_t context
+ * @param  *Data: Pointer to data
+ * @param  Length: Number of bytes
+ * @retval None
+ */
+void TM_CRC_SpecUpdate(TM_CRC_Ctx_t* Ctx, const void* Data, uint32_t Length);
+
+/**
+ * @brief  Gets final CRC value
+ * @note   Calculation can continue with @ref TM_CRC_SpecUpdate after this call
+ * @param  *Ctx: Pointer to @ref TM_CRC_Ctx_t context
+ * @retval CRC value
+ */
+uint32_t TM_CRC_SpecFinish(TM_CRC_Ctx_t* Ctx);
+
+/**
+ * @brief  Calculates CRC of data in one call
+ * @param  *Ctx: Pointer to @ref TM_CRC_Ctx_t context
+ * @param  *Data: Pointer to data
+ * @param  Length: Number of bytes
+ * @retval CRC value
+ */
+uint32_t TM_CRC_SpecCalculate(TM_CRC_Ctx_t* Ctx, const void* Data, uint32_t Length);
+
+/**
+ * @brief  Checks if CRC of ASCII string "123456789" matches check value of specification
+ * @note   Current calculation in context is lost, start new one with @ref TM_CRC_SpecStart
+ * @param  *Ctx: Pointer to initialized @ref TM_CRC_Ctx_t context
+ * @retval Check status:
+ *            - 0: Calculated value is not the same as Check value in @ref TM_CRC_Spec_t
+ *            - > 0: Calculation is correct
+ */
+uint8_t TM_CRC_SpecCheck(TM_CRC_Ctx_t* Ctx);
+
 /**
  * @}
  */
@@ -97,3 +97,58 @@ void TM_DAC_SetValue(TM_DAC_Channel_t DACx, uint16_t value) {
 	}
 	
 }
+
+#if defined(STM32F4xx) || defined(STM32F7xx)
+uint8_t TM_DAC_DoubleBufferStart(TM_DAC_Channel_t DACx, TM_DMA_DB_t* DB, uint16_t* Buffer0, uint16_t* Buffer1, uint16_t Length, uint32_t Trigger, TM_DMA_DB_Callback_t Callback, void* UserParameters) {
+	DMA_Stream_TypeDef* Stream;
+	
+	/* Get DMA stream */
+	Stream = DACx == TM_DAC_Channel_1 ? DAC1_DMA_STREAM : DAC2_DMA_STREAM;
+	
+	/* Check if stream is free */
+	if (Stream->CR & DMA_SxCR_EN) {
+		return 0;
+	}
+	
+	/* Init DAC channel and pin */
+	TM_DAC_Init(DACx);
+	
+	/* Set trigger */
+	DAC_ChannelConf.DAC_Trigger = Trigger;
+	DAC_ChannelConf.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
+	
+	/* Start DMA in double buffer mode */
+	if (DACx == TM_DAC_Channel_1) {
+		HAL_DAC_ConfigChannel(&DAC_Handle[(uint8_t)DACx], &DAC_ChannelConf, DAC_CHANNEL_1);
+		TM_DMA_DB_Init(DB, Stream, DAC1_DMA_CHANNEL, DMA_MEMORY_TO_PERIPH, (uint32_t) &DAC->DHR12R1, 2);
+	} else {
+		HAL_DAC_ConfigChannel(&DAC_Handle[(uint8_t)DACx], &DAC_ChannelConf, DAC_CHANNEL_2);
+		TM_DMA_DB_Init(DB, Stream, DAC2_DMA_CHANNEL, DMA_MEMORY_TO_PERIPH, (uint32_t) &DAC->DHR12R2, 2);
+	}
+	if (!TM_DMA_DB_Start(DB, Buffer0, Buffer1, Length, Callback, UserParameters)) {
+		return 0;
+	}
+	
+	/* Enable channel and DMA requests */
+	if (DACx == TM_DAC_Channel_1) {
+		DAC->CR |= DAC_CR_EN1 | DAC_CR_DMAEN1;
+	} else {
+		DAC->CR |= DAC_CR_EN2 | DAC_CR_DMAEN2;
+	}
+	
+	/* Output has started */
+	return 1;
+}
+
+void TM_DAC_DoubleBufferStop(TM_DAC_Channel_t DACx, TM_DMA_DB_t* DB) {
+	/* Disable DMA requests */
+	if (DACx == TM_DAC_Channel_1) {
+		DAC->CR &= ~DAC_CR_DMAEN1;
+	} else {
+		DAC->CR &= ~DAC_CR_DMAEN2;
+	}
+	
+	/* Stop DMA */
+	TM_DMA_DB_Stop(DB);
+}
+#endif
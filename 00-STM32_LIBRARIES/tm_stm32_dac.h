@@ -35,7 +35,7 @@
 @endverbatim
  */
 #ifndef TM_DAC_H
-#define TM_DAC_H 100
+#define TM_DAC_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -55,6 +55,18 @@ extern C {
  * This library provides 12-bit digital to analog output, values from 0 to 4095.
  *
  * It is designed without DMA signal generator, only data user pass to @ref TM_DAC_SetValue are set to output.
+ *
+ * On STM32F4xx and STM32F7xx devices, continuous output from 2 buffers with DMA in double buffer mode is also supported,
+ * check @ref TM_DAC_DoubleBufferStart. Output rate is set by trigger timer, which has to be configured by user.
+ *
+ * Default DMA streams and channels:
+ *
+@verbatim
+DAC channel | DMA  | DMA Stream   | DMA Channel
+
+DAC1        | DMA1 | DMA Stream 5 | DMA Channel 7
+DAC2        | DMA1 | DMA Stream 6 | DMA Channel 7
+@endverbatim
  *
  * @note For STM32F4xx and STM32F7xx optimization calls are used to make fast set of channel data.
  *	
@@ -72,6 +84,10 @@ DAC2           PA5          Pin for DAC channel 2
 @verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added continuous output with DMA in double buffer mode for STM32F4xx and STM32F7xx
 @endverbatim
  *
  * \par Dependencies
@@ -80,6 +96,7 @@ DAC2           PA5          Pin for DAC channel 2
  - STM32Fxxx HAL
  - defines.h
  - TM GPIO
+ - TM DMA (STM32F4xx and STM32F7xx only)
 @endverbatim
  */
 
@@ -89,12 +106,37 @@ DAC2           PA5          Pin for DAC channel 2
 #include "stm32fxxx_hal.h"
 #include "defines.h"
 #include "tm_stm32_gpio.h"
+#if defined(STM32F4xx) || defined(STM32F7xx)
+#include "tm_stm32_dma.h"
+#endif
 
 /* Check if peripheral supported */
 #if !defined(DAC)
 #error "Target device does not support Digital-To-Analog converter!"
 #endif
 
+/**
+ * @defgroup TM_DAC_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/* DAC channel 1 DMA default settings */
+#ifndef DAC1_DMA_STREAM
+#define DAC1_DMA_STREAM         DMA1_Stream5
+#define DAC1_DMA_CHANNEL        DMA_CHANNEL_7
+#endif
+
+/* DAC channel 2 DMA default settings */
+#ifndef DAC2_DMA_STREAM
+#define DAC2_DMA_STREAM         DMA1_Stream6
+#define DAC2_DMA_CHANNEL        DMA_CHANNEL_7
+#endif
+
+/**
+ * @}
+ */
+
 /**
  * @defgroup TM_DAC_Typedefs
  * @brief    Library Typedefs
@@ -134,6 +176,34 @@ void TM_DAC_Init(TM_DAC_Channel_t DACx);
  */
 void TM_DAC_SetValue(TM_DAC_Channel_t DACx, uint16_t value);
 
+#if defined(STM32F4xx) || defined(STM32F7xx) || defined(__DOXYGEN__)
+/**
+ * @brief  Starts continuous output of 12-bit right aligned samples from 2 buffers using DMA in double buffer mode
+ * @note   Callback is called from DMA interrupt each time one buffer is sent.
+ *            Buffer passed to callback must be filled with new samples before other buffer is sent
+ * @param  DACx: DAC Channel you will use. This parameter can be a value of @ref TM_DAC_Channel_t enumeration
+ * @param  *DB: Pointer to empty @ref TM_DMA_DB_t structure
+ * @param  *Buffer0: Pointer to first buffer
+ * @param  *Buffer1: Pointer to second buffer
+ * @param  Length: Number of samples in each buffer
+ * @param  Trigger: DAC trigger, DAC_TRIGGER_xxx. Timer for trigger must be configured by user
+ * @param  Callback: Buffer sent callback function. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Start status:
+ *            - 0: DMA stream is busy
+ *            - > 0: Output has started
+ */
+uint8_t TM_DAC_DoubleBufferStart(TM_DAC_Channel_t DACx, TM_DMA_DB_t* DB, uint16_t* Buffer0, uint16_t* Buffer1, uint16_t Length, uint32_t Trigger, TM_DMA_DB_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Stops continuous output started with @ref TM_DAC_DoubleBufferStart
+ * @param  DACx: DAC Channel you will use. This parameter can be a value of @ref TM_DAC_Channel_t enumeration
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure used on start
+ * @retval None
+ */
+void TM_DAC_DoubleBufferStop(TM_DAC_Channel_t DACx, TM_DMA_DB_t* DB);
+#endif
+
 /**
  * @}
  */
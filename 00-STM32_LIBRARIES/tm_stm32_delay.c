@@ -38,20 +38,50 @@ typedef struct {
 /* Custom timers structure */
 static TM_DELAY_Timers_t CustomTimers = {0};
 
+/* Running timers sorted by expiration tick */
+static TM_DELAY_Timer_t* ActiveTimers = NULL;
+
+/* Tick counter for timers, not affected by TM_DELAY_SetTime */
+static __IO uint32_t TimerTicks = 0;
+
+/* Deferred callbacks queue, written only from Systick and read only from TM_DELAY_ProcessDeferred */
+/* One slot is always empty to detect full queue */
+#define DELAY_DEFERRED_SLOTS      (DELAY_DEFERRED_QUEUE_SIZE + 1)
+static TM_DELAY_Timer_t* __IO DeferredQueue[DELAY_DEFERRED_SLOTS];
+static __IO uint16_t DeferredIn = 0;
+static __IO uint16_t DeferredOut = 0;
+
+#if defined(RTC_CR_WUTE)
+/* RTC interrupt used for wakeup from tickless STOP mode */
+#if defined(STM32F0xx)
+#define DELAY_TICKLESS_IRQ        RTC_IRQn
+#else
+#define DELAY_TICKLESS_IRQ        RTC_WKUP_IRQn
+#endif
+
+/* Remaining part of millisecond from previous tickless sleeps, in units of 1 / (PREDIV_S + 1) ms */
+static uint32_t TicklessFraction = 0;
+
+static uint32_t TM_DELAY_INT_TicklessRTCTime(void);
+static void TM_DELAY_INT_TicklessWakeupTimer(uint32_t Ticks);
+#endif
+
+/* Private functions */
+static void TM_DELAY_INT_TimerInsert(TM_DELAY_Timer_t* Timer);
+static void TM_DELAY_INT_TimerDefer(TM_DELAY_Timer_t* Timer);
+static void TM_DELAY_INT_TimerRemove(TM_DELAY_Timer_t* Timer);
+
 uint32_t TM_DELAY_Init(void) {
 #if !defined(STM32F0xx)
 	uint32_t c;
 	
-    /* Enable TRC */
-    CoreDebug->DEMCR &= ~0x01000000;
-    CoreDebug->DEMCR |=  0x01000000;
-	
-    /* Enable counter */
-    DWT->CTRL &= ~0x00000001;
-    DWT->CTRL |=  0x00000001;
+	/* Enable TRC */
+	CoreDebug->DEMCR |= 0x01000000;
 	
-    /* Reset counter */
-    DWT->CYCCNT = 0;
+	/* Enable counter if not already, counter is not reset because other libraries use its value */
+	if (!(DWT->CTRL & 0x00000001)) {
+		DWT->CTRL |= 0x00000001;
+	}
 	
 	/* Check if DWT has started */
 	c = DWT->CYCCNT;
@@ -88,19 +118,31 @@ TM_DELAY_Timer_t* TM_DELAY_TimerCreate(uint32_t ReloadValue, uint8_t AutoReloadC
 	tmp->ARR = ReloadValue;
 	tmp->CNT = tmp->ARR;
 	tmp->Flags.F.AREN = AutoReloadCmd;
-	tmp->Flags.F.CNTEN = StartTimer;
+	tmp->Flags.F.CNTEN = 0;
+	tmp->Flags.F.LINK = 0;
+	tmp->Deferred = 0;
+	tmp->Pending = 0;
+	tmp->Next = NULL;
+	tmp->Overruns = 0;
+	tmp->Dropped = 0;
 	tmp->Callback = TM_DELAY_CustomTimerCallback;
 	tmp->UserParameters = UserParameters;
 	
 	/* Increase number of timers in memory */
 	CustomTimers.Timers[CustomTimers.Count++] = tmp;
 	
+	/* Start timer if needed */
+	if (StartTimer) {
+		TM_DELAY_TimerStart(tmp);
+	}
+	
 	/* Return pointer to user */
 	return tmp;
 }
 
 void TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
 	uint8_t i;
+	uint16_t j;
 	uint32_t irq;
 	TM_DELAY_Timer_t* tmp;
 	
@@ -125,6 +167,16 @@ void TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
 	/* Disable interrupts */
 	__disable_irq();
 	
+	/* Remove from running timers */
+	TM_DELAY_INT_TimerRemove(tmp);
+	
+	/* Remove from deferred queue */
+	for (j = 0; j < DELAY_DEFERRED_SLOTS; j++) {
+		if (DeferredQueue[j] == tmp) {
+			DeferredQueue[j] = NULL;
+		}
+	}
+	
 	/* Shift array up */
 	for (; i < (CustomTimers.Count - 1); i++) {
 		/* Shift data to the left */
@@ -144,25 +196,75 @@ void TM_DELAY_TimerDelete(TM_DELAY_Timer_t* Timer) {
 }
 
 TM_DELAY_Timer_t* TM_DELAY_TimerStop(TM_DELAY_Timer_t* Timer) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Save remaining time and remove from running timers */
+	if (Timer->Flags.F.CNTEN) {
+		Timer->CNT = TM_DELAY_TimerGetRemaining(Timer);
+		TM_DELAY_INT_TimerRemove(Timer);
+	}
+	
 	/* Disable timer */
 	Timer->Flags.F.CNTEN = 0;
 	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
 	/* Return pointer */
 	return Timer;
 }
 
 TM_DELAY_Timer_t* TM_DELAY_TimerStart(TM_DELAY_Timer_t* Timer) {
-	/* Enable timer */
-	Timer->Flags.F.CNTEN = 1;
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Continue counting from current counter value */
+	if (!Timer->Flags.F.CNTEN) {
+		Timer->Flags.F.CNTEN = 1;
+		Timer->Expire = TimerTicks + (Timer->CNT ? Timer->CNT : 1);
+		TM_DELAY_INT_TimerInsert(Timer);
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
 	
 	/* Return pointer */
 	return Timer;
 }
 
 TM_DELAY_Timer_t* TM_DELAY_TimerReset(TM_DELAY_Timer_t* Timer) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
 	/* Reset timer */
 	Timer->CNT = Timer->ARR;
 	
+	/* Move running timer to new position */
+	if (Timer->Flags.F.CNTEN) {
+		TM_DELAY_INT_TimerRemove(Timer);
+		Timer->Expire = TimerTicks + (Timer->CNT ? Timer->CNT : 1);
+		TM_DELAY_INT_TimerInsert(Timer);
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
 	/* Return pointer */
 	return Timer;
 }
@@ -183,6 +285,195 @@ TM_DELAY_Timer_t* TM_DELAY_TimerAutoReloadValue(TM_DELAY_Timer_t* Timer, uint32_
 	return Timer;
 }
 
+uint32_t TM_DELAY_TimerGetRemaining(TM_DELAY_Timer_t* Timer) {
+	int32_t remaining;
+	
+	/* Stopped timer continues from counter value */
+	if (!Timer->Flags.F.CNTEN) {
+		return Timer->CNT;
+	}
+	
+	/* Calculate difference to expiration tick */
+	remaining = (int32_t)(Timer->Expire - TimerTicks);
+	
+	/* Return remaining time */
+	return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+TM_DELAY_Timer_t* TM_DELAY_TimerDeferred(TM_DELAY_Timer_t* Timer, uint8_t Deferred) {
+	/* Set deferred command */
+	Timer->Deferred = Deferred ? 1 : 0;
+	
+	/* Return pointer */
+	return Timer;
+}
+
+uint32_t TM_DELAY_ProcessDeferred(void) {
+	TM_DELAY_Timer_t* tmp;
+	uint32_t count = 0;
+	
+	/* Process all queued timers */
+	while (DeferredOut != DeferredIn) {
+		/* Get timer, it can be NULL if timer was deleted meanwhile */
+		tmp = DeferredQueue[DeferredOut];
+		DeferredQueue[DeferredOut] = NULL;
+		if (tmp) {
+			/* Clear pending flag first, so new expiration in callback is queued again */
+			tmp->Pending = 0;
+		}
+		
+		/* Free slot for Systick */
+		__DMB();
+		DeferredOut = (DeferredOut + 1) % DELAY_DEFERRED_SLOTS;
+		
+		/* Call user callback function */
+		if (tmp) {
+			tmp->Callback(tmp, tmp->UserParameters);
+			count++;
+		}
+	}
+	
+	/* Return number of callbacks */
+	return count;
+}
+
+#if defined(RTC_CR_WUTE)
+uint32_t TM_DELAY_TicklessSleep(void) {
+	uint32_t irq, idle, start, elapsed, ms, prediv, cr, cfgr, irqen;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Get time to first timer expiration */
+	idle = DELAY_TICKLESS_MAX_IDLE;
+	if (ActiveTimers != NULL) {
+		elapsed = TM_DELAY_TimerGetRemaining(ActiveTimers);
+		if (elapsed < idle) {
+			idle = elapsed;
+		}
+	}
+	
+	/* Check if STOP mode can be used, Systick keeps running when it can not */
+	if (
+		idle < DELAY_TICKLESS_MIN_IDLE ||                 /* Timer expires soon */
+		TM_Time2 ||                                       /* Timeout is counting */
+		DeferredIn != DeferredOut ||                      /* Deferred callbacks are waiting */
+		(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ||           /* Systick interrupt is pending */
+		!(RCC->BDCR & RCC_BDCR_RTCEN)                     /* RTC is not running */
+	) {
+		/* Wait for interrupt */
+		__WFI();
+		
+		/* Enable IRQ if necessary */
+		if (!irq) {
+			__enable_irq();
+		}
+		return 0;
+	}
+	
+	/* Stop Systick, only for STOP mode, tick which expires meanwhile stays pending and wakes up core immediately */
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	
+	/* Add already elapsed part of current millisecond */
+	prediv = (RTC->PRER & RTC_PRER_PREDIV_S) + 1;
+	TicklessFraction += (uint32_t)(((uint64_t)(SysTick->LOAD - SysTick->VAL) * prediv) / (SysTick->LOAD + 1));
+	
+	/* Save clock configuration and RTC interrupt status */
+	cr = RCC->CR;
+	cfgr = RCC->CFGR;
+	irqen = NVIC->ISER[(uint32_t)DELAY_TICKLESS_IRQ >> 5] & (1UL << ((uint32_t)DELAY_TICKLESS_IRQ & 0x1F));
+	
+	/* Enable power interface and access to RTC */
+	__HAL_RCC_PWR_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+	
+	/* Program wakeup timer, RTCCLK / 16 clock */
+	TM_DELAY_INT_TicklessWakeupTimer((uint32_t)(((uint64_t)idle * (DELAY_TICKLESS_RTC_CLOCK / 16)) / 1000));
+	
+	/* Wakeup interrupt is only pending, PRIMASK prevents handler execution */
+	__HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+	__HAL_RTC_WAKEUPTIMER_EXTI_ENABLE_IT();
+	__HAL_RTC_WAKEUPTIMER_EXTI_ENABLE_RISING_EDGE();
+	NVIC_ClearPendingIRQ(DELAY_TICKLESS_IRQ);
+	NVIC_EnableIRQ(DELAY_TICKLESS_IRQ);
+	
+	/* Get start time */
+	start = TM_DELAY_INT_TicklessRTCTime();
+	
+	/* Go to STOP mode, wakeup on any enabled interrupt */
+	HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+	
+	/* Restore clocks */
+	TM_DELAY_TicklessRestoreClocks(cr, cfgr);
+	
+	/* Stop wakeup timer and clear all flags */
+	TM_DELAY_INT_TicklessWakeupTimer(0);
+	__HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+	if (!irqen) {
+		NVIC_DisableIRQ(DELAY_TICKLESS_IRQ);
+	}
+	NVIC_ClearPendingIRQ(DELAY_TICKLESS_IRQ);
+	
+	/* Get elapsed time, check for midnight */
+	elapsed = TM_DELAY_INT_TicklessRTCTime();
+	if (elapsed < start) {
+		elapsed += 86400UL * prediv;
+	}
+	elapsed -= start;
+	
+	/* Calculate milliseconds, keep remainder for next sleep */
+	TicklessFraction += elapsed * 1000;
+	ms = TicklessFraction / prediv;
+	TicklessFraction %= prediv;
+	
+	/* Correct time, expired timers are processed on first Systick interrupt */
+	TM_Time += ms;
+	TimerTicks += ms;
+	
+	/* Start Systick with full period */
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Return sleeping time */
+	return ms;
+}
+
+__weak void TM_DELAY_TicklessRestoreClocks(uint32_t RCC_CR, uint32_t RCC_CFGR) {
+	/* Enable HSE oscillator */
+	if (RCC_CR & RCC_CR_HSEON) {
+		RCC->CR |= RCC_CR_HSEON;
+		while (!(RCC->CR & RCC_CR_HSERDY));
+	}
+	
+	/* Enable main PLL */
+	if (RCC_CR & RCC_CR_PLLON) {
+		RCC->CR |= RCC_CR_PLLON;
+		while (!(RCC->CR & RCC_CR_PLLRDY));
+	}
+	
+	/* Over-drive mode is disabled in STOP mode, enable it for high system clock */
+#if defined(PWR_CSR_ODRDY)
+	if ((RCC_CR & RCC_CR_PLLON) && SystemCoreClock > 168000000 && !(PWR->CSR & PWR_CSR_ODRDY)) {
+		HAL_PWREx_EnableOverDrive();
+	}
+#elif defined(PWR_CSR1_ODRDY)
+	if ((RCC_CR & RCC_CR_PLLON) && SystemCoreClock > 180000000 && !(PWR->CSR1 & PWR_CSR1_ODRDY)) {
+		HAL_PWREx_EnableOverDrive();
+	}
+#endif
+	
+	/* Select system clock source used before STOP mode */
+	MODIFY_REG(RCC->CFGR, RCC_CFGR_SW, RCC_CFGR & RCC_CFGR_SW);
+	while ((RCC->CFGR & RCC_CFGR_SWS) != ((RCC_CFGR & RCC_CFGR_SW) << 2));
+}
+#endif
+
 /* 1ms function called when systick makes interrupt */
 __weak void TM_DELAY_1msHandler(void) {
 	/* NOTE: This function Should not be modified, when the callback is needed,
@@ -196,43 +487,39 @@ __weak void TM_DELAY_1msHandler(void) {
 
 /* Called from Systick handler */
 void HAL_IncTick(void) {
-	uint8_t i;
+	TM_DELAY_Timer_t* tmp;
 	
 	/* Increase system time */
 	TM_Time++;
+	TimerTicks++;
 	
 	/* Decrease other system time */
 	if (TM_Time2) {
 		TM_Time2--;
 	}
 	
-	/* Check for timers */
-	/* Check custom timers */
-	for (i = 0; i < CustomTimers.Count; i++) {
-		/* Check if timer is enabled */
-		if (
-			CustomTimers.Timers[i] &&             /*!< Pointer exists */
-			CustomTimers.Timers[i]->Flags.F.CNTEN /*!< Timer is enabled */
-		) {
-			/* Decrease counter if needed */
-			if (CustomTimers.Timers[i]->CNT) {
-				CustomTimers.Timers[i]->CNT--;
-			}
-
-			/* Check if count is zero */
-			if (CustomTimers.Timers[i]->CNT == 0) {
-				/* Call user callback function */
-				CustomTimers.Timers[i]->Callback(CustomTimers.Timers[i], CustomTimers.Timers[i]->UserParameters);
-
-				/* Set new counter value */
-				CustomTimers.Timers[i]->CNT = CustomTimers.Timers[i]->ARR;
-
-				/* Disable timer if auto reload feature is not used */
-				if (!CustomTimers.Timers[i]->Flags.F.AREN) {
-					/* Disable counter */
-					CustomTimers.Timers[i]->Flags.F.CNTEN = 0;
-				}
-			}
+	/* Check custom timers, only first in list can expire */
+	while ((tmp = ActiveTimers) != NULL && (int32_t)(TimerTicks - tmp->Expire) >= 0) {
+		/* Remove from list */
+		ActiveTimers = tmp->Next;
+		tmp->Flags.F.LINK = 0;
+		
+		/* Set new counter value */
+		tmp->CNT = tmp->ARR;
+		
+		/* Put back to list or disable timer if auto reload feature is not used */
+		if (tmp->Flags.F.AREN) {
+			tmp->Expire += tmp->ARR ? tmp->ARR : 1;
+			TM_DELAY_INT_TimerInsert(tmp);
+		} else {
+			tmp->Flags.F.CNTEN = 0;
+		}
+		
+		/* Call user callback function or put it to queue */
+		if (tmp->Deferred) {
+			TM_DELAY_INT_TimerDefer(tmp);
+		} else {
+			tmp->Callback(tmp, tmp->UserParameters);
 		}
 	}
 	
@@ -269,3 +556,118 @@ uint32_t HAL_GetTick(void) {
 	/* Return current time in milliseconds */
 	return TM_Time;
 }
+
+/***************************************************/
+/*                Private functions                */
+/***************************************************/
+
+/* Must be called with interrupts disabled or from Systick */
+static void TM_DELAY_INT_TimerInsert(TM_DELAY_Timer_t* Timer) {
+	TM_DELAY_Timer_t** pos = &ActiveTimers;
+	
+	/* Find first timer which expires later, timers with equal tick stay in start order */
+	while (*pos && (int32_t)((*pos)->Expire - Timer->Expire) <= 0) {
+		pos = &(*pos)->Next;
+	}
+	
+	/* Link timer */
+	Timer->Next = *pos;
+	*pos = Timer;
+	Timer->Flags.F.LINK = 1;
+}
+
+/* Must be called with interrupts disabled or from Systick */
+static void TM_DELAY_INT_TimerRemove(TM_DELAY_Timer_t* Timer) {
+	TM_DELAY_Timer_t** pos = &ActiveTimers;
+	
+	/* Check if timer is in list */
+	if (!Timer->Flags.F.LINK) {
+		return;
+	}
+	
+	/* Find and unlink timer */
+	while (*pos) {
+		if (*pos == Timer) {
+			*pos = Timer->Next;
+			break;
+		}
+		pos = &(*pos)->Next;
+	}
+	Timer->Next = NULL;
+	Timer->Flags.F.LINK = 0;
+}
+
+/* Called from Systick only */
+static void TM_DELAY_INT_TimerDefer(TM_DELAY_Timer_t* Timer) {
+	uint16_t next = (DeferredIn + 1) % DELAY_DEFERRED_SLOTS;
+	
+	/* Previous callback did not run yet */
+	if (Timer->Pending) {
+		Timer->Overruns++;
+		return;
+	}
+	
+	/* Queue is full */
+	if (next == DeferredOut) {
+		Timer->Dropped++;
+		return;
+	}
+	
+	/* Put timer to queue */
+	Timer->Pending = 1;
+	DeferredQueue[DeferredIn] = Timer;
+	__DMB();
+	DeferredIn = next;
+	
+#if DELAY_DEFERRED_PENDSV
+	/* Set PendSV interrupt pending */
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+#endif
+}
+
+#if defined(RTC_CR_WUTE)
+/* Gets RTC time of day in units of subseconds */
+static uint32_t TM_DELAY_INT_TicklessRTCTime(void) {
+	uint32_t ssr, tr, prediv;
+	
+	/* Read subseconds first, time and date registers are locked until date is read */
+	ssr = RTC->SSR;
+	tr = RTC->TR;
+	(void)RTC->DR;
+	prediv = RTC->PRER & RTC_PRER_PREDIV_S;
+	
+	/* Convert BCD time to seconds and add subseconds, they count down */
+	return (
+		((((tr >> 20) & 0x03) * 10 + ((tr >> 16) & 0x0F)) * 3600 +
+		(((tr >> 12) & 0x07) * 10 + ((tr >> 8) & 0x0F)) * 60 +
+		(((tr >> 4) & 0x07) * 10 + (tr & 0x0F))) * (prediv + 1) +
+		(prediv - (ssr & RTC_SSR_SS))
+	);
+}
+
+/* Starts RTC wakeup timer or stops it when Ticks is zero */
+static void TM_DELAY_INT_TicklessWakeupTimer(uint32_t Ticks) {
+	/* Disable write protection */
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	
+	/* Disable wakeup timer and wait till it can be changed */
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+	RTC->ISR = ~(RTC_ISR_WUTF | RTC_ISR_INIT) | (RTC->ISR & RTC_ISR_INIT);
+	
+	if (Ticks) {
+		while (!(RTC->ISR & RTC_ISR_WUTWF));
+		
+		/* Set reload value and RTCCLK / 16 clock */
+		RTC->WUTR = (Ticks > 0x10000 ? 0x10000 : Ticks) - 1;
+		RTC->CR = (RTC->CR & ~RTC_CR_WUCKSEL) | RTC_CR_WUTE | RTC_CR_WUTIE;
+	} else {
+		/* Shadow registers are not updated in STOP mode, wait for synchronization */
+		RTC->ISR &= ~RTC_ISR_RSF | RTC_ISR_INIT;
+		while (!(RTC->ISR & RTC_ISR_RSF));
+	}
+	
+	/* Enable write protection */
+	RTC->WPR = 0xFF;
+}
+#endif
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_DELAY_H
-#define TM_DELAY_H 100
+#define TM_DELAY_H 130
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -73,12 +73,79 @@ extern "C" {
  * The main idea of software timers is that when timer reaches zero (timers are down-counters), callback function is called where
  * user can do its work which should be done periodically, or only once if needed. 
  * Check @ref TM_DELAY_Timer_Functions group with all functions which can be used for timers.
+ *
+ * Running timers are kept in list sorted by expiration tick. On each Systick interrupt only first timer in list is checked,
+ * so interrupt time does not depend on number of timers. Only timers which expire are touched.
+ * Timers use internal tick counter, so changing time with @ref TM_DELAY_SetTime does not affect them.
+ *
+ * \par Deferred timer callbacks
+ *
+ * By default, timer callback is called directly from Systick interrupt. Slow callback delays other interrupts and time base.
+ * With @ref TM_DELAY_TimerDeferred, timer expiration is only put to lock-free queue in interrupt
+ * and callback is called later from @ref TM_DELAY_ProcessDeferred function, called from main loop or PendSV handler.
+ *
+ * When timer expires again before its previous callback was called, expiration is not queued again
+ * and overrun counter of timer is increased instead. When queue is full, expiration is dropped
+ * and dropped counter of timer is increased.
+ *
+@code
+//Trigger PendSV interrupt when deferred timer expires, set in defines.h
+#define DELAY_DEFERRED_PENDSV     1
+
+//Queue size, number of deferred timers is enough
+#define DELAY_DEFERRED_QUEUE_SIZE 8
+
+//In stm32fxxx_it.c file
+void PendSV_Handler(void) {
+	TM_DELAY_ProcessDeferred();
+}
+@endcode
+ *
+ * \par Tickless low-power mode
+ *
+ * Systick wakes up the device every 1ms even if there is nothing to do.
+ * With @ref TM_DELAY_TicklessSleep, library calculates time to first software timer expiration,
+ * stops Systick, programs RTC wakeup timer and enters STOP mode.
+ *
+ * After wakeup (from RTC or any other enabled interrupt), elapsed time is read from RTC subseconds counter
+ * and added to @ref TM_Time and timers time base, so HAL_GetTick and @ref TM_DELAY_Time stay accurate.
+ * Clocks are restored with @ref TM_DELAY_TicklessRestoreClocks and Systick is started again.
+ *
+ * \note  RTC must be initialized (@ref TM_RTC_Init) before tickless mode is used and must run in 24-hour format.
+ *        RTC wakeup timer is used by library, so @ref TM_RTC_Interrupts can not be used at the same time.
+ * \note  @ref TM_DELAY_1msHandler is not called while device is in STOP mode.
+ *
+@code
+//Main loop
+while (1) {
+	//Do work
+	
+	//Sleep until next timer expires or interrupt happens
+	TM_DELAY_TicklessSleep();
+}
+@endcode
  *
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Software timers are kept in sorted deadline list, Systick does not scan all timers anymore
+  - Added TM_DELAY_TimerGetRemaining function
+
+ Version 1.2
+  - October 19, 2026
+  - Added deferred timer callbacks executed outside Systick interrupt with overrun counters
+
+ Version 1.3
+  - October 19, 2026
+  - Added tickless low-power mode with STOP mode and RTC wakeup timer
+  - Deferred flags are not in Flags bitfield anymore, which is modified from Systick interrupt
+  - Deferred queue holds DELAY_DEFERRED_QUEUE_SIZE entries, full queue is counted separately from overruns
+  - DWT counter is not reset in TM_DELAY_Init, TM CLOCK library uses its value
 \endverbatim
  *
  * \par Dependencies
@@ -107,6 +174,47 @@ extern "C" {
 #define DELAY_MAX_CUSTOM_TIMERS   5
 #endif
 
+/**
+ * @brief  Number of deferred timer callbacks queue can hold
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef DELAY_DEFERRED_QUEUE_SIZE
+#define DELAY_DEFERRED_QUEUE_SIZE DELAY_MAX_CUSTOM_TIMERS
+#endif
+
+/**
+ * @brief  Set to 1 to set PendSV interrupt pending when deferred callback is queued
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef DELAY_DEFERRED_PENDSV
+#define DELAY_DEFERRED_PENDSV     0
+#endif
+
+/**
+ * @brief  Minimal time in units of milliseconds to next timer expiration to enter STOP mode in tickless mode
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef DELAY_TICKLESS_MIN_IDLE
+#define DELAY_TICKLESS_MIN_IDLE   3
+#endif
+
+/**
+ * @brief  Maximal time in units of milliseconds device stays in STOP mode in tickless mode
+ * @note   Should be changes in defines.h file if necessary
+ * @note   RTC wakeup timer is clocked from RTCCLK / 16, so maximal value for 32768Hz clock is 31999 milliseconds
+ */
+#ifndef DELAY_TICKLESS_MAX_IDLE
+#define DELAY_TICKLESS_MAX_IDLE   30000
+#endif
+
+/**
+ * @brief  RTC clock frequency used to program wakeup timer in tickless mode
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef DELAY_TICKLESS_RTC_CLOCK
+#define DELAY_TICKLESS_RTC_CLOCK  32768
+#endif
+
 /* Memory allocation function */
 #ifndef LIB_ALLOC_FUNC
 #define LIB_ALLOC_FUNC    malloc
@@ -135,11 +243,20 @@ typedef struct _TM_DELAY_Timer_t {
 		struct {			
 			uint8_t AREN:1;  /*!< Auto-reload enabled */
 			uint8_t CNTEN:1; /*!< Count enabled */
+			uint8_t LINK:1;  /*!< Timer is in list of running timers. Meant for private use */
 		} F;
 		uint8_t FlagsVal;
 	} Flags;
+	__IO uint8_t Deferred;                               /*!< Callback is called from @ref TM_DELAY_ProcessDeferred instead of interrupt.
+	                                                          Not in Flags, because Flags are modified from Systick interrupt */
+	__IO uint8_t Pending;                                /*!< Deferred callback is waiting in queue. Meant for private use */
 	uint32_t ARR;                                        /*!< Auto reload value */
-	uint32_t CNT;                                        /*!< Counter value, counter counts down */
+	uint32_t CNT;                                        /*!< Counter value, counter counts down. It is updated when timer is stopped or expires, 
+	                                                          use @ref TM_DELAY_TimerGetRemaining for running timer */
+	uint32_t Expire;                                     /*!< Tick when timer expires. Meant for private use */
+	struct _TM_DELAY_Timer_t* Next;                      /*!< Next timer in list of running timers. Meant for private use */
+	uint32_t Overruns;                                   /*!< Number of expirations while deferred callback was still waiting */
+	uint32_t Dropped;                                    /*!< Number of expirations not queued because deferred queue was full */
 	void (*Callback)(struct _TM_DELAY_Timer_t*, void *); /*!< Callback which will be called when timer reaches zero */
 	void* UserParameters;                                /*!< Pointer to user parameters used for callback function */
 } TM_DELAY_Timer_t;
@@ -303,10 +420,74 @@ TM_DELAY_Timer_t* TM_DELAY_TimerAutoReloadCommand(TM_DELAY_Timer_t* Timer, uint8
  */
 TM_DELAY_Timer_t* TM_DELAY_TimerAutoReloadValue(TM_DELAY_Timer_t* Timer, uint32_t AutoReloadValue);
 
+/**
+ * @brief  Gets number of milliseconds until timer reaches zero
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
+ * @retval Remaining milliseconds. For stopped timer, value where counting will continue is returned
+ */
+uint32_t TM_DELAY_TimerGetRemaining(TM_DELAY_Timer_t* Timer);
+
+/**
+ * @brief  Sets if timer callback is called from interrupt or deferred to @ref TM_DELAY_ProcessDeferred
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
+ * @param  Deferred: Set to 1 to defer callback or 0 to call it from Systick interrupt
+ * @retval Pointer to @ref TM_DELAY_Timer_t structure
+ */
+TM_DELAY_Timer_t* TM_DELAY_TimerDeferred(TM_DELAY_Timer_t* Timer, uint8_t Deferred);
+
+/**
+ * @brief  Gets number of timer overruns
+ * @note   Overrun happens when timer expires again before its deferred callback was called
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
+ * @retval Number of overruns since timer was created
+ * @note   Defined as macro for faster execution
+ */
+#define TM_DELAY_TimerGetOverruns(Timer)  ((Timer)->Overruns)
+
+/**
+ * @brief  Gets number of timer expirations dropped because deferred queue was full
+ * @note   It can only happen when @ref DELAY_DEFERRED_QUEUE_SIZE is smaller than number of deferred timers
+ * @param  *Timer: Pointer to @ref TM_DELAY_Timer_t structure
+ * @retval Number of dropped expirations since timer was created
+ * @note   Defined as macro for faster execution
+ */
+#define TM_DELAY_TimerGetDropped(Timer)   ((Timer)->Dropped)
+
+/**
+ * @brief  Calls all queued deferred timer callbacks
+ * @note   Call it periodically from main loop or from PendSV_Handler when DELAY_DEFERRED_PENDSV is used.
+ *            It must not be called from more than one place
+ * @param  None
+ * @retval Number of called callbacks
+ */
+uint32_t TM_DELAY_ProcessDeferred(void);
+
 /**
  * @}
  */
 
+#if defined(RTC_CR_WUTE) || defined(__DOXYGEN__)
+/**
+ * @brief  Enters STOP mode until first software timer expires or any enabled interrupt happens
+ * @note   When timer expires in less than @ref DELAY_TICKLESS_MIN_IDLE milliseconds, @ref TM_Time2 is counting
+ *            or deferred callbacks are waiting, only __WFI() instruction is executed and Systick keeps running
+ * @param  None
+ * @retval Number of milliseconds spent in STOP mode, 0 if device did not enter STOP mode
+ */
+uint32_t TM_DELAY_TicklessSleep(void);
+
+/**
+ * @brief  Restores system clock after wakeup from STOP mode
+ * @note   Default implementation enables HSE, PLL and over-drive mode if used before and selects old system clock source.
+ *            When other clocks are needed, function can be implemented in user file
+ * @param  RCC_CR: Value of RCC->CR register before entering STOP mode
+ * @param  RCC_CFGR: Value of RCC->CFGR register before entering STOP mode
+ * @retval None
+ * @note   With __weak parameter to prevent link errors if not defined by user
+ */
+void TM_DELAY_TicklessRestoreClocks(uint32_t RCC_CR, uint32_t RCC_CFGR);
+#endif
+
 /**
  * @brief  User function, called each 1ms when interrupt from timer happen
  * @note   Here user should put things which has to be called periodically
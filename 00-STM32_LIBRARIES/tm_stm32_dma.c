@@ -24,11 +24,60 @@
  * |----------------------------------------------------------------------
  */
 #include "tm_stm32_dma.h"
+#include "string.h"
 
 /* Private defines for stream numbers */
 #define GET_STREAM_NUMBER_DMA1(stream)    (((uint32_t)(stream) - (uint32_t)DMA1_Stream0) / (0x18))
 #define GET_STREAM_NUMBER_DMA2(stream)    (((uint32_t)(stream) - (uint32_t)DMA2_Stream0) / (0x18))
 
+/* Stream index from 0 to 15, used for internal handlers */
+#define GET_STREAM_INDEX(stream)          ((stream) < DMA2_Stream0 ? GET_STREAM_NUMBER_DMA1(stream) : (8 + GET_STREAM_NUMBER_DMA2(stream)))
+
+/* Maximal number of data items per memory-to-memory transfer, multiple of biggest burst */
+#define DMA_MEM_MAX_ITEMS                 0xFFF0
+
+/* Double buffer length in bytes from stream configuration */
+#define DMA_DB_BYTES(DB)                  ((uint32_t)(DB)->Length << (((DB)->CR & DMA_SxCR_MSIZE) >> DMA_SxCR_MSIZE_Pos))
+
+/* Internal stream handler, returns 1 when interrupt was handled and user callbacks should not be called */
+typedef struct {
+	TM_DMA_Handler_t Handler;
+	void* Param;
+} TM_DMA_INT_Handler_t;
+
+/* Memory-to-memory request */
+typedef struct {
+	uint32_t Source;                /*!< Source address, not used on fill */
+	uint32_t Destination;           /*!< Destination address */
+	uint32_t Length;                /*!< Remaining number of bytes */
+	uint32_t Pattern;               /*!< Fill pattern, used as fixed source address on fill */
+	uint8_t Fill;                   /*!< Set to 1 when request is memset */
+	TM_DMA_MEM_Callback_t Callback; /*!< Request finished callback */
+	void* UserParameters;           /*!< User parameters for callback */
+} TM_DMA_MEM_INT_Request_t;
+
+/* Memory-to-memory engine structure */
+typedef struct {
+	TM_DMA_MEM_INT_Request_t Queue[DMA_MEM_QUEUE_SIZE]; /*!< Circular queue of requests */
+	uint8_t In;                                         /*!< Write index */
+	uint8_t Out;                                        /*!< Read index, request being processed */
+	__IO uint8_t Count;                                 /*!< Number of requests in queue */
+	uint32_t Chunk;                                     /*!< Number of bytes in active DMA transfer */
+} TM_DMA_MEM_INT_t;
+
+/* Private variables */
+static TM_DMA_INT_Handler_t DMA_INT_Handlers[16];
+static TM_DMA_MEM_INT_t DMA_MEM;
+
+/* Private functions */
+static void TM_DMA_MEM_INT_Start(void);
+static uint8_t TM_DMA_MEM_INT_CPU(void* Destination, const void* Source, uint8_t Value, uint32_t Length);
+static uint8_t TM_DMA_MEM_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param);
+static void TM_DMA_SG_INT_Load(TM_DMA_SG_t* SG);
+static uint8_t TM_DMA_SG_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param);
+static uint8_t TM_DMA_DB_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param);
+static TM_DMA_MEM_Result_t TM_DMA_MEM_INT_Add(uint32_t Destination, uint32_t Source, uint32_t Pattern, uint8_t Fill, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters);
+
 /* Offsets for bits */
 const static uint8_t DMA_Flags_Bit_Pos[4] = {
 	0, 6, 16, 22
@@ -107,6 +156,13 @@ uint32_t TM_DMA_GetFlags(DMA_Stream_TypeDef* DMA_Stream, uint32_t flag) {
 	return flags;
 }
 
+void TM_DMA_SetHandler(DMA_Stream_TypeDef* DMA_Stream, TM_DMA_Handler_t Handler, void* Param) {
+	/* Set handler for stream */
+	DMA_INT_Handlers[GET_STREAM_INDEX(DMA_Stream)].Handler = NULL;
+	DMA_INT_Handlers[GET_STREAM_INDEX(DMA_Stream)].Param = Param;
+	DMA_INT_Handlers[GET_STREAM_INDEX(DMA_Stream)].Handler = Handler;
+}
+
 void TM_DMA_EnableInterrupts(DMA_Stream_TypeDef* DMA_Stream) {
 	uint32_t stream_number;
 	IRQn_Type type;
@@ -198,6 +254,291 @@ void TM_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t Source, uint32_t Destination
 	HAL_DMA_Start(hdma, Source, Destination, Length);
 }
 
+void TM_DMA_CleanDCache(const void* Address, uint32_t Length) {
+#if defined(STM32F7xx)
+	uint32_t addr = (uint32_t)Address;
+	
+	/* Write dirty lines covering block to memory */
+	if ((SCB->CCR & SCB_CCR_DC_Msk) && Length) {
+		SCB_CleanDCache_by_Addr((uint32_t *)(addr & ~0x1FUL), Length + (addr & 0x1F));
+	}
+#endif
+}
+
+void TM_DMA_InvalidateDCache(void* Address, uint32_t Length) {
+#if defined(STM32F7xx)
+	uint32_t addr = (uint32_t)Address;
+	
+	/* Drop lines covering block, next CPU read gets data written by DMA */
+	if ((SCB->CCR & SCB_CCR_DC_Msk) && Length) {
+		SCB_InvalidateDCache_by_Addr((uint32_t *)(addr & ~0x1FUL), Length + (addr & 0x1F));
+	}
+#endif
+}
+
+void TM_DMA_MEM_Init(void) {
+	/* Stop stream if working */
+	DMA_MEM_STREAM->CR &= ~DMA_SxCR_EN;
+	
+	/* Reset queue */
+	memset(&DMA_MEM, 0, sizeof(DMA_MEM));
+	
+	/* Enable DMA clock */
+	TM_DMA_Init(DMA_MEM_STREAM, NULL);
+	
+	/* Set internal handler for stream */
+	DMA_INT_Handlers[GET_STREAM_INDEX(DMA_MEM_STREAM)].Handler = TM_DMA_MEM_INT_Process;
+	DMA_INT_Handlers[GET_STREAM_INDEX(DMA_MEM_STREAM)].Param = NULL;
+	
+	/* Enable NVIC, stream interrupts are set on each transfer start */
+	TM_DMA_EnableInterrupts(DMA_MEM_STREAM);
+}
+
+TM_DMA_MEM_Result_t TM_DMA_MEM_Copy(void* Destination, const void* Source, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters) {
+	/* Check parameters */
+	if (Destination == NULL || Source == NULL || Length == 0) {
+		return TM_DMA_MEM_Result_Error;
+	}
+	
+	/* Small copy is faster on CPU, but only when nothing is in queue to keep order */
+	if (Length < DMA_MEM_CPU_THRESHOLD && TM_DMA_MEM_INT_CPU(Destination, Source, 0, Length)) {
+		/* Call user callback */
+		if (Callback) {
+			Callback(TM_DMA_MEM_Result_CPU, UserParameters);
+		}
+		return TM_DMA_MEM_Result_CPU;
+	}
+	
+	/* Add request to queue */
+	return TM_DMA_MEM_INT_Add((uint32_t)Destination, (uint32_t)Source, 0, 0, Length, Callback, UserParameters);
+}
+
+TM_DMA_MEM_Result_t TM_DMA_MEM_Set(void* Destination, uint8_t Value, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters) {
+	/* Check parameters */
+	if (Destination == NULL || Length == 0) {
+		return TM_DMA_MEM_Result_Error;
+	}
+	
+	/* Small fill is faster on CPU, but only when nothing is in queue to keep order */
+	if (Length < DMA_MEM_CPU_THRESHOLD && TM_DMA_MEM_INT_CPU(Destination, NULL, Value, Length)) {
+		/* Call user callback */
+		if (Callback) {
+			Callback(TM_DMA_MEM_Result_CPU, UserParameters);
+		}
+		return TM_DMA_MEM_Result_CPU;
+	}
+	
+	/* Add request to queue with pattern for all 4 bytes */
+	return TM_DMA_MEM_INT_Add((uint32_t)Destination, 0, (uint32_t)Value * 0x01010101UL, 1, Length, Callback, UserParameters);
+}
+
+uint8_t TM_DMA_MEM_Pending(void) {
+	/* Return number of requests */
+	return DMA_MEM.Count;
+}
+
+void TM_DMA_SG_Init(TM_DMA_SG_t* SG, DMA_Stream_TypeDef* Stream, uint32_t Channel, uint32_t Direction, uint32_t Address, uint8_t Size) {
+	uint32_t cr;
+	
+	/* Fill structure */
+	SG->Stream = Stream;
+	SG->Address = Address;
+	SG->Destination = Address;
+	SG->Size = Size;
+	SG->MemToMem = Direction == DMA_MEMORY_TO_MEMORY;
+	SG->PeriphToMem = Direction == DMA_PERIPH_TO_MEMORY;
+	SG->Current = NULL;
+	SG->Callback = NULL;
+	SG->UserParameters = NULL;
+	TM_DMA_SG_ResetGap(SG);
+	
+	/* Disable stream and wait for it */
+	Stream->CR &= ~DMA_SxCR_EN;
+	while (Stream->CR & DMA_SxCR_EN);
+	
+	/* Enable DMA clock */
+	TM_DMA_Init(Stream, NULL);
+	
+	/* Set internal handler for stream */
+	DMA_INT_Handlers[GET_STREAM_INDEX(Stream)].Param = SG;
+	DMA_INT_Handlers[GET_STREAM_INDEX(Stream)].Handler = TM_DMA_SG_INT_Process;
+	
+	/* Enable NVIC */
+	TM_DMA_EnableInterrupts(Stream);
+	
+	/* Set data size */
+	if (Size == 4) {
+		cr = DMA_PDATAALIGN_WORD | DMA_MDATAALIGN_WORD;
+	} else if (Size == 2) {
+		cr = DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD;
+	} else {
+		cr = DMA_PDATAALIGN_BYTE | DMA_MDATAALIGN_BYTE;
+	}
+	
+	/* Configuration stays the same for all descriptors, only addresses and length are changed */
+	cr |= Channel | Direction | DMA_MINC_ENABLE | DMA_PRIORITY_HIGH | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	if (SG->MemToMem) {
+		/* Source is on peripheral port, FIFO is mandatory */
+		cr |= DMA_PINC_ENABLE;
+		Stream->FCR = DMA_SxFCR_DMDIS | DMA_FIFO_THRESHOLD_FULL;
+	} else {
+		/* Direct mode */
+		Stream->FCR = 0;
+		Stream->PAR = Address;
+	}
+	Stream->CR = cr;
+}
+
+void TM_DMA_SG_DeInit(TM_DMA_SG_t* SG) {
+	/* Stop stream */
+	SG->Stream->CR &= ~DMA_SxCR_EN;
+	SG->Current = NULL;
+	
+	/* Remove internal handler, user callbacks are called again */
+	DMA_INT_Handlers[GET_STREAM_INDEX(SG->Stream)].Handler = NULL;
+	DMA_INT_Handlers[GET_STREAM_INDEX(SG->Stream)].Param = NULL;
+}
+
+uint8_t TM_DMA_SG_Start(TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters) {
+	/* Skip empty descriptors */
+	while (First && First->Length == 0) {
+		First = First->Next;
+	}
+	
+	/* Check if chain is busy or empty */
+	if (SG->Current || First == NULL || (SG->Stream->CR & DMA_SxCR_EN)) {
+		return 0;
+	}
+	
+	/* Save parameters */
+	SG->Callback = Callback;
+	SG->UserParameters = UserParameters;
+	SG->Destination = SG->Address;
+	SG->Current = First;
+	
+	/* Clear flags and start first descriptor */
+	TM_DMA_ClearFlag(SG->Stream, DMA_FLAG_ALL);
+	TM_DMA_SG_INT_Load(SG);
+	
+	/* Chain has started */
+	return 1;
+}
+
+void TM_DMA_SG_ResetGap(TM_DMA_SG_t* SG) {
+	/* Reset statistics */
+	SG->GapLast = 0;
+	SG->GapMax = 0;
+	SG->GapMin = 0xFFFFFFFF;
+	SG->Reloads = 0;
+}
+
+void TM_DMA_DB_Init(TM_DMA_DB_t* DB, DMA_Stream_TypeDef* Stream, uint32_t Channel, uint32_t Direction, uint32_t Peripheral, uint8_t Size) {
+	/* Fill structure */
+	DB->Stream = Stream;
+	DB->Peripheral = Peripheral;
+	DB->Buffer[0] = NULL;
+	DB->Buffer[1] = NULL;
+	DB->Length = 0;
+	DB->Running = 0;
+	DB->Swaps = 0;
+	DB->Callback = NULL;
+	DB->UserParameters = NULL;
+	
+	/* Set data size */
+	if (Size == 4) {
+		DB->CR = DMA_PDATAALIGN_WORD | DMA_MDATAALIGN_WORD;
+	} else if (Size == 2) {
+		DB->CR = DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD;
+	} else {
+		DB->CR = DMA_PDATAALIGN_BYTE | DMA_MDATAALIGN_BYTE;
+	}
+	
+	/* Double buffer mode is always circular */
+	DB->CR |= Channel | Direction | DMA_MINC_ENABLE | DMA_SxCR_DBM | DMA_SxCR_CIRC | DMA_PRIORITY_HIGH | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	
+	/* Disable stream and wait for it */
+	Stream->CR &= ~DMA_SxCR_EN;
+	while (Stream->CR & DMA_SxCR_EN);
+	
+	/* Enable DMA clock */
+	TM_DMA_Init(Stream, NULL);
+	
+	/* Set internal handler for stream */
+	DMA_INT_Handlers[GET_STREAM_INDEX(Stream)].Param = DB;
+	DMA_INT_Handlers[GET_STREAM_INDEX(Stream)].Handler = TM_DMA_DB_INT_Process;
+	
+	/* Enable NVIC */
+	TM_DMA_EnableInterrupts(Stream);
+}
+
+uint8_t TM_DMA_DB_Start(TM_DMA_DB_t* DB, void* Buffer0, void* Buffer1, uint16_t Length, TM_DMA_DB_Callback_t Callback, void* UserParameters) {
+	DMA_Stream_TypeDef* Stream = DB->Stream;
+	
+	/* Check parameters and stream */
+	if (Buffer0 == NULL || Buffer1 == NULL || Length == 0 || (Stream->CR & DMA_SxCR_EN)) {
+		return 0;
+	}
+	
+	/* Save parameters */
+	DB->Buffer[0] = Buffer0;
+	DB->Buffer[1] = Buffer1;
+	DB->Length = Length;
+	DB->Callback = Callback;
+	DB->UserParameters = UserParameters;
+	DB->Swaps = 0;
+	DB->Running = 1;
+	
+	/* Write cached data of both buffers to memory */
+	TM_DMA_CleanDCache(Buffer0, DMA_DB_BYTES(DB));
+	TM_DMA_CleanDCache(Buffer1, DMA_DB_BYTES(DB));
+	
+	/* Clear flags */
+	TM_DMA_ClearFlag(Stream, DMA_FLAG_ALL);
+	
+	/* Set stream registers, start with memory 0 */
+	Stream->PAR = DB->Peripheral;
+	Stream->M0AR = (uint32_t)Buffer0;
+	Stream->M1AR = (uint32_t)Buffer1;
+	Stream->NDTR = Length;
+	Stream->FCR = 0;
+	Stream->CR = DB->CR;
+	
+	/* Start stream */
+	Stream->CR |= DMA_SxCR_EN;
+	
+	/* Stream has started */
+	return 1;
+}
+
+void TM_DMA_DB_Stop(TM_DMA_DB_t* DB) {
+	/* Stop stream and wait for it */
+	DB->Running = 0;
+	DB->Stream->CR &= ~DMA_SxCR_EN;
+	while (DB->Stream->CR & DMA_SxCR_EN);
+	
+	/* Clear flags */
+	TM_DMA_ClearFlag(DB->Stream, DMA_FLAG_ALL);
+}
+
+void* TM_DMA_DB_GetIdleBuffer(TM_DMA_DB_t* DB) {
+	/* CT bit tells which memory is used by DMA */
+	return DB->Buffer[(DB->Stream->CR & DMA_SxCR_CT) ? 0 : 1];
+}
+
+void TM_DMA_DB_SetNextBuffer(TM_DMA_DB_t* DB, void* Buffer) {
+	/* Write cached data of new buffer to memory */
+	TM_DMA_CleanDCache(Buffer, DMA_DB_BYTES(DB));
+	
+	/* Only memory register not used by DMA can be written */
+	if (DB->Stream->CR & DMA_SxCR_CT) {
+		DB->Stream->M0AR = (uint32_t)Buffer;
+		DB->Buffer[0] = Buffer;
+	} else {
+		DB->Stream->M1AR = (uint32_t)Buffer;
+		DB->Buffer[1] = Buffer;
+	}
+}
+
 /*****************************************************************/
 /*                 DMA INTERRUPT USER CALLBACKS                  */
 /*****************************************************************/
@@ -234,13 +575,367 @@ __weak void TM_DMA_FIFOErrorHandler(DMA_Stream_TypeDef* DMA_Stream) {
 /*****************************************************************/
 /*                    DMA INTERNAL FUNCTIONS                     */
 /*****************************************************************/
+static TM_DMA_MEM_Result_t TM_DMA_MEM_INT_Add(uint32_t Destination, uint32_t Source, uint32_t Pattern, uint8_t Fill, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters) {
+	TM_DMA_MEM_INT_Request_t* Request;
+	uint32_t irq;
+	
+	/* Get interrupt status */
+	irq = __get_PRIMASK();
+	
+	/* Disable interrupts, queue is also used in DMA interrupt */
+	__disable_irq();
+	
+	/* Check for free space */
+	if (DMA_MEM.Count >= DMA_MEM_QUEUE_SIZE) {
+		/* Enable IRQ if necessary */
+		if (!irq) {
+			__enable_irq();
+		}
+		return TM_DMA_MEM_Result_Full;
+	}
+	
+	/* Fill request */
+	Request = &DMA_MEM.Queue[DMA_MEM.In];
+	Request->Destination = Destination;
+	Request->Source = Source;
+	Request->Pattern = Pattern;
+	Request->Fill = Fill;
+	Request->Length = Length;
+	Request->Callback = Callback;
+	Request->UserParameters = UserParameters;
+	
+	/* Make memory coherent for DMA when data cache is enabled, destination is invalidated again when written */
+	if (!Fill) {
+		TM_DMA_CleanDCache((const void *)Source, Length);
+	} else {
+		/* Pattern in request is DMA source for fill */
+		TM_DMA_CleanDCache(&Request->Pattern, sizeof(Request->Pattern));
+	}
+	TM_DMA_CleanDCache((const void *)Destination, Length);
+	
+	/* Go to next slot */
+	if (++DMA_MEM.In >= DMA_MEM_QUEUE_SIZE) {
+		DMA_MEM.In = 0;
+	}
+	
+	/* Start DMA if this is the only request */
+	if (++DMA_MEM.Count == 1) {
+		TM_DMA_MEM_INT_Start();
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Request added */
+	return TM_DMA_MEM_Result_Ok;
+}
+
+static uint8_t TM_DMA_MEM_INT_CPU(void* Destination, const void* Source, uint8_t Value, uint32_t Length) {
+	uint32_t irq;
+	
+	/* Get interrupt status */
+	irq = __get_PRIMASK();
+	
+	/* Disable interrupts, queue must stay empty while CPU works */
+	__disable_irq();
+	
+	/* Request has to wait in queue to keep order */
+	if (DMA_MEM.Count) {
+		if (!irq) {
+			__enable_irq();
+		}
+		return 0;
+	}
+	
+	/* Copy or fill memory, requests are short */
+	if (Source != NULL) {
+		memcpy(Destination, Source, Length);
+	} else {
+		memset(Destination, Value, Length);
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	return 1;
+}
+
+static void TM_DMA_MEM_INT_Start(void) {
+	TM_DMA_MEM_INT_Request_t* Request = &DMA_MEM.Queue[DMA_MEM.Out];
+	DMA_Stream_TypeDef* Stream = DMA_MEM_STREAM;
+	uint32_t source, align, size, items, cr, fcr;
+	
+	/* Fill uses fixed source address */
+	source = Request->Fill ? (uint32_t)&Request->Pattern : Request->Source;
+	
+	/* Widest data size allowed by addresses and length */
+	align = Request->Destination | source | Request->Length;
+	if (!(align & 0x03)) {
+		size = 4;
+		cr = DMA_PDATAALIGN_WORD | DMA_MDATAALIGN_WORD;
+	} else if (!(align & 0x01)) {
+		size = 2;
+		cr = DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD;
+	} else {
+		size = 1;
+		cr = DMA_PDATAALIGN_BYTE | DMA_MDATAALIGN_BYTE;
+	}
+	
+	/* Number of items for this transfer */
+	items = Request->Length / size;
+	if (items > DMA_MEM_MAX_ITEMS) {
+		items = DMA_MEM_MAX_ITEMS;
+	}
+	DMA_MEM.Chunk = items * size;
+	
+	/* Use 16-bytes bursts when they can not cross 1kB boundary */
+	if (!((Request->Destination | source | DMA_MEM.Chunk) & 0x0F)) {
+		if (size == 4) {
+			cr |= DMA_MBURST_INC4 | DMA_PBURST_INC4;
+		} else if (size == 2) {
+			cr |= DMA_MBURST_INC8 | DMA_PBURST_INC8;
+		} else {
+			cr |= DMA_MBURST_INC16 | DMA_PBURST_INC16;
+		}
+	}
+	
+	/* Memory to memory, peripheral port is source */
+	cr |= DMA_MEM_CHANNEL | DMA_MEMORY_TO_MEMORY | DMA_MINC_ENABLE | DMA_PRIORITY_LOW | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	if (!Request->Fill) {
+		cr |= DMA_PINC_ENABLE;
+	}
+	
+	/* FIFO is mandatory for memory-to-memory mode */
+	fcr = DMA_SxFCR_DMDIS | DMA_FIFO_THRESHOLD_FULL;
+	
+	/* Disable stream and wait for it */
+	Stream->CR &= ~DMA_SxCR_EN;
+	while (Stream->CR & DMA_SxCR_EN);
+	
+	/* Clear flags */
+	TM_DMA_ClearFlag(Stream, DMA_FLAG_ALL);
+	
+	/* Set addresses and length */
+	Stream->PAR = source;
+	Stream->M0AR = Request->Destination;
+	Stream->NDTR = items;
+	Stream->FCR = fcr;
+	Stream->CR = cr;
+	
+	/* Start transfer */
+	Stream->CR |= DMA_SxCR_EN;
+}
+
+static uint8_t TM_DMA_MEM_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param) {
+	TM_DMA_MEM_INT_Request_t* Request;
+	TM_DMA_MEM_Result_t result = TM_DMA_MEM_Result_Ok;
+	TM_DMA_MEM_Callback_t callback;
+	void* params;
+	
+	/* Check if anything is active */
+	if (DMA_MEM.Count == 0) {
+		return 1;
+	}
+	Request = &DMA_MEM.Queue[DMA_MEM.Out];
+	
+	/* Check flags */
+	if (flags & (DMA_FLAG_TEIF | DMA_FLAG_DMEIF)) {
+		/* Stop with error, ignore rest of request */
+		result = TM_DMA_MEM_Result_Error;
+		Request->Length = 0;
+	} else if (flags & DMA_FLAG_TCIF) {
+		/* Drop cached lines of written chunk */
+		TM_DMA_InvalidateDCache((void *)Request->Destination, DMA_MEM.Chunk);
+		
+		/* Move to next chunk */
+		Request->Length -= DMA_MEM.Chunk;
+		Request->Destination += DMA_MEM.Chunk;
+		if (!Request->Fill) {
+			Request->Source += DMA_MEM.Chunk;
+		}
+	} else {
+		/* Not interested in other flags */
+		return 1;
+	}
+	
+	/* Continue with the same request */
+	if (Request->Length) {
+		TM_DMA_MEM_INT_Start();
+		return 1;
+	}
+	
+	/* Save callback, slot can be reused after removal */
+	callback = Request->Callback;
+	params = Request->UserParameters;
+	
+	/* Remove request from queue */
+	if (++DMA_MEM.Out >= DMA_MEM_QUEUE_SIZE) {
+		DMA_MEM.Out = 0;
+	}
+	DMA_MEM.Count--;
+	
+	/* Start next request before callback to minimize gap */
+	if (DMA_MEM.Count) {
+		TM_DMA_MEM_INT_Start();
+	}
+	
+	/* Call user callback */
+	if (callback) {
+		callback(result, params);
+	}
+	
+	/* Stream is owned by engine */
+	return 1;
+}
+
+static void TM_DMA_SG_INT_Load(TM_DMA_SG_t* SG) {
+	DMA_Stream_TypeDef* Stream = SG->Stream;
+	uint32_t length = (uint32_t)SG->Current->Length * SG->Size;
+	
+	/* Write cached data of fragment and destination to memory */
+	TM_DMA_CleanDCache(SG->Current->Address, length);
+	if (SG->MemToMem) {
+		TM_DMA_CleanDCache((const void *)SG->Destination, length);
+	}
+	
+	/* Set memory side of descriptor */
+	if (SG->MemToMem) {
+		Stream->PAR = (uint32_t)SG->Current->Address;
+		Stream->M0AR = SG->Destination;
+	} else {
+		Stream->M0AR = (uint32_t)SG->Current->Address;
+	}
+	
+	/* Set length and start */
+	Stream->NDTR = SG->Current->Length;
+	Stream->CR |= DMA_SxCR_EN;
+}
+
+static uint8_t TM_DMA_SG_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param) {
+	TM_DMA_SG_t* SG = (TM_DMA_SG_t *)Param;
+	const TM_DMA_SG_Desc_t* next;
+#if DMA_SG_MEASURE_GAP
+	uint32_t start = DWT->CYCCNT;
+	uint32_t gap;
+#endif
+	
+	/* Stream is not used by chain right now, let user handle interrupts */
+	if (SG->Current == NULL) {
+		return 0;
+	}
+	
+	/* Transfer error, stop chain */
+	if (flags & DMA_FLAG_TEIF) {
+		SG->Current = NULL;
+		if (SG->Callback) {
+			SG->Callback(SG, 1, SG->UserParameters);
+		}
+		return 1;
+	}
+	
+	/* Only transfer complete is interesting */
+	if (!(flags & DMA_FLAG_TCIF)) {
+		return 1;
+	}
+	
+	/* Drop cached lines of written memory and move destination on memory-to-memory */
+	if (SG->MemToMem) {
+		TM_DMA_InvalidateDCache((void *)SG->Destination, (uint32_t)SG->Current->Length * SG->Size);
+		SG->Destination += (uint32_t)SG->Current->Length * SG->Size;
+	} else if (SG->PeriphToMem) {
+		TM_DMA_InvalidateDCache((void *)SG->Current->Address, (uint32_t)SG->Current->Length * SG->Size);
+	}
+	
+	/* Find next non-empty descriptor */
+	next = SG->Current->Next;
+	while (next && next->Length == 0) {
+		next = next->Next;
+	}
+	SG->Current = next;
+	
+	/* Start next descriptor immediately */
+	if (next) {
+		TM_DMA_SG_INT_Load(SG);
+		
+#if DMA_SG_MEASURE_GAP
+		/* Save reprogramming time */
+		gap = DWT->CYCCNT - start;
+		SG->GapLast = gap;
+		if (gap > SG->GapMax) {
+			SG->GapMax = gap;
+		}
+		if (gap < SG->GapMin) {
+			SG->GapMin = gap;
+		}
+		SG->Reloads++;
+#endif
+		return 1;
+	}
+	
+	/* Chain finished */
+	if (SG->Callback) {
+		SG->Callback(SG, 0, SG->UserParameters);
+	}
+	return 1;
+}
+
+static uint8_t TM_DMA_DB_INT_Process(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param) {
+	TM_DMA_DB_t* DB = (TM_DMA_DB_t *)Param;
+	void* buffer;
+	
+	/* Stream is not in double buffer mode right now, let user handle interrupts */
+	if (!DB->Running) {
+		return 0;
+	}
+	
+	/* Transfer error, stream is disabled by hardware */
+	if (flags & DMA_FLAG_TEIF) {
+		DB->Running = 0;
+		if (DB->Callback) {
+			DB->Callback(DB, NULL, DB->UserParameters);
+		}
+		return 1;
+	}
+	
+	/* Buffer completed, DMA has already switched to other buffer */
+	if (flags & DMA_FLAG_TCIF) {
+		buffer = TM_DMA_DB_GetIdleBuffer(DB);
+		DB->Swaps++;
+		
+		/* Drop cached lines of received data */
+		if (!(DB->CR & DMA_SxCR_DIR)) {
+			TM_DMA_InvalidateDCache(buffer, DMA_DB_BYTES(DB));
+		}
+		if (DB->Callback) {
+			DB->Callback(DB, buffer, DB->UserParameters);
+		}
+		
+		/* Write data prepared by user in callback to memory */
+		if (DB->CR & DMA_SxCR_DIR) {
+			TM_DMA_CleanDCache(TM_DMA_DB_GetIdleBuffer(DB), DMA_DB_BYTES(DB));
+		}
+	}
+	return 1;
+}
+
 static void TM_DMA_INT_ProcessInterrupt(DMA_Stream_TypeDef* DMA_Stream) {
+	TM_DMA_INT_Handler_t* handler;
+	
 	/* Get DMA interrupt status flags */
 	uint16_t flags = TM_DMA_GetFlags(DMA_Stream, DMA_FLAG_ALL);
 	
 	/* Clear flags */
 	TM_DMA_ClearFlag(DMA_Stream, DMA_FLAG_ALL);
 	
+	/* Check if stream is used internally by library */
+	handler = &DMA_INT_Handlers[GET_STREAM_INDEX(DMA_Stream)];
+	if (handler->Handler && handler->Handler(DMA_Stream, flags, handler->Param)) {
+		return;
+	}
+	
 	/* Call user callback function */
 	
 	/* Check transfer complete flag */
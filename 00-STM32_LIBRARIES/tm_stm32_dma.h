@@ -35,7 +35,7 @@
 @endverbatim
  */
 #ifndef TM_DMA_H
-#define TM_DMA_H 100
+#define TM_DMA_H 140
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -81,11 +81,89 @@ extern "C" {
  * Every stream on DMA can make 5 interrupts. My library is designed in a way that specific callback is called for each interrupt type.
  * Check functions section for more informations.
  *
+ * \par Memory to memory engine
+ *
+ * Library can use one DMA2 stream as asynchronous memcpy/memset engine. Requests are put to queue and executed one after another.
+ * Requests longer than 65535 items are split into more DMA transfers internally and data width, FIFO and burst are selected
+ * according to alignment of addresses and length. Small requests are copied by CPU, when engine is idle.
+ *
+ * Stream used by engine is fully handled by library, user callbacks for this stream are not called.
+ *
+@code
+//Select stream and channel for memory-to-memory engine, DMA2 only
+#define DMA_MEM_STREAM              DMA2_Stream0
+#define DMA_MEM_CHANNEL             DMA_CHANNEL_0
+
+//Maximal number of pending requests
+#define DMA_MEM_QUEUE_SIZE          8
+
+//Requests shorter than this number of bytes are done by CPU
+#define DMA_MEM_CPU_THRESHOLD       64
+@endcode
+ *
+ * \par Scatter-gather descriptor chains
+ *
+ * DMA on STM32F4/F7 does not support linked-list mode. Library emulates it in software with chain of @ref TM_DMA_SG_Desc_t descriptors.
+ * On transfer complete interrupt, stream is immediately reprogrammed with next descriptor. Only memory address and length are changed.
+ *
+ * Chains can be used for memory-to-peripheral (USART TX, SPI TX, check @ref TM_USART_DMA_SendChain and @ref TM_SPI_DMA_SendChain)
+ * and for memory-to-memory (DMA2 only) transfers where fragments are gathered to one continuous destination buffer.
+ *
+ * Reprogramming time, measured with DWT cycle counter from start of library interrupt handler to enabled stream,
+ * is saved to @ref TM_DMA_SG_t structure. Hardware interrupt entry latency is not included.
+ * DWT counter must be enabled, for example with @ref TM_GENERAL_DWTCounterEnable. Set DMA_SG_MEASURE_GAP to 0 to disable measurement.
+ *
+@code
+//Packet with header, payload and CRC fragments
+TM_DMA_SG_Desc_t crc_desc = {crc, 2, NULL};
+TM_DMA_SG_Desc_t payload_desc = {payload, 100, &crc_desc};
+TM_DMA_SG_Desc_t header_desc = {header, 4, &payload_desc};
+
+TM_USART_DMA_SendChain(USART1, &SG, &header_desc, NULL, NULL);
+@endcode
+ *
+ * \par Double buffer mode
+ *
+ * Stream can work in hardware double buffer mode (DBM bit) with @ref TM_DMA_DB_t structure.
+ * DMA switches between 2 memory buffers without any CPU intervention and callback is called each time one buffer is completed.
+ * While DMA works on one buffer, the whole other buffer is available to the user, what gives twice longer processing window
+ * than half-transfer interrupts on single circular buffer.
+ *
+ * Address of idle buffer can be changed on the fly with @ref TM_DMA_DB_SetNextBuffer.
+ * ADC, DAC and SPI RX libraries use this mode for gap-free continuous acquisition and output.
+ *
+ * @note   Memory-to-memory direction is not supported by hardware in double buffer mode
+ *
+ * \par Data cache on STM32F7xx
+ *
+ * When data cache is enabled, memory-to-memory engine, scatter-gather chains and double buffer mode
+ * clean buffers read by DMA before transfer and invalidate buffers written by DMA after transfer.
+ * Buffers written by DMA should be aligned to 32 bytes and have length multiple of 32 bytes,
+ * otherwise data next to buffer in the same cache line can be lost on invalidation.
+ * Use @ref TM_DMA_CleanDCache and @ref TM_DMA_InvalidateDCache for own transfers.
+ *
  * \par Changelog
  *
 @verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added asynchronous memory-to-memory copy/fill engine with request queue
+
+ Version 1.2
+  - October 19, 2026
+  - Added software scatter-gather descriptor chains
+
+ Version 1.3
+  - October 19, 2026
+  - Added hardware double buffer mode API
+
+ Version 1.4
+  - October 19, 2026
+  - Added TM_DMA_SetHandler function for other libraries to handle stream interrupts
+  - Added TM_DMA_CleanDCache and TM_DMA_InvalidateDCache functions for STM32F7xx data cache
 @endverbatim
  *
  * \par Dependencies
@@ -129,6 +207,29 @@ extern "C" {
 #define DMA2_NVIC_PREEMPTION_PRIORITY   0x01
 #endif
 
+/* Memory-to-memory engine stream, DMA2 only */
+#ifndef DMA_MEM_STREAM
+#define DMA_MEM_STREAM                  DMA2_Stream0
+#endif
+#ifndef DMA_MEM_CHANNEL
+#define DMA_MEM_CHANNEL                 DMA_CHANNEL_0
+#endif
+
+/* Memory-to-memory engine queue size */
+#ifndef DMA_MEM_QUEUE_SIZE
+#define DMA_MEM_QUEUE_SIZE              8
+#endif
+
+/* Requests shorter than this are done by CPU */
+#ifndef DMA_MEM_CPU_THRESHOLD
+#define DMA_MEM_CPU_THRESHOLD           64
+#endif
+
+/* Measure scatter-gather reprogramming time with DWT */
+#ifndef DMA_SG_MEASURE_GAP
+#define DMA_SG_MEASURE_GAP              1
+#endif
+
 /**
  * @}
  */
@@ -138,7 +239,94 @@ extern "C" {
  * @brief    Library Typedefs
  * @{
  */
-/* Typedefs here */
+
+/**
+ * @brief  Memory-to-memory engine result enumeration
+ */
+typedef enum {
+	TM_DMA_MEM_Result_Ok = 0x00, /*!< Request is queued or DMA transfer finished successfully */
+	TM_DMA_MEM_Result_CPU,       /*!< Request was done by CPU immediately */
+	TM_DMA_MEM_Result_Full,      /*!< Request queue is full, request was not accepted */
+	TM_DMA_MEM_Result_Error      /*!< Invalid parameters or DMA transfer error */
+} TM_DMA_MEM_Result_t;
+
+/**
+ * @brief  Memory-to-memory request finished callback
+ * @param  Result: Member of @ref TM_DMA_MEM_Result_t with transfer result
+ * @param  *UserParameters: Pointer to user parameters passed on request
+ */
+typedef void (*TM_DMA_MEM_Callback_t)(TM_DMA_MEM_Result_t Result, void* UserParameters);
+
+/**
+ * @brief  Stream interrupt handler set with @ref TM_DMA_SetHandler
+ * @param  *DMA_Stream: Pointer to DMA stream with interrupt
+ * @param  Flags: Stream flags, already cleared, aligned to DMA_FLAG_xxx defines
+ * @param  *Param: Pointer to parameter passed to @ref TM_DMA_SetHandler
+ * @retval 1 when interrupt was handled and user callbacks should not be called, 0 otherwise
+ */
+typedef uint8_t (*TM_DMA_Handler_t)(DMA_Stream_TypeDef* DMA_Stream, uint32_t Flags, void* Param);
+
+/**
+ * @brief  Scatter-gather descriptor
+ */
+typedef struct _TM_DMA_SG_Desc_t {
+	const void* Address;                   /*!< Memory address of fragment */
+	uint16_t Length;                       /*!< Number of data items in fragment. Empty descriptors are skipped */
+	const struct _TM_DMA_SG_Desc_t* Next;  /*!< Pointer to next descriptor or NULL on last one */
+} TM_DMA_SG_Desc_t;
+
+/**
+ * @brief  Scatter-gather chain structure
+ */
+typedef struct _TM_DMA_SG_t {
+	DMA_Stream_TypeDef* Stream;            /*!< DMA stream used for chain */
+	uint32_t Address;                      /*!< Peripheral data register address or destination memory on memory-to-memory */
+	uint32_t Destination;                  /*!< Current destination on memory-to-memory. Meant for private use */
+	uint8_t Size;                          /*!< Data item size in units of bytes */
+	uint8_t MemToMem;                      /*!< Set to 1 when memory-to-memory direction is used */
+	uint8_t PeriphToMem;                   /*!< Set to 1 when peripheral-to-memory direction is used */
+	const TM_DMA_SG_Desc_t* __IO Current;  /*!< Descriptor in transfer or NULL when chain is idle */
+	void (*Callback)(struct _TM_DMA_SG_t* SG, uint8_t Error, void* UserParameters); /*!< Chain finished callback */
+	void* UserParameters;                  /*!< User parameters for callback */
+	uint32_t GapLast;                      /*!< Last reprogramming time in units of CPU cycles */
+	uint32_t GapMin;                       /*!< Minimal reprogramming time in units of CPU cycles */
+	uint32_t GapMax;                       /*!< Maximal reprogramming time in units of CPU cycles */
+	uint32_t Reloads;                      /*!< Number of descriptor reloads done in interrupt */
+} TM_DMA_SG_t;
+
+/**
+ * @brief  Scatter-gather chain finished callback
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t chain structure
+ * @param  Error: Set to 1 when chain was stopped because of transfer error
+ * @param  *UserParameters: Pointer to user parameters passed on start
+ */
+typedef void (*TM_DMA_SG_Callback_t)(TM_DMA_SG_t* SG, uint8_t Error, void* UserParameters);
+
+/**
+ * @brief  Double buffer stream structure
+ */
+typedef struct _TM_DMA_DB_t {
+	DMA_Stream_TypeDef* Stream;            /*!< DMA stream used in double buffer mode */
+	uint32_t CR;                           /*!< Stream configuration. Meant for private use */
+	uint32_t Peripheral;                   /*!< Peripheral data register address */
+	void* Buffer[2];                       /*!< Pointers to memory 0 and memory 1 buffers */
+	uint16_t Length;                       /*!< Number of data items in each buffer */
+	__IO uint8_t Running;                  /*!< Set to 1 when stream is running */
+	__IO uint32_t Swaps;                   /*!< Number of completed buffers since start */
+	void (*Callback)(struct _TM_DMA_DB_t* DB, void* Buffer, void* UserParameters); /*!< Buffer completed callback */
+	void* UserParameters;                  /*!< User parameters for callback */
+} TM_DMA_DB_t;
+
+/**
+ * @brief  Double buffer completed callback
+ * @note   Called from DMA interrupt each time DMA finishes one buffer and switches to other one
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @param  *Buffer: Pointer to completed buffer which is now idle and owned by user.
+ *            Set to NULL when stream was stopped because of transfer error
+ * @param  *UserParameters: Pointer to user parameters passed on start
+ */
+typedef void (*TM_DMA_DB_Callback_t)(TM_DMA_DB_t* DB, void* Buffer, void* UserParameters);
+
 /**
  * @}
  */
@@ -212,6 +400,184 @@ void TM_DMA_EnableInterrupts(DMA_Stream_TypeDef* DMA_Stream);
  */
 void TM_DMA_DisableInterrupts(DMA_Stream_TypeDef* DMA_Stream);
 
+/**
+ * @brief  Gets interrupt flags for DMA stream
+ * @param  *DMA_Stream: Pointer to @ref DMA_Stream_TypeDef DMA stream where you want to read flags
+ * @param  flag: Flags to read. Use DMA_FLAG_ALL to read all flags
+ * @retval Flags set for stream, aligned to DMA_FLAG_xxx defines
+ */
+uint32_t TM_DMA_GetFlags(DMA_Stream_TypeDef* DMA_Stream, uint32_t flag);
+
+/**
+ * @brief  Sets handler called from stream interrupt before user callbacks
+ * @note   Meant for libraries which fully handle one stream, like @ref TM_CRC
+ * @param  *DMA_Stream: Pointer to DMA stream
+ * @param  Handler: Handler function or NULL to remove it
+ * @param  *Param: Pointer to parameter for handler
+ * @retval None
+ */
+void TM_DMA_SetHandler(DMA_Stream_TypeDef* DMA_Stream, TM_DMA_Handler_t Handler, void* Param);
+
+/**
+ * @brief  Writes data cache lines of memory block to memory before DMA reads it
+ * @note   Does nothing on STM32F4xx or when data cache is disabled
+ * @param  *Address: Pointer to memory block
+ * @param  Length: Memory block length in units of bytes
+ * @retval None
+ */
+void TM_DMA_CleanDCache(const void* Address, uint32_t Length);
+
+/**
+ * @brief  Invalidates data cache lines of memory block after DMA has written to it
+ * @note   Does nothing on STM32F4xx or when data cache is disabled
+ * @note   Whole cache lines are invalidated, block should be aligned to 32 bytes
+ * @param  *Address: Pointer to memory block
+ * @param  Length: Memory block length in units of bytes
+ * @retval None
+ */
+void TM_DMA_InvalidateDCache(void* Address, uint32_t Length);
+
+/**
+ * @brief  Initializes memory-to-memory engine on DMA_MEM_STREAM stream
+ * @note   Interrupts for engine stream are enabled and handled by library
+ * @param  None
+ * @retval None
+ */
+void TM_DMA_MEM_Init(void);
+
+/**
+ * @brief  Copies memory block using DMA
+ * @note   Function returns immediately, callback is called when data are copied.
+ *            Source and destination must not be changed until callback is called
+ * @note   When Length is less than DMA_MEM_CPU_THRESHOLD and engine is idle, copy is done by CPU and callback is called before function returns
+ * @param  *Destination: Pointer to destination memory
+ * @param  *Source: Pointer to source memory
+ * @param  Length: Number of bytes to copy
+ * @param  Callback: Callback function called when request is finished. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback function
+ * @retval Member of @ref TM_DMA_MEM_Result_t enumeration
+ */
+TM_DMA_MEM_Result_t TM_DMA_MEM_Copy(void* Destination, const void* Source, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Fills memory block with constant byte using DMA
+ * @note   Works the same way as @ref TM_DMA_MEM_Copy
+ * @param  *Destination: Pointer to destination memory
+ * @param  Value: Byte value to fill memory with
+ * @param  Length: Number of bytes to fill
+ * @param  Callback: Callback function called when request is finished. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback function
+ * @retval Member of @ref TM_DMA_MEM_Result_t enumeration
+ */
+TM_DMA_MEM_Result_t TM_DMA_MEM_Set(void* Destination, uint8_t Value, uint32_t Length, TM_DMA_MEM_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Gets number of requests waiting or being processed by memory-to-memory engine
+ * @param  None
+ * @retval Number of pending requests. When zero, engine is idle
+ */
+uint8_t TM_DMA_MEM_Pending(void);
+
+/**
+ * @brief  Initializes scatter-gather chain on DMA stream
+ * @note   Stream interrupts are handled by library while chain is active. When chain is idle, user callbacks are called as usual
+ * @param  *SG: Pointer to empty @ref TM_DMA_SG_t structure
+ * @param  *Stream: Pointer to @ref DMA_Stream_TypeDef DMA stream to use. Use DMA2 stream for memory-to-memory
+ * @param  Channel: DMA channel for stream, DMA_CHANNEL_x
+ * @param  Direction: DMA_MEMORY_TO_PERIPH or DMA_MEMORY_TO_MEMORY
+ * @param  Address: Peripheral data register address or destination buffer on memory-to-memory direction
+ * @param  Size: Data item size in units of bytes, 1, 2 or 4
+ * @retval None
+ */
+void TM_DMA_SG_Init(TM_DMA_SG_t* SG, DMA_Stream_TypeDef* Stream, uint32_t Channel, uint32_t Direction, uint32_t Address, uint8_t Size);
+
+/**
+ * @brief  Deinitializes scatter-gather chain and releases stream
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure
+ * @retval None
+ */
+void TM_DMA_SG_DeInit(TM_DMA_SG_t* SG);
+
+/**
+ * @brief  Starts transfer of descriptor chain
+ * @note   Descriptors and data they point to must be valid until callback is called
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure
+ * @param  *First: Pointer to first descriptor in chain
+ * @param  Callback: Callback called when chain is finished. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Start status:
+ *            - 0: Chain is busy, stream is enabled or chain is empty
+ *            - > 0: Chain has started
+ */
+uint8_t TM_DMA_SG_Start(TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Resets reprogramming time statistics
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure
+ * @retval None
+ */
+void TM_DMA_SG_ResetGap(TM_DMA_SG_t* SG);
+
+/**
+ * @brief  Checks if chain is still in transfer
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure
+ * @retval Busy status
+ * @note   Defined as macro for faster execution
+ */
+#define TM_DMA_SG_IsBusy(SG)             ((SG)->Current != NULL)
+
+/**
+ * @brief  Initializes DMA stream for double buffer mode
+ * @note   Stream interrupts are handled by library while stream is running in double buffer mode
+ * @param  *DB: Pointer to empty @ref TM_DMA_DB_t structure
+ * @param  *Stream: Pointer to @ref DMA_Stream_TypeDef DMA stream to use
+ * @param  Channel: DMA channel for stream, DMA_CHANNEL_x
+ * @param  Direction: DMA_PERIPH_TO_MEMORY or DMA_MEMORY_TO_PERIPH
+ * @param  Peripheral: Peripheral data register address
+ * @param  Size: Data item size in units of bytes, 1, 2 or 4
+ * @retval None
+ */
+void TM_DMA_DB_Init(TM_DMA_DB_t* DB, DMA_Stream_TypeDef* Stream, uint32_t Channel, uint32_t Direction, uint32_t Peripheral, uint8_t Size);
+
+/**
+ * @brief  Starts stream in double buffer mode
+ * @note   DMA starts with Buffer0. Peripheral DMA requests must be enabled by user or by library which uses this mode
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @param  *Buffer0: Pointer to first buffer
+ * @param  *Buffer1: Pointer to second buffer
+ * @param  Length: Number of data items in each buffer
+ * @param  Callback: Callback called each time buffer is completed. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Start status:
+ *            - 0: Stream is already enabled or invalid parameters
+ *            - > 0: Stream has started
+ */
+uint8_t TM_DMA_DB_Start(TM_DMA_DB_t* DB, void* Buffer0, void* Buffer1, uint16_t Length, TM_DMA_DB_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Stops stream in double buffer mode
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @retval None
+ */
+void TM_DMA_DB_Stop(TM_DMA_DB_t* DB);
+
+/**
+ * @brief  Gets buffer which is not used by DMA at the moment
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @retval Pointer to idle buffer
+ */
+void* TM_DMA_DB_GetIdleBuffer(TM_DMA_DB_t* DB);
+
+/**
+ * @brief  Changes address of idle buffer while stream is running
+ * @note   New buffer will be used by DMA after current buffer is completed.
+ *            Call it from callback or soon after it, before DMA finishes current buffer
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @param  *Buffer: Pointer to new buffer with at least Length data items
+ * @retval None
+ */
+void TM_DMA_DB_SetNextBuffer(TM_DMA_DB_t* DB, void* Buffer);
+
 /**
  * @brief  Transfer complete callback
  * @note   This function is called when interrupt for specific stream happens for transfer complete
@@ -40,6 +40,26 @@ const arm_cfft_instance_f32 CFFT_Instances[] = {
 	{4096, twiddleCoef_4096, armBitRevIndexTable4096, ARMBITREVINDEXTABLE4096_TABLE_LENGTH}
 };
 
+/* Fixed point CFFT instances from ARM CONST STRUCTURES */
+static const arm_cfft_instance_q15* const CFFT_Instances_Q15[] = {
+	&arm_cfft_sR_q15_len16, &arm_cfft_sR_q15_len32, &arm_cfft_sR_q15_len64,
+	&arm_cfft_sR_q15_len128, &arm_cfft_sR_q15_len256, &arm_cfft_sR_q15_len512,
+	&arm_cfft_sR_q15_len1024, &arm_cfft_sR_q15_len2048, &arm_cfft_sR_q15_len4096
+};
+static const arm_cfft_instance_q31* const CFFT_Instances_Q31[] = {
+	&arm_cfft_sR_q31_len16, &arm_cfft_sR_q31_len32, &arm_cfft_sR_q31_len64,
+	&arm_cfft_sR_q31_len128, &arm_cfft_sR_q31_len256, &arm_cfft_sR_q31_len512,
+	&arm_cfft_sR_q31_len1024, &arm_cfft_sR_q31_len2048, &arm_cfft_sR_q31_len4096
+};
+
+static uint8_t TM_FFT_INT_SizeIndex(uint16_t FFT_Size);
+
+#if FFT_RFFT_8192
+/* Twiddle factors for last stage of 8192 real FFT */
+static float32_t RFFT_Twiddle8192[8192];
+static uint8_t RFFT_Twiddle8192_Ready;
+#endif
+
 uint8_t TM_FFT_Init_F32(TM_FFT_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
 	uint8_t i;
 	
@@ -167,3 +187,367 @@ void TM_FFT_Free_F32(TM_FFT_F32_t* FFT) {
 		LIB_FREE_FUNC(FFT->Output);
 	}
 }
+
+uint8_t TM_FFT_Init_Real_F32(TM_FFT_Real_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
+#if FFT_RFFT_8192
+	uint16_t i;
+#endif
+	
+	/* Set to zero */
+	FFT->FFT_Size = 0;
+	FFT->Count = 0;
+	FFT->UseMalloc = 0;
+	
+	/* Initialize ARM real FFT instance */
+	if (arm_rfft_fast_init_f32(&FFT->S, FFT_Size) != ARM_MATH_SUCCESS) {
+#if FFT_RFFT_8192
+		/* Check for 8192 length, not supported by all ARM MATH versions */
+		if (FFT_Size != 8192) {
+			return 1;
+		}
+		
+		/* Calculate twiddle factors only once */
+		if (!RFFT_Twiddle8192_Ready) {
+			for (i = 0; i < 4096; i++) {
+				RFFT_Twiddle8192[2 * i] = (float32_t)sin(2.0 * PI * i / 8192.0);
+				RFFT_Twiddle8192[2 * i + 1] = (float32_t)cos(2.0 * PI * i / 8192.0);
+			}
+			RFFT_Twiddle8192_Ready = 1;
+		}
+		
+		/* Use 4096 CFFT for 8192 real FFT */
+		FFT->S.Sint = CFFT_Instances[8];
+		FFT->S.fftLenRFFT = 8192;
+		FFT->S.pTwiddleRFFT = RFFT_Twiddle8192;
+#else
+		/* There is not valid input, return */
+		return 1;
+#endif
+	}
+	
+	/* Set FFT size */
+	FFT->FFT_Size = FFT_Size;
+	
+	/* If malloc selected for allocation, use it */
+	if (use_malloc) {
+		/* Allocate input buffer */
+		FFT->Input = (float32_t *) LIB_ALLOC_FUNC(FFT->FFT_Size * sizeof(float32_t));
+		
+		/* Check for success */
+		if (FFT->Input == NULL) {
+			return 2;
+		}
+		
+		/* Allocate output buffer */
+		FFT->Output = (float32_t *) LIB_ALLOC_FUNC(FFT->FFT_Size * sizeof(float32_t));
+		
+		/* Check for success */
+		if (FFT->Output == NULL) {
+			/* Deallocate input buffer */
+			LIB_FREE_FUNC(FFT->Input);
+			
+			/* Return error */
+			return 3;
+		}
+		
+		/* Malloc used, set flag */
+		FFT->UseMalloc = 1;
+	}
+	
+	/* Return OK */
+	return 0;
+}
+
+void TM_FFT_SetBuffers_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* InputBuffer, float32_t* OutputBuffer) {
+	/* If malloc is used, ignore */
+	if (FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Set pointers */
+	FFT->Input = InputBuffer;
+	FFT->Output = OutputBuffer;
+}
+
+uint8_t TM_FFT_AddToBufferReal(TM_FFT_Real_F32_t* FFT, float32_t sampleValue) {
+	/* Check if memory available */
+	if (FFT->Count < FFT->FFT_Size) {
+		/* Add to buffer */
+		FFT->Input[FFT->Count++] = sampleValue;
+	}
+	
+	/* Check if buffer full */
+	return FFT->Count >= FFT->FFT_Size;
+}
+
+void TM_FFT_Process_Real_F32(TM_FFT_Real_F32_t* FFT) {
+	/* Process FFT input data, output is packed complex spectrum */
+	arm_rfft_fast_f32(&FFT->S, FFT->Input, FFT->Output, 0);
+	
+	/* Reset count */
+	FFT->Count = 0;
+}
+
+void TM_FFT_Magnitude_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* Dst) {
+	/* DC component has only real part */
+	Dst[0] = fabsf(FFT->Output[0]);
+	
+	/* Other bins, output is always behind input so it can be in-place */
+	arm_cmplx_mag_f32(&FFT->Output[2], &Dst[1], FFT->FFT_Size / 2 - 1);
+	
+	/* Calculates maxValue and returns corresponding value and index */
+	arm_max_f32(Dst, FFT->FFT_Size / 2, &FFT->MaxValue, &FFT->MaxIndex);
+}
+
+void TM_FFT_Power_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* Dst) {
+	/* DC component has only real part */
+	Dst[0] = FFT->Output[0] * FFT->Output[0];
+	
+	/* Other bins, output is always behind input so it can be in-place */
+	arm_cmplx_mag_squared_f32(&FFT->Output[2], &Dst[1], FFT->FFT_Size / 2 - 1);
+	
+	/* Calculates maxValue and returns corresponding value and index */
+	arm_max_f32(Dst, FFT->FFT_Size / 2, &FFT->MaxValue, &FFT->MaxIndex);
+}
+
+void TM_FFT_Free_Real_F32(TM_FFT_Real_F32_t* FFT) {
+	/* Return, malloc was not used for allocation */
+	if (!FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Check input buffer */
+	if (FFT->Input) {
+		LIB_FREE_FUNC(FFT->Input);
+	}
+	
+	/* Check output buffer */
+	if (FFT->Output) {
+		LIB_FREE_FUNC(FFT->Output);
+	}
+}
+
+uint8_t TM_FFT_Init_Q15(TM_FFT_Q15_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
+	uint8_t i;
+	
+	/* Set to zero */
+	FFT->FFT_Size = 0;
+	FFT->Count = 0;
+	FFT->UseMalloc = 0;
+	
+	/* Check if fft size valid */
+	i = TM_FFT_INT_SizeIndex(FFT_Size);
+	if (i == 0xFF) {
+		return 1;
+	}
+	
+	/* Set FFT size and instance, data is scaled down by 2 in each stage */
+	FFT->FFT_Size = FFT_Size;
+	FFT->S = CFFT_Instances_Q15[i];
+	FFT->Shift = i + 4;
+	
+	/* If malloc selected for allocation, use it */
+	if (use_malloc) {
+		/* Allocate input buffer */
+		FFT->Input = (q15_t *) LIB_ALLOC_FUNC((FFT->FFT_Size * 2) * sizeof(q15_t));
+		
+		/* Check for success */
+		if (FFT->Input == NULL) {
+			return 2;
+		}
+		
+		/* Allocate output buffer */
+		FFT->Output = (q15_t *) LIB_ALLOC_FUNC(FFT->FFT_Size * sizeof(q15_t));
+		
+		/* Check for success */
+		if (FFT->Output == NULL) {
+			/* Deallocate input buffer */
+			LIB_FREE_FUNC(FFT->Input);
+			
+			/* Return error */
+			return 3;
+		}
+		
+		/* Malloc used, set flag */
+		FFT->UseMalloc = 1;
+	}
+	
+	/* Return OK */
+	return 0;
+}
+
+void TM_FFT_SetBuffers_Q15(TM_FFT_Q15_t* FFT, q15_t* InputBuffer, q15_t* OutputBuffer) {
+	/* If malloc is used, ignore */
+	if (FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Set pointers */
+	FFT->Input = InputBuffer;
+	FFT->Output = OutputBuffer;
+}
+
+uint8_t TM_FFT_AddToBuffer_Q15(TM_FFT_Q15_t* FFT, q15_t sampleValue) {
+	/* Check if memory available */
+	if (FFT->Count < FFT->FFT_Size) {
+		/* Add to buffer, imaginary part set to 0 */
+		FFT->Input[2 * FFT->Count] = sampleValue;
+		FFT->Input[2 * FFT->Count + 1] = 0;
+		
+		/* Increase count */
+		FFT->Count++;
+	}
+	
+	/* Check if buffer full */
+	return FFT->Count >= FFT->FFT_Size;
+}
+
+void TM_FFT_Process_Q15(TM_FFT_Q15_t* FFT) {
+	/* Process FFT input data */
+	arm_cfft_q15(FFT->S, FFT->Input, 0, 1);
+	
+	/* Calculate magnitude squared at each bin, no square root is needed */
+	arm_cmplx_mag_squared_q15(FFT->Input, FFT->Output, FFT->FFT_Size);
+	
+	/* Calculates maxValue and returns corresponding value and index */
+	arm_max_q15(FFT->Output, FFT->FFT_Size, &FFT->MaxValue, &FFT->MaxIndex);
+	
+	/* Reset count */
+	FFT->Count = 0;
+}
+
+void TM_FFT_Free_Q15(TM_FFT_Q15_t* FFT) {
+	/* Return, malloc was not used for allocation */
+	if (!FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Check input buffer */
+	if (FFT->Input) {
+		LIB_FREE_FUNC(FFT->Input);
+	}
+	
+	/* Check output buffer */
+	if (FFT->Output) {
+		LIB_FREE_FUNC(FFT->Output);
+	}
+}
+
+uint8_t TM_FFT_Init_Q31(TM_FFT_Q31_t* FFT, uint16_t FFT_Size, uint8_t use_malloc) {
+	uint8_t i;
+	
+	/* Set to zero */
+	FFT->FFT_Size = 0;
+	FFT->Count = 0;
+	FFT->UseMalloc = 0;
+	
+	/* Check if fft size valid */
+	i = TM_FFT_INT_SizeIndex(FFT_Size);
+	if (i == 0xFF) {
+		return 1;
+	}
+	
+	/* Set FFT size and instance, data is scaled down by 2 in each stage */
+	FFT->FFT_Size = FFT_Size;
+	FFT->S = CFFT_Instances_Q31[i];
+	FFT->Shift = i + 4;
+	
+	/* If malloc selected for allocation, use it */
+	if (use_malloc) {
+		/* Allocate input buffer */
+		FFT->Input = (q31_t *) LIB_ALLOC_FUNC((FFT->FFT_Size * 2) * sizeof(q31_t));
+		
+		/* Check for success */
+		if (FFT->Input == NULL) {
+			return 2;
+		}
+		
+		/* Allocate output buffer */
+		FFT->Output = (q31_t *) LIB_ALLOC_FUNC(FFT->FFT_Size * sizeof(q31_t));
+		
+		/* Check for success */
+		if (FFT->Output == NULL) {
+			/* Deallocate input buffer */
+			LIB_FREE_FUNC(FFT->Input);
+			
+			/* Return error */
+			return 3;
+		}
+		
+		/* Malloc used, set flag */
+		FFT->UseMalloc = 1;
+	}
+	
+	/* Return OK */
+	return 0;
+}
+
+void TM_FFT_SetBuffers_Q31(TM_FFT_Q31_t* FFT, q31_t* InputBuffer, q31_t* OutputBuffer) {
+	/* If malloc is used, ignore */
+	if (FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Set pointers */
+	FFT->Input = InputBuffer;
+	FFT->Output = OutputBuffer;
+}
+
+uint8_t TM_FFT_AddToBuffer_Q31(TM_FFT_Q31_t* FFT, q31_t sampleValue) {
+	/* Check if memory available */
+	if (FFT->Count < FFT->FFT_Size) {
+		/* Add to buffer, imaginary part set to 0 */
+		FFT->Input[2 * FFT->Count] = sampleValue;
+		FFT->Input[2 * FFT->Count + 1] = 0;
+		
+		/* Increase count */
+		FFT->Count++;
+	}
+	
+	/* Check if buffer full */
+	return FFT->Count >= FFT->FFT_Size;
+}
+
+void TM_FFT_Process_Q31(TM_FFT_Q31_t* FFT) {
+	/* Process FFT input data */
+	arm_cfft_q31(FFT->S, FFT->Input, 0, 1);
+	
+	/* Calculate magnitude squared at each bin, no square root is needed */
+	arm_cmplx_mag_squared_q31(FFT->Input, FFT->Output, FFT->FFT_Size);
+	
+	/* Calculates maxValue and returns corresponding value and index */
+	arm_max_q31(FFT->Output, FFT->FFT_Size, &FFT->MaxValue, &FFT->MaxIndex);
+	
+	/* Reset count */
+	FFT->Count = 0;
+}
+
+void TM_FFT_Free_Q31(TM_FFT_Q31_t* FFT) {
+	/* Return, malloc was not used for allocation */
+	if (!FFT->UseMalloc) {
+		return;
+	}
+	
+	/* Check input buffer */
+	if (FFT->Input) {
+		LIB_FREE_FUNC(FFT->Input);
+	}
+	
+	/* Check output buffer */
+	if (FFT->Output) {
+		LIB_FREE_FUNC(FFT->Output);
+	}
+}
+
+/* Gets index of FFT size in instance tables */
+static uint8_t TM_FFT_INT_SizeIndex(uint16_t FFT_Size) {
+	uint8_t i;
+	
+	/* Sizes from 16 to 4096 */
+	for (i = 0; i < 9; i++) {
+		if (FFT_Size == (16 << i)) {
+			return i;
+		}
+	}
+	return 0xFF;
+}
@@ -3,10 +3,10 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/07/hal-library-14-fast-fourier-transform-for-stm32fxxx/
- * @version v1.0
+ * @version v1.2
  * @ide     Keil uVision
  * @license MIT
- * @brief   FFT library for float 32 and Cortex-M4/7 little endian MCUs
+ * @brief   FFT library for float 32, Q15 and Q31 on Cortex-M0/M4/M7 little endian MCUs
  *	
 \verbatim
    ----------------------------------------------------------------------
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_FFT_H
-#define TM_FFT_H 100
+#define TM_FFT_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -105,12 +105,66 @@ extern "C" {
  * For example, if you have <b>512</b> length FFT size, then input buffer must be <b>2 * 512 = 1024</b> samples of float 32 and output buffer is 512 samples of float 32.
  * In common, this is <b>1536</b> samples of float32 which is 4-bytes long in memory.
  * Together this would be 6144 Bytes of HEAP memory.
+ *
+ * \par Real FFT
+ *
+ * When signal has only real part (ADC samples for example), use functions with <code>Real</code> in name and @ref TM_FFT_Real_F32_t structure.
+ * It uses real FFT from ARM MATH which calculates FFT of N real samples with N/2 complex FFT and one additional stage.
+ *
+ * Input buffer is <b>FFT_Size</b> samples long and output buffer is <b>FFT_Size</b> samples long.
+ * Output buffer holds packed spectrum:
+ *
+\verbatim
+ - Output[0]:              DC component, real value
+ - Output[1]:              Component at FFT_Size / 2 (fs / 2), real value
+ - Output[2 * k + 0]:      Real part of bin k, where k is between 1 and FFT_Size / 2 - 1
+ - Output[2 * k + 1]:      Imaginary part of bin k
+\endverbatim
+ *
+ * Input buffer is used by ARM MATH as working memory during calculation and its content is not valid after @ref TM_FFT_Process_Real_F32.
+ * Magnitude or power spectrum of <b>FFT_Size / 2</b> bins can be written back to input buffer with @ref TM_FFT_Magnitude_Real_F32 or @ref TM_FFT_Power_Real_F32.
+ *
+ * For 4096 samples, complex mode needs 12288 float samples of memory, real mode needs 8192 samples and 1 CFFT of half size.
+ *
+ * Supported sizes for real FFT are power of 2 between 32 and 4096.
+ * Size 8192 is supported when @ref FFT_RFFT_8192 is enabled.
+ * In this case, twiddle table for last stage is calculated in RAM on first initialization (32kB),
+ * if ARM MATH library itself does not have support for 8192 length.
+ *
+ * \par Fixed point FFT
+ *
+ * On STM32F0xx without FPU or when 16-bit precision is enough, use @ref TM_FFT_Q15_t or @ref TM_FFT_Q31_t structures
+ * with functions with <code>Q15</code> or <code>Q31</code> in name. API is the same as for float.
+ * Input buffer is <b>2 * FFT_Size</b> long (real and imaginary part), output buffer is <b>FFT_Size</b> long.
+ *
+ * Output is magnitude squared of each bin (no square root is calculated).
+ * ARM MATH scales data down by 2 in each stage of FFT to prevent overflow, so FFT result is divided by FFT_Size.
+ * <b>Shift</b> parameter in structure holds log2(FFT_Size), use @ref TM_FFT_GetShift macro.
+ * Magnitude squared is in 3.13 format for Q15 and in 3.29 format for Q31, so real magnitude squared is:
+ *
+\verbatim
+ - Q15: |X[k]|^2 = Output[k] / 2^13 * 2^(2 * Shift)
+ - Q31: |X[k]|^2 = Output[k] / 2^29 * 2^(2 * Shift)
+\endverbatim
+ *
+ * Because of scaling, Q15 loses 1 bit of dynamic range in each stage.
+ * For 1024 FFT, only 5 bits are left for small signals. Use Q31 when large FFT or high dynamic range is required.
+ *
+ * Example project <b>14-STM32Fxxx_FFT_BENCHMARK</b> measures cycles per transform for all sizes and types.
  * 
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added real FFT mode with packed output, magnitude and power spectrum
+
+ Version 1.2
+  - October 19, 2026
+  - Added Q15 and Q31 fixed point FFT with magnitude squared output
 \endverbatim
  *
  * \par Dependencies
@@ -145,6 +199,15 @@ extern "C" {
 #define LIB_FREE_FUNC     free
 #endif
 
+/**
+ * @brief  Enables real FFT with 8192 samples
+ * @note   When ARM MATH does not support 8192 real FFT, 32kB of RAM is used for twiddle table
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef FFT_RFFT_8192
+#define FFT_RFFT_8192     0
+#endif
+
 /**
  * @}
  */
@@ -169,6 +232,50 @@ typedef struct {
 	uint32_t MaxIndex;              /*!< Index in output array where max value happened */
 } TM_FFT_F32_t;
 
+/**
+ * @brief  FFT structure for 32-bit float real input signal
+ */
+typedef struct {
+	float32_t* Input;               /*!< Pointer to data input buffer. Its length must be FFT_Size */
+	float32_t* Output;              /*!< Pointer to packed spectrum output buffer. Its length must be FFT_Size */
+	uint16_t FFT_Size;              /*!< FFT size in units of samples. This parameter can be a value of 2^n where n is between 5 and 12 (13 with @ref FFT_RFFT_8192) */
+	uint8_t UseMalloc;              /*!< Set to 1 when malloc is used for memory allocation for buffers. Meant for private use */
+	uint16_t Count;                 /*!< Number of samples in buffer when using @ref TM_FFT_AddToBufferReal function. Meant for private use */
+	arm_rfft_fast_instance_f32 S;   /*!< ARM real FFT instance. Meant for private use */
+	float32_t MaxValue;             /*!< Max value in magnitude or power spectrum after calculation */
+	uint32_t MaxIndex;              /*!< Index of bin where max value happened */
+} TM_FFT_Real_F32_t;
+
+/**
+ * @brief  FFT structure for Q15 fixed point
+ */
+typedef struct {
+	q15_t* Input;                   /*!< Pointer to data input buffer. Its length must be 2 * FFT_Size */
+	q15_t* Output;                  /*!< Pointer to magnitude squared output buffer in 3.13 format. Its length must be FFT_Size */
+	uint16_t FFT_Size;              /*!< FFT size in units of samples. This parameter can be a value of 2^n where n is between 4 and 12 */
+	uint8_t UseMalloc;              /*!< Set to 1 when malloc is used for memory allocation for buffers. Meant for private use */
+	uint8_t Shift;                  /*!< Number of bits result is scaled down, log2(FFT_Size) */
+	uint16_t Count;                 /*!< Number of samples in buffer when using @ref TM_FFT_AddToBuffer_Q15 function. Meant for private use */
+	const arm_cfft_instance_q15* S; /*!< Pointer to @ref arm_cfft_instance_q15 structure. Meant for private use */
+	q15_t MaxValue;                 /*!< Max value in FTT result after calculation */
+	uint32_t MaxIndex;              /*!< Index in output array where max value happened */
+} TM_FFT_Q15_t;
+
+/**
+ * @brief  FFT structure for Q31 fixed point
+ */
+typedef struct {
+	q31_t* Input;                   /*!< Pointer to data input buffer. Its length must be 2 * FFT_Size */
+	q31_t* Output;                  /*!< Pointer to magnitude squared output buffer in 3.29 format. Its length must be FFT_Size */
+	uint16_t FFT_Size;              /*!< FFT size in units of samples. This parameter can be a value of 2^n where n is between 4 and 12 */
+	uint8_t UseMalloc;              /*!< Set to 1 when malloc is used for memory allocation for buffers. Meant for private use */
+	uint8_t Shift;                  /*!< Number of bits result is scaled down, log2(FFT_Size) */
+	uint16_t Count;                 /*!< Number of samples in buffer when using @ref TM_FFT_AddToBuffer_Q31 function. Meant for private use */
+	const arm_cfft_instance_q31* S; /*!< Pointer to @ref arm_cfft_instance_q31 structure. Meant for private use */
+	q31_t MaxValue;                 /*!< Max value in FTT result after calculation */
+	uint32_t MaxIndex;              /*!< Index in output array where max value happened */
+} TM_FFT_Q31_t;
+
 /**
  * @}
  */
@@ -241,6 +348,174 @@ void TM_FFT_Process_F32(TM_FFT_F32_t* FFT);
  */
 void TM_FFT_Free_F32(TM_FFT_F32_t* FFT);
 
+/**
+ * @brief  Initializes and prepares FFT structure for real signal operations
+ * @param  *FFT: Pointer to empty @ref TM_FFT_Real_F32_t structure for FFT
+ * @param  FFT_Size: Number of real samples to be used for FFT calculation
+ *            This parameter can be a value of 2^n where n is between 5 and 12, or 13 when @ref FFT_RFFT_8192 is enabled
+ * @param  use_malloc: Set parameter to 1, if you want to use HEAP memory and @ref malloc to allocate input and output buffers
+ * @retval Initialization status:
+ *            - 0: Initialized OK, ready to use
+ *            - 1: Input FFT SIZE is not valid
+ *            - 2: Malloc failed with allocating input data buffer
+ *            - 3: Malloc failed with allocating output data buffer. If input data buffer is allocated, it will be free if this is returned.
+ */
+uint8_t TM_FFT_Init_Real_F32(TM_FFT_Real_F32_t* FFT, uint16_t FFT_Size, uint8_t use_malloc);
+
+/**
+ * @brief  Sets input and output buffers for real FFT calculations
+ * @note   Use this function only if you set @arg use_malloc parameter to zero in @ref TM_FFT_Init_Real_F32 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t structure where buffers will be set
+ * @param  *InputBuffer: Pointer to buffer of type float32_t with FFT_Size length
+ * @param  *OutputBuffer: Pointer to buffer of type float32_t with FFT_Size length
+ * @retval None
+ */
+void TM_FFT_SetBuffers_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* InputBuffer, float32_t* OutputBuffer);
+
+/**
+ * @brief  Adds new real sample to input buffer in FFT array 
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t structure where new sample will be added
+ * @param  sampleValue: A new sample to be added to buffer
+ * @retval FFT calculation status:
+ *            - 0: Input buffer is not full yet
+ *            - > 0: Input buffer is full and samples are ready to be calculated
+ */
+uint8_t TM_FFT_AddToBufferReal(TM_FFT_Real_F32_t* FFT, float32_t sampleValue);
+
+/**
+ * @brief  Calculates real FFT from input buffer and saves packed spectrum to output buffer
+ * @note   Input buffer content is not valid after this function
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t where FFT calculation will happen
+ * @retval None
+ */
+void TM_FFT_Process_Real_F32(TM_FFT_Real_F32_t* FFT);
+
+/**
+ * @brief  Calculates magnitude of FFT_Size / 2 bins from packed spectrum and finds max value
+ * @note   Component at fs / 2 is not included, it is available at Output[1]
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t with calculated spectrum
+ * @param  *Dst: Pointer to FFT_Size / 2 long buffer. It can be FFT->Input or FFT->Output
+ * @retval None
+ */
+void TM_FFT_Magnitude_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* Dst);
+
+/**
+ * @brief  Calculates power (magnitude squared) of FFT_Size / 2 bins from packed spectrum and finds max value
+ * @note   It is faster than magnitude as no square root is used
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t with calculated spectrum
+ * @param  *Dst: Pointer to FFT_Size / 2 long buffer. It can be FFT->Input or FFT->Output
+ * @retval None
+ */
+void TM_FFT_Power_Real_F32(TM_FFT_Real_F32_t* FFT, float32_t* Dst);
+
+/**
+ * @brief  Free input and output buffers of real FFT
+ * @note   This function has sense only, if you used @ref malloc for memory allocation when you called @ref TM_FFT_Init_Real_F32 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Real_F32_t structure where buffers will be free
+ * @retval None
+ */
+void TM_FFT_Free_Real_F32(TM_FFT_Real_F32_t* FFT);
+
+/**
+ * @brief  Initializes and prepares Q15 FFT structure for signal operations
+ * @param  *FFT: Pointer to empty @ref TM_FFT_Q15_t structure for FFT
+ * @param  FFT_Size: Number of samples to be used for FFT calculation
+ *            This parameter can be a value of 2^n where n is between 4 and 12, so any power of 2 between 16 and 4096
+ * @param  use_malloc: Set parameter to 1, if you want to use HEAP memory and @ref malloc to allocate input and output buffers
+ * @retval Initialization status:
+ *            - 0: Initialized OK, ready to use
+ *            - 1: Input FFT SIZE is not valid
+ *            - 2: Malloc failed with allocating input data buffer
+ *            - 3: Malloc failed with allocating output data buffer. If input data buffer is allocated, it will be free if this is returned.
+ */
+uint8_t TM_FFT_Init_Q15(TM_FFT_Q15_t* FFT, uint16_t FFT_Size, uint8_t use_malloc);
+
+/**
+ * @brief  Sets input and output buffers for Q15 FFT calculations
+ * @note   Use this function only if you set @arg use_malloc parameter to zero in @ref TM_FFT_Init_Q15 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Q15_t structure where buffers will be set
+ * @param  *InputBuffer: Pointer to buffer of type q15_t with FFT_Size * 2 length
+ * @param  *OutputBuffer: Pointer to buffer of type q15_t with FFT_Size length
+ * @retval None
+ */
+void TM_FFT_SetBuffers_Q15(TM_FFT_Q15_t* FFT, q15_t* InputBuffer, q15_t* OutputBuffer);
+
+/**
+ * @brief  Adds new real sample to input buffer in Q15 FFT array 
+ * @param  *FFT: Pointer to @ref TM_FFT_Q15_t structure where new sample will be added
+ * @param  sampleValue: A new sample to be added to buffer, real part. Imaginary part will be set to 0
+ * @retval FFT calculation status:
+ *            - 0: Input buffer is not full yet
+ *            - > 0: Input buffer is full and samples are ready to be calculated
+ */
+uint8_t TM_FFT_AddToBuffer_Q15(TM_FFT_Q15_t* FFT, q15_t sampleValue);
+
+/**
+ * @brief  Processes and calculates Q15 FFT from InputBuffer and saves magnitude squared in 3.13 format to Output buffer
+ * @note   This function also calculates max value and max index in array where max value happens
+ * @param  *FFT: Pointer to @ref TM_FFT_Q15_t where FFT calculation will happen
+ * @retval None
+ */
+void TM_FFT_Process_Q15(TM_FFT_Q15_t* FFT);
+
+/**
+ * @brief  Free input and output buffers of Q15 FFT
+ * @note   This function has sense only, if you used @ref malloc for memory allocation when you called @ref TM_FFT_Init_Q15 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Q15_t structure where buffers will be free
+ * @retval None
+ */
+void TM_FFT_Free_Q15(TM_FFT_Q15_t* FFT);
+
+/**
+ * @brief  Initializes and prepares Q31 FFT structure for signal operations
+ * @param  *FFT: Pointer to empty @ref TM_FFT_Q31_t structure for FFT
+ * @param  FFT_Size: Number of samples to be used for FFT calculation
+ *            This parameter can be a value of 2^n where n is between 4 and 12, so any power of 2 between 16 and 4096
+ * @param  use_malloc: Set parameter to 1, if you want to use HEAP memory and @ref malloc to allocate input and output buffers
+ * @retval Initialization status:
+ *            - 0: Initialized OK, ready to use
+ *            - 1: Input FFT SIZE is not valid
+ *            - 2: Malloc failed with allocating input data buffer
+ *            - 3: Malloc failed with allocating output data buffer. If input data buffer is allocated, it will be free if this is returned.
+ */
+uint8_t TM_FFT_Init_Q31(TM_FFT_Q31_t* FFT, uint16_t FFT_Size, uint8_t use_malloc);
+
+/**
+ * @brief  Sets input and output buffers for Q31 FFT calculations
+ * @note   Use this function only if you set @arg use_malloc parameter to zero in @ref TM_FFT_Init_Q31 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Q31_t structure where buffers will be set
+ * @param  *InputBuffer: Pointer to buffer of type q31_t with FFT_Size * 2 length
+ * @param  *OutputBuffer: Pointer to buffer of type q31_t with FFT_Size length
+ * @retval None
+ */
+void TM_FFT_SetBuffers_Q31(TM_FFT_Q31_t* FFT, q31_t* InputBuffer, q31_t* OutputBuffer);
+
+/**
+ * @brief  Adds new real sample to input buffer in Q31 FFT array 
+ * @param  *FFT: Pointer to @ref TM_FFT_Q31_t structure where new sample will be added
+ * @param  sampleValue: A new sample to be added to buffer, real part. Imaginary part will be set to 0
+ * @retval FFT calculation status:
+ *            - 0: Input buffer is not full yet
+ *            - > 0: Input buffer is full and samples are ready to be calculated
+ */
+uint8_t TM_FFT_AddToBuffer_Q31(TM_FFT_Q31_t* FFT, q31_t sampleValue);
+
+/**
+ * @brief  Processes and calculates Q31 FFT from InputBuffer and saves magnitude squared in 3.29 format to Output buffer
+ * @note   This function also calculates max value and max index in array where max value happens
+ * @param  *FFT: Pointer to @ref TM_FFT_Q31_t where FFT calculation will happen
+ * @retval None
+ */
+void TM_FFT_Process_Q31(TM_FFT_Q31_t* FFT);
+
+/**
+ * @brief  Free input and output buffers of Q31 FFT
+ * @note   This function has sense only, if you used @ref malloc for memory allocation when you called @ref TM_FFT_Init_Q31 function
+ * @param  *FFT: Pointer to @ref TM_FFT_Q31_t structure where buffers will be free
+ * @retval None
+ */
+void TM_FFT_Free_Q31(TM_FFT_Q31_t* FFT);
+
 /**
  * @brief  Gets max value from already calculated FFT result
  * @param  FFT: Pointer to @ref TM_FFT_F32_t structure where max value should be checked
@@ -265,6 +540,14 @@ void TM_FFT_Free_F32(TM_FFT_F32_t* FFT);
  */
 #define TM_FFT_GetFFTSize(FFT)             ((FFT)->FFT_Size)
 
+/**
+ * @brief  Gets number of bits fixed point FFT result is scaled down
+ * @param  FFT: Pointer to @ref TM_FFT_Q15_t or @ref TM_FFT_Q31_t structure
+ * @retval Scaling in units of bits, log2(FFT_Size)
+ * @note   Defined as macro for faster execution
+ */
+#define TM_FFT_GetShift(FFT)               ((FFT)->Shift)
+
 /**
  * @brief  Gets FFT result value from output buffer at given index
  * @param  FFT: Pointer to @ref TM_FFT_F32_t structure where FFT output sample will be returned
@@ -28,86 +28,210 @@
 /* Private functions */
 static
 void TM_FILTER_FIR_F32_Free(TM_FILTER_FIR_F32_t* instance) {
-	/* Free state buffer */
-	if (instance->f->pState != NULL && instance->Flags.F.MallocStates) {
-		LIB_FREE_FUNC(instance->f->pState);
+	/* Check instance */
+	if (instance == NULL) {
+		return;
 	}
 	
-	/* Free arm instance */
-	if (instance->f != NULL) {
-		LIB_FREE_FUNC(instance->f);
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
 	}
 	
-	/* Free main instance */
-	if (instance != NULL) {
+	/* Free main instance, ARM instance is part of it */
+	if (instance->Flags.F.MallocInstance) {
 		LIB_FREE_FUNC(instance);
 	}
 }
 
 static
 void TM_FILTER_IIR_F32_Free(TM_FILTER_IIR_F32_t* instance) {
-	/* Free state buffer */
-	if (instance->f->pState != NULL && instance->Flags.F.MallocStates) {
-		LIB_FREE_FUNC(instance->f->pState);
+	/* Check instance */
+	if (instance == NULL) {
+		return;
 	}
 	
-	/* Free arm instance */
-	if (instance->f != NULL) {
-		LIB_FREE_FUNC(instance->f);
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
 	}
 	
-	/* Free main instance */
-	if (instance != NULL) {
+	/* Free main instance, ARM instance is part of it */
+	if (instance->Flags.F.MallocInstance) {
 		LIB_FREE_FUNC(instance);
 	}
 }
 
-TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Init(size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
-	TM_FILTER_FIR_F32_t* instance;
+static
+int32_t TM_FILTER_INT_DivFloor(int32_t value, int32_t div) {
+	int32_t q = value / div;
 	
-	/* Allocate memory for TM_FILTER_FIR_F32_t */
-	instance = (TM_FILTER_FIR_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_F32_t));
-	/* Check value */
-	if (instance == NULL) {
-		return NULL;
+	/* Round towards minus infinity, the same as arithmetic right shift */
+	if ((value % div) != 0 && value < 0) {
+		q--;
+	}
+	return q;
+}
+
+static
+void TM_FILTER_INT_FIR_BANK_F32_Process(TM_FILTER_FIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	uint16_t ch, k, channels = instance->Channels, taps = instance->NumTaps;
+	size_t history = (size_t)(taps - 1) * channels;
+	const float32_t *c0, *c1, *c2, *c3;
+	const float32_t* x;
+	float32_t* state = instance->States;
+	float32_t acc0, acc1, acc2, acc3;
+	size_t i;
+	
+	/* Copy new interleaved samples of all channels after history samples */
+	memcpy(&state[history], In, count * channels * sizeof(float32_t));
+	
+	/* Calculate outputs, sample by sample */
+	for (i = 0; i < count; i++) {
+		/* Process 4 channels at a time, each input sample is loaded once */
+		for (ch = 0; ch + 4 <= channels; ch += 4) {
+			c0 = &instance->Coeffs[ch * instance->CoeffsStride];
+			c1 = c0 + instance->CoeffsStride;
+			c2 = c1 + instance->CoeffsStride;
+			c3 = c2 + instance->CoeffsStride;
+			x = &state[i * channels + ch];
+			acc0 = acc1 = acc2 = acc3 = 0;
+			
+			/* Accumulate taps of all 4 channels */
+			for (k = 0; k < taps; k++) {
+				acc0 += c0[k] * x[0];
+				acc1 += c1[k] * x[1];
+				acc2 += c2[k] * x[2];
+				acc3 += c3[k] * x[3];
+				x += channels;
+			}
+			
+			/* Save outputs */
+			Out[i * channels + ch] = acc0;
+			Out[i * channels + ch + 1] = acc1;
+			Out[i * channels + ch + 2] = acc2;
+			Out[i * channels + ch + 3] = acc3;
+		}
+		
+		/* Process remaining channels */
+		for (; ch < channels; ch++) {
+			c0 = &instance->Coeffs[ch * instance->CoeffsStride];
+			x = &state[i * channels + ch];
+			acc0 = 0;
+			for (k = 0; k < taps; k++) {
+				acc0 += c0[k] * *x;
+				x += channels;
+			}
+			Out[i * channels + ch] = acc0;
+		}
 	}
 	
-	/* Reset structure */
-	memset(instance, 0, sizeof(TM_FILTER_FIR_F32_t));
+	/* Move last samples of all channels to the beginning for next call */
+	memmove(state, &state[count * channels], history * sizeof(float32_t));
+}
+
+static
+void TM_FILTER_INT_IIR_BANK_F32_Process(TM_FILTER_IIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	uint16_t ch, channels = instance->Channels;
+	uint8_t stage;
+	const float32_t* coeffs;
+	float32_t* state;
+	float32_t b0, b1, b2, a1, a2;
+	float32_t x0, x1, x2, y0, y1, y2;
+	float32_t* src;
+	size_t i;
 	
-	/* Save */
-	instance->BlockSize = block_size;
-	instance->StatesCount = coeff_size + block_size - 1;
+	/* Process each channel */
+	for (ch = 0; ch < channels; ch++) {
+		state = &instance->States[ch * 4 * instance->NumStages];
+		coeffs = &instance->Coeffs[ch * instance->CoeffsStride];
+		
+		/* First stage reads input, next stages work on output */
+		src = In;
+		for (stage = 0; stage < instance->NumStages; stage++) {
+			/* Load coefficients and states */
+			b0 = coeffs[0];
+			b1 = coeffs[1];
+			b2 = coeffs[2];
+			a1 = coeffs[3];
+			a2 = coeffs[4];
+			x1 = state[0];
+			x2 = state[1];
+			y1 = state[2];
+			y2 = state[3];
+			
+			/* Filter samples of this channel */
+			for (i = 0; i < count; i++) {
+				x0 = src[i * channels + ch];
+				y0 = b0 * x0 + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+				Out[i * channels + ch] = y0;
+				x2 = x1;
+				x1 = x0;
+				y2 = y1;
+				y1 = y0;
+			}
+			
+			/* Save states */
+			state[0] = x1;
+			state[1] = x2;
+			state[2] = y1;
+			state[3] = y2;
+			
+			/* Go to next stage */
+			coeffs += 5;
+			state += 4;
+			src = Out;
+		}
+	}
+}
+
+TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Init(size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_F32_t* instance;
+	uint8_t malloc_states = 0;
 	
-	/* Allocate memory for arm_fir_instance_f32 */
-	instance->f = (arm_fir_instance_f32 *) LIB_ALLOC_FUNC(sizeof(arm_fir_instance_f32));
+	/* Allocate memory for TM_FILTER_FIR_F32_t, ARM instance is part of it */
+	instance = (TM_FILTER_FIR_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_F32_t));
 	
 	/* Check value */
-	if (instance->f == NULL) {
-		TM_FILTER_FIR_F32_Free(instance);
+	if (instance == NULL) {
 		return NULL;
 	}
 	
-	/* Reset structure */
-	memset(instance->f, 0, sizeof(arm_fir_instance_f32));
-	
 	/* Allocate state buffer */
 	if (StateBuffer == NULL) {
 		/* Allocate memory for states */
-		instance->f->pState = (float32_t *) LIB_ALLOC_FUNC(instance->StatesCount * sizeof(float32_t));
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_F32_STATES(coeff_size, block_size) * sizeof(float32_t));
 		
 		/* Check value */
-		if (instance->f->pState == NULL) {
-			TM_FILTER_FIR_F32_Free(instance);
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
 			return NULL;
 		}
-		instance->Flags.F.MallocStates = 1;
-	} else {
-		instance->f->pState = StateBuffer;
+		malloc_states = 1;
 	}
 	
+	/* Initialize filter */
+	TM_FILTER_FIR_F32_InitStatic(instance, coeff_size, coeffs, StateBuffer, block_size);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_InitStatic(TM_FILTER_FIR_F32_t* instance, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_F32_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_FIR_F32_STATES(coeff_size, block_size);
+	instance->f = &instance->Instance;
+	
 	/* Call ARM FIR initialization */
-	arm_fir_init_f32(instance->f, coeff_size, (float32_t *)coeffs, instance->f->pState, block_size);
+	arm_fir_init_f32(&instance->Instance, coeff_size, (float32_t *)coeffs, StateBuffer, block_size);
 	
 	/* Return pointer */
 	return instance;
@@ -115,12 +239,12 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Init(size_t coeff_size, const float32_t*
 
 TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Process(TM_FILTER_FIR_F32_t* instance, float32_t* In, float32_t* Out) {
 	/* Check input values */
-	if (instance == NULL || In == NULL || Out == NULL || instance->f == NULL) {
+	if (instance == NULL || In == NULL || Out == NULL) {
 		return NULL;
 	}
 		
 	/* Call ARM FIR function */
-	arm_fir_f32(instance->f, In, Out, instance->BlockSize);
+	arm_fir_f32(&instance->Instance, In, Out, instance->BlockSize);
 	
 	/* Return instance value */
 	return instance;
@@ -130,7 +254,7 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_ProcessAll(TM_FILTER_FIR_F32_t* instance,
 	uint32_t blocks;
 	
 	/* Check input values */
-	if (instance == NULL || In == NULL || Out == NULL || instance->f == NULL) {
+	if (instance == NULL || In == NULL || Out == NULL) {
 		return NULL;
 	}
 	
@@ -139,7 +263,7 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_ProcessAll(TM_FILTER_FIR_F32_t* instance,
 	
 	while (blocks-- > 0U) {
 		/* Call ARM FIR function */
-		arm_fir_f32(instance->f, In, Out, instance->BlockSize);
+		arm_fir_f32(&instance->Instance, In, Out, instance->BlockSize);
 		
 		/* Increase pointers */
 		In += instance->BlockSize;
@@ -151,7 +275,7 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_ProcessAll(TM_FILTER_FIR_F32_t* instance,
 	
 	while (blocks-- > 0U) {
 		/* Call ARM FIR function */
-		arm_fir_f32(instance->f, In, Out, 1);
+		arm_fir_f32(&instance->Instance, In, Out, 1);
 		
 		/* Increase pointers */
 		In++;
@@ -169,7 +293,7 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Clear(TM_FILTER_FIR_F32_t* instance) {
 	}
 	
 	/* Set all to 0 */
-	memset(instance->f->pState, 0, instance->StatesCount * sizeof(float32_t));
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(float32_t));
 	
 	/* Return instance */
 	return instance;
@@ -182,8 +306,9 @@ void TM_FILTER_FIR_F32_DeInit(TM_FILTER_FIR_F32_t* instance) {
 
 TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Init(size_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
 	TM_FILTER_IIR_F32_t* instance;
+	uint8_t malloc_states = 0;
 	
-	/* Allocate memory for TM_FILTER_IIR_F32_t */
+	/* Allocate memory for TM_FILTER_IIR_F32_t, ARM instance is part of it */
 	instance = (TM_FILTER_IIR_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_IIR_F32_t));
 	
 	/* Check value */
@@ -191,41 +316,40 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Init(size_t numStages, const float32_t* c
 		return NULL;
 	}
 	
-	/* Reset structure */
-	memset(instance, 0, sizeof(TM_FILTER_IIR_F32_t));
-	
-	/* Save block size */
-	instance->BlockSize = block_size;
-	
-	/* Allocate memory for arm_fir_instance_f32 */
-	instance->f = (arm_biquad_casd_df1_inst_f32 *) LIB_ALLOC_FUNC(sizeof(arm_biquad_casd_df1_inst_f32));
-	
-	/* Check value */
-	if (instance->f == NULL) {
-		TM_FILTER_IIR_F32_Free(instance);
-		return NULL;
-	}
-	
-	/* Reset structure */
-	memset(instance->f, 0, sizeof(arm_biquad_casd_df1_inst_f32));
-	
 	/* Allocate states buffer */
 	if (StateBuffer == NULL) {
 		/* Allocate memory for states */
-		instance->f->pState = (float32_t *) LIB_ALLOC_FUNC((4 * numStages) * sizeof(float32_t));
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_IIR_F32_STATES(numStages) * sizeof(float32_t));
 		
 		/* Check value */
-		if (instance->f->pState == NULL) {
-			TM_FILTER_IIR_F32_Free(instance);
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
 			return NULL;
 		}
-		instance->Flags.F.MallocStates = 1;
-	} else {
-		instance->f->pState = StateBuffer;
+		malloc_states = 1;
 	}
 	
-	/* Call ARM FIR initialization */
-	arm_biquad_cascade_df1_init_f32(instance->f, numStages, (float32_t *)coeffs, instance->f->pState);
+	/* Initialize filter */
+	TM_FILTER_IIR_F32_InitStatic(instance, numStages, coeffs, StateBuffer, block_size);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_InitStatic(TM_FILTER_IIR_F32_t* instance, size_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_IIR_F32_t));
+	
+	/* Save block size */
+	instance->BlockSize = block_size;
+	instance->f = &instance->Instance;
+	
+	/* Call ARM biquad initialization */
+	arm_biquad_cascade_df1_init_f32(&instance->Instance, numStages, (float32_t *)coeffs, StateBuffer);
 	
 	/* Return pointer */
 	return instance;
@@ -233,12 +357,12 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Init(size_t numStages, const float32_t* c
 
 TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Process(TM_FILTER_IIR_F32_t* instance, float32_t* In, float32_t* Out) {
 	/* Check if OK */
-	if (instance == NULL || In == NULL || Out == NULL || instance->f == NULL) {
+	if (instance == NULL || In == NULL || Out == NULL) {
 		return NULL;
 	}
 	
 	/* Call ARM FIR function */
-	arm_biquad_cascade_df1_f32(instance->f, In, Out, instance->BlockSize);
+	arm_biquad_cascade_df1_f32(&instance->Instance, In, Out, instance->BlockSize);
 	
 	/* Return instance value */
 	return instance;
@@ -248,7 +372,7 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_ProcessAll(TM_FILTER_IIR_F32_t* instance,
 	uint32_t blocks = 0;
 	
 	/* Check if OK */
-	if (instance == NULL || In == NULL || Out == NULL || instance->f == NULL) {
+	if (instance == NULL || In == NULL || Out == NULL) {
 		return NULL;
 	}
 	
@@ -257,7 +381,7 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_ProcessAll(TM_FILTER_IIR_F32_t* instance,
 	
 	while (blocks-- > 0U) {
 		/* Call ARM FIR function */
-		arm_biquad_cascade_df1_f32(instance->f, In, Out, instance->BlockSize);
+		arm_biquad_cascade_df1_f32(&instance->Instance, In, Out, instance->BlockSize);
 		
 		/* Increase pointers */
 		In += instance->BlockSize;
@@ -269,7 +393,7 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_ProcessAll(TM_FILTER_IIR_F32_t* instance,
 	
 	while (blocks-- > 0U) {
 		/* Call ARM FIR function */
-		arm_biquad_cascade_df1_f32(instance->f, In, Out, 1);
+		arm_biquad_cascade_df1_f32(&instance->Instance, In, Out, 1);
 		
 		/* Increase pointers */
 		In++;
@@ -287,7 +411,7 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Clear(TM_FILTER_IIR_F32_t* instance) {
 	}
 	
 	/* Set all to 0 */
-	memset(instance->f->pState, 0, 4 * instance->f->numStages * sizeof(float32_t));
+	memset(instance->Instance.pState, 0, TM_FILTER_IIR_F32_STATES(instance->Instance.numStages) * sizeof(float32_t));
 	
 	/* Return instance */
 	return instance;
@@ -297,3 +421,1668 @@ void TM_FILTER_IIR_F32_DeInit(TM_FILTER_IIR_F32_t* instance) {
 	/* Free allocated memory for filter */
 	TM_FILTER_IIR_F32_Free(instance);
 }
+
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Init(uint8_t M, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_DECIMATE_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_FIR_DECIMATE_F32_t */
+	instance = (TM_FILTER_FIR_DECIMATE_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_DECIMATE_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_DECIMATE_F32_STATES(coeff_size, block_size) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_FIR_DECIMATE_F32_InitStatic(instance, M, coeff_size, coeffs, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_InitStatic(TM_FILTER_FIR_DECIMATE_F32_t* instance, uint8_t M, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_DECIMATE_F32_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_FIR_DECIMATE_F32_STATES(coeff_size, block_size);
+	
+	/* Call ARM initialization and check parameters */
+	if (arm_fir_decimate_init_f32(&instance->Instance, coeff_size, M, (float32_t *)coeffs, StateBuffer, block_size) != ARM_MATH_SUCCESS) {
+		return NULL;
+	}
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Process(TM_FILTER_FIR_DECIMATE_F32_t* instance, float32_t* In, float32_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_fir_decimate_f32(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_ProcessAll(TM_FILTER_FIR_DECIMATE_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values, count must be multiple of M */
+	if (instance == NULL || In == NULL || Out == NULL || (count % instance->Instance.M) != 0) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_fir_decimate_f32(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize / instance->Instance.M;
+	}
+	
+	/* Process remaining samples, multiple of M */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_fir_decimate_f32(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Clear(TM_FILTER_FIR_DECIMATE_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(float32_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_FIR_DECIMATE_F32_DeInit(TM_FILTER_FIR_DECIMATE_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Init(uint8_t M, size_t coeff_size, const q15_t* coeffs, q15_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_DECIMATE_Q15_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_FIR_DECIMATE_Q15_t */
+	instance = (TM_FILTER_FIR_DECIMATE_Q15_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_DECIMATE_Q15_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (q15_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_DECIMATE_Q15_STATES(coeff_size, block_size) * sizeof(q15_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_FIR_DECIMATE_Q15_InitStatic(instance, M, coeff_size, coeffs, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_InitStatic(TM_FILTER_FIR_DECIMATE_Q15_t* instance, uint8_t M, size_t coeff_size, const q15_t* coeffs, q15_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_DECIMATE_Q15_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_FIR_DECIMATE_Q15_STATES(coeff_size, block_size);
+	
+	/* Call ARM initialization and check parameters */
+	if (arm_fir_decimate_init_q15(&instance->Instance, coeff_size, M, (q15_t *)coeffs, StateBuffer, block_size) != ARM_MATH_SUCCESS) {
+		return NULL;
+	}
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Process(TM_FILTER_FIR_DECIMATE_Q15_t* instance, q15_t* In, q15_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_fir_decimate_q15(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_ProcessAll(TM_FILTER_FIR_DECIMATE_Q15_t* instance, q15_t* In, q15_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values, count must be multiple of M */
+	if (instance == NULL || In == NULL || Out == NULL || (count % instance->Instance.M) != 0) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_fir_decimate_q15(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize / instance->Instance.M;
+	}
+	
+	/* Process remaining samples, multiple of M */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_fir_decimate_q15(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Clear(TM_FILTER_FIR_DECIMATE_Q15_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(q15_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_FIR_DECIMATE_Q15_DeInit(TM_FILTER_FIR_DECIMATE_Q15_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Init(uint8_t L, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_INTERPOLATE_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_FIR_INTERPOLATE_F32_t */
+	instance = (TM_FILTER_FIR_INTERPOLATE_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_INTERPOLATE_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_INTERPOLATE_F32_STATES(L, coeff_size, block_size) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_FIR_INTERPOLATE_F32_InitStatic(instance, L, coeff_size, coeffs, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_InitStatic(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, uint8_t L, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_INTERPOLATE_F32_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_FIR_INTERPOLATE_F32_STATES(L, coeff_size, block_size);
+	
+	/* Call ARM initialization and check parameters */
+	if (arm_fir_interpolate_init_f32(&instance->Instance, L, coeff_size, (float32_t *)coeffs, StateBuffer, block_size) != ARM_MATH_SUCCESS) {
+		return NULL;
+	}
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Process(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, float32_t* In, float32_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_fir_interpolate_f32(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_ProcessAll(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_fir_interpolate_f32(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize * instance->Instance.L;
+	}
+	
+	/* Process remaining samples */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_fir_interpolate_f32(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Clear(TM_FILTER_FIR_INTERPOLATE_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(float32_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_FIR_INTERPOLATE_F32_DeInit(TM_FILTER_FIR_INTERPOLATE_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Init(uint8_t numStages, const q15_t* coeffs, int8_t postShift, q15_t* StateBuffer, size_t block_size) {
+	TM_FILTER_IIR_Q15_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_IIR_Q15_t */
+	instance = (TM_FILTER_IIR_Q15_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_IIR_Q15_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (q15_t *) LIB_ALLOC_FUNC(TM_FILTER_IIR_Q15_STATES(numStages) * sizeof(q15_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_IIR_Q15_InitStatic(instance, numStages, coeffs, postShift, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_InitStatic(TM_FILTER_IIR_Q15_t* instance, uint8_t numStages, const q15_t* coeffs, int8_t postShift, q15_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_IIR_Q15_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_IIR_Q15_STATES(numStages);
+	
+	/* Call ARM initialization */
+	arm_biquad_cascade_df1_init_q15(&instance->Instance, numStages, (q15_t *)coeffs, StateBuffer, postShift);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Process(TM_FILTER_IIR_Q15_t* instance, q15_t* In, q15_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_biquad_cascade_df1_q15(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_ProcessAll(TM_FILTER_IIR_Q15_t* instance, q15_t* In, q15_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_biquad_cascade_df1_q15(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize;
+	}
+	
+	/* Process remaining samples */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_biquad_cascade_df1_q15(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Clear(TM_FILTER_IIR_Q15_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(q15_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_IIR_Q15_DeInit(TM_FILTER_IIR_Q15_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Init(uint8_t numStages, const q31_t* coeffs, int8_t postShift, q31_t* StateBuffer, size_t block_size) {
+	TM_FILTER_IIR_Q31_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_IIR_Q31_t */
+	instance = (TM_FILTER_IIR_Q31_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_IIR_Q31_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (q31_t *) LIB_ALLOC_FUNC(TM_FILTER_IIR_Q31_STATES(numStages) * sizeof(q31_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_IIR_Q31_InitStatic(instance, numStages, coeffs, postShift, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_InitStatic(TM_FILTER_IIR_Q31_t* instance, uint8_t numStages, const q31_t* coeffs, int8_t postShift, q31_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_IIR_Q31_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_IIR_Q31_STATES(numStages);
+	
+	/* Call ARM initialization */
+	arm_biquad_cascade_df1_init_q31(&instance->Instance, numStages, (q31_t *)coeffs, StateBuffer, postShift);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Process(TM_FILTER_IIR_Q31_t* instance, q31_t* In, q31_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_biquad_cascade_df1_q31(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_ProcessAll(TM_FILTER_IIR_Q31_t* instance, q31_t* In, q31_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_biquad_cascade_df1_q31(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize;
+	}
+	
+	/* Process remaining samples */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_biquad_cascade_df1_q31(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Clear(TM_FILTER_IIR_Q31_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(q31_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_IIR_Q31_DeInit(TM_FILTER_IIR_Q31_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Init(uint16_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_LATTICE_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_FIR_LATTICE_F32_t */
+	instance = (TM_FILTER_FIR_LATTICE_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_LATTICE_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_LATTICE_F32_STATES(numStages) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	if (TM_FILTER_FIR_LATTICE_F32_InitStatic(instance, numStages, coeffs, StateBuffer, block_size) == NULL) {
+		if (malloc_states) {
+			LIB_FREE_FUNC(StateBuffer);
+		}
+		LIB_FREE_FUNC(instance);
+		return NULL;
+	}
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_InitStatic(TM_FILTER_FIR_LATTICE_F32_t* instance, uint16_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_LATTICE_F32_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_FIR_LATTICE_F32_STATES(numStages);
+	
+	/* Call ARM initialization */
+	arm_fir_lattice_init_f32(&instance->Instance, numStages, (float32_t *)coeffs, StateBuffer);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Process(TM_FILTER_FIR_LATTICE_F32_t* instance, float32_t* In, float32_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_fir_lattice_f32(&instance->Instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_ProcessAll(TM_FILTER_FIR_LATTICE_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	uint32_t blocks;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_fir_lattice_f32(&instance->Instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Out += instance->BlockSize;
+	}
+	
+	/* Process remaining samples */
+	blocks = count % instance->BlockSize;
+	if (blocks > 0U) {
+		arm_fir_lattice_f32(&instance->Instance, In, Out, blocks);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Clear(TM_FILTER_FIR_LATTICE_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(float32_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_FIR_LATTICE_F32_DeInit(TM_FILTER_FIR_LATTICE_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Init(size_t coeff_size, float32_t* coeffs, float32_t mu, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_LMS_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_LMS_F32_t */
+	instance = (TM_FILTER_LMS_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_LMS_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_LMS_F32_STATES(coeff_size, block_size) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter */
+	TM_FILTER_LMS_F32_InitStatic(instance, coeff_size, coeffs, mu, StateBuffer, block_size);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_InitStatic(TM_FILTER_LMS_F32_t* instance, size_t coeff_size, float32_t* coeffs, float32_t mu, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_LMS_F32_t));
+	
+	/* Save */
+	instance->BlockSize = block_size;
+	instance->StatesCount = TM_FILTER_LMS_F32_STATES(coeff_size, block_size);
+	
+	/* Call ARM initialization */
+	arm_lms_norm_init_f32(&instance->Instance, coeff_size, coeffs, StateBuffer, mu, block_size);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Process(TM_FILTER_LMS_F32_t* instance, float32_t* In, float32_t* Ref, float32_t* Out, float32_t* Err) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Ref == NULL || Out == NULL || Err == NULL) {
+		return NULL;
+	}
+	
+	/* Call ARM function */
+	arm_lms_norm_f32(&instance->Instance, In, Ref, Out, Err, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_ProcessAll(TM_FILTER_LMS_F32_t* instance, float32_t* In, float32_t* Ref, float32_t* Out, float32_t* Err, size_t count) {
+	uint32_t blocks, remaining;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Ref == NULL || Out == NULL || Err == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	remaining = count % instance->BlockSize;
+	
+	while (blocks-- > 0U) {
+		/* Call ARM function */
+		arm_lms_norm_f32(&instance->Instance, In, Ref, Out, Err, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += instance->BlockSize;
+		Ref += instance->BlockSize;
+		Out += instance->BlockSize;
+		Err += instance->BlockSize;
+	}
+	
+	/* Process remaining samples */
+	if (remaining) {
+		arm_lms_norm_f32(&instance->Instance, In, Ref, Out, Err, remaining);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Clear(TM_FILTER_LMS_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->Instance.pState, 0, instance->StatesCount * sizeof(float32_t));
+	
+	/* Reset input energy */
+	instance->Instance.energy = 0;
+	instance->Instance.x0 = 0;
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_LMS_F32_DeInit(TM_FILTER_LMS_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->Instance.pState != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->Instance.pState);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Init(uint16_t channels, size_t coeff_size, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_FIR_BANK_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_FIR_BANK_F32_t */
+	instance = (TM_FILTER_FIR_BANK_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_FIR_BANK_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer for all channels */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_FIR_BANK_F32_STATES(channels, coeff_size, block_size) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter bank */
+	TM_FILTER_FIR_BANK_F32_InitStatic(instance, channels, coeff_size, coeffs, per_channel, StateBuffer, block_size);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_InitStatic(TM_FILTER_FIR_BANK_F32_t* instance, uint16_t channels, size_t coeff_size, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_FIR_BANK_F32_t));
+	
+	/* Save */
+	instance->Coeffs = coeffs;
+	instance->CoeffsStride = per_channel ? (coeff_size) : 0;
+	instance->States = StateBuffer;
+	instance->Channels = channels;
+	instance->NumTaps = coeff_size;
+	instance->BlockSize = block_size;
+	
+	/* Clear states */
+	TM_FILTER_FIR_BANK_F32_Clear(instance);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Process(TM_FILTER_FIR_BANK_F32_t* instance, float32_t* In, float32_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Process all channels */
+	TM_FILTER_INT_FIR_BANK_F32_Process(instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_ProcessAll(TM_FILTER_FIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	size_t blocks, remaining, step;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	remaining = count % instance->BlockSize;
+	step = instance->BlockSize * instance->Channels;
+	
+	while (blocks-- > 0U) {
+		/* Process all channels */
+		TM_FILTER_INT_FIR_BANK_F32_Process(instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += step;
+		Out += step;
+	}
+	
+	/* Process remaining samples */
+	if (remaining) {
+		TM_FILTER_INT_FIR_BANK_F32_Process(instance, In, Out, remaining);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Clear(TM_FILTER_FIR_BANK_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->States, 0, TM_FILTER_FIR_BANK_F32_STATES(instance->Channels, instance->NumTaps, instance->BlockSize) * sizeof(float32_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_FIR_BANK_F32_DeInit(TM_FILTER_FIR_BANK_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->States != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->States);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Init(uint16_t channels, uint8_t numStages, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size) {
+	TM_FILTER_IIR_BANK_F32_t* instance;
+	uint8_t malloc_states = 0;
+	
+	/* Allocate memory for TM_FILTER_IIR_BANK_F32_t */
+	instance = (TM_FILTER_IIR_BANK_F32_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_IIR_BANK_F32_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate state buffer for all channels */
+	if (StateBuffer == NULL) {
+		StateBuffer = (float32_t *) LIB_ALLOC_FUNC(TM_FILTER_IIR_BANK_F32_STATES(channels, numStages) * sizeof(float32_t));
+		
+		/* Check value */
+		if (StateBuffer == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_states = 1;
+	}
+	
+	/* Initialize filter bank */
+	TM_FILTER_IIR_BANK_F32_InitStatic(instance, channels, numStages, coeffs, per_channel, StateBuffer, block_size);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocStates = malloc_states;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_InitStatic(TM_FILTER_IIR_BANK_F32_t* instance, uint16_t channels, uint8_t numStages, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_IIR_BANK_F32_t));
+	
+	/* Save */
+	instance->Coeffs = coeffs;
+	instance->CoeffsStride = per_channel ? (5 * numStages) : 0;
+	instance->States = StateBuffer;
+	instance->Channels = channels;
+	instance->NumStages = numStages;
+	instance->BlockSize = block_size;
+	
+	/* Clear states */
+	TM_FILTER_IIR_BANK_F32_Clear(instance);
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Process(TM_FILTER_IIR_BANK_F32_t* instance, float32_t* In, float32_t* Out) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Process all channels */
+	TM_FILTER_INT_IIR_BANK_F32_Process(instance, In, Out, instance->BlockSize);
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_ProcessAll(TM_FILTER_IIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count) {
+	size_t blocks, remaining, step;
+	
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Get number of blocks to process */
+	blocks = count / instance->BlockSize;
+	remaining = count % instance->BlockSize;
+	step = instance->BlockSize * instance->Channels;
+	
+	while (blocks-- > 0U) {
+		/* Process all channels */
+		TM_FILTER_INT_IIR_BANK_F32_Process(instance, In, Out, instance->BlockSize);
+		
+		/* Increase pointers */
+		In += step;
+		Out += step;
+	}
+	
+	/* Process remaining samples */
+	if (remaining) {
+		TM_FILTER_INT_IIR_BANK_F32_Process(instance, In, Out, remaining);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Clear(TM_FILTER_IIR_BANK_F32_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Set all to 0 */
+	memset(instance->States, 0, TM_FILTER_IIR_BANK_F32_STATES(instance->Channels, instance->NumStages) * sizeof(float32_t));
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_IIR_BANK_F32_DeInit(TM_FILTER_IIR_BANK_F32_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free state buffer */
+	if (instance->States != NULL && instance->Flags.F.MallocStates) {
+		LIB_FREE_FUNC(instance->States);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+static
+void TM_FILTER_INT_MEDIAN_Exchange(TM_FILTER_MEDIAN_t* instance, int16_t i, int16_t j) {
+	int16_t t = instance->Heap[i];
+	
+	/* Swap heap entries and update their positions */
+	instance->Heap[i] = instance->Heap[j];
+	instance->Heap[j] = t;
+	instance->Pos[instance->Heap[i]] = i;
+	instance->Pos[instance->Heap[j]] = j;
+}
+
+static
+uint8_t TM_FILTER_INT_MEDIAN_Less(TM_FILTER_MEDIAN_t* instance, int16_t i, int16_t j) {
+	/* Compare samples at heap positions */
+	return instance->Samples[instance->Heap[i]] < instance->Samples[instance->Heap[j]];
+}
+
+static
+uint8_t TM_FILTER_INT_MEDIAN_CmpExch(TM_FILTER_MEDIAN_t* instance, int16_t i, int16_t j) {
+	/* Swap when sample at i is less than sample at j */
+	if (TM_FILTER_INT_MEDIAN_Less(instance, i, j)) {
+		TM_FILTER_INT_MEDIAN_Exchange(instance, i, j);
+		return 1;
+	}
+	return 0;
+}
+
+/* Number of samples in min heap and max heap */
+#define MEDIAN_MIN_COUNT(m)     (((m)->Count - 1) / 2)
+#define MEDIAN_MAX_COUNT(m)     ((m)->Count / 2)
+
+static
+void TM_FILTER_INT_MEDIAN_MinSortDown(TM_FILTER_MEDIAN_t* instance, int16_t i) {
+	for (; i <= MEDIAN_MIN_COUNT(instance); i *= 2) {
+		/* Select smaller child */
+		if (i > 1 && i < MEDIAN_MIN_COUNT(instance) && TM_FILTER_INT_MEDIAN_Less(instance, i + 1, i)) {
+			i++;
+		}
+		if (!TM_FILTER_INT_MEDIAN_CmpExch(instance, i, i / 2)) {
+			break;
+		}
+	}
+}
+
+static
+void TM_FILTER_INT_MEDIAN_MaxSortDown(TM_FILTER_MEDIAN_t* instance, int16_t i) {
+	for (; i >= -MEDIAN_MAX_COUNT(instance); i *= 2) {
+		/* Select bigger child */
+		if (i < -1 && i > -MEDIAN_MAX_COUNT(instance) && TM_FILTER_INT_MEDIAN_Less(instance, i, i - 1)) {
+			i--;
+		}
+		if (!TM_FILTER_INT_MEDIAN_CmpExch(instance, i / 2, i)) {
+			break;
+		}
+	}
+}
+
+static
+uint8_t TM_FILTER_INT_MEDIAN_MinSortUp(TM_FILTER_MEDIAN_t* instance, int16_t i) {
+	while (i > 0 && TM_FILTER_INT_MEDIAN_CmpExch(instance, i, i / 2)) {
+		i /= 2;
+	}
+	
+	/* Return 1 if sample became new median */
+	return i == 0;
+}
+
+static
+uint8_t TM_FILTER_INT_MEDIAN_MaxSortUp(TM_FILTER_MEDIAN_t* instance, int16_t i) {
+	while (i < 0 && TM_FILTER_INT_MEDIAN_CmpExch(instance, i / 2, i)) {
+		i /= 2;
+	}
+	
+	/* Return 1 if sample became new median */
+	return i == 0;
+}
+
+TM_FILTER_MA_t* TM_FILTER_MA_Init(uint16_t size, int32_t* Samples) {
+	TM_FILTER_MA_t* instance;
+	uint8_t malloc_samples = 0;
+	
+	/* Allocate memory for TM_FILTER_MA_t */
+	instance = (TM_FILTER_MA_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_MA_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate sample buffer */
+	if (Samples == NULL) {
+		Samples = (int32_t *) LIB_ALLOC_FUNC(size * sizeof(int32_t));
+		
+		/* Check value */
+		if (Samples == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		malloc_samples = 1;
+	}
+	
+	/* Initialize filter */
+	TM_FILTER_MA_InitStatic(instance, size, Samples);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocSamples = malloc_samples;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_MA_t* TM_FILTER_MA_InitStatic(TM_FILTER_MA_t* instance, uint16_t size, int32_t* Samples) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_MA_t));
+	
+	/* Save */
+	instance->Samples = Samples;
+	instance->Size = size;
+	
+	/* Use shift instead of division when possible */
+	instance->Shift = 0xFF;
+	if (size && (size & (size - 1)) == 0) {
+		instance->Shift = 0;
+		while ((1UL << instance->Shift) < size) {
+			instance->Shift++;
+		}
+	}
+	
+	/* Return pointer */
+	return instance;
+}
+
+int32_t TM_FILTER_MA_Put(TM_FILTER_MA_t* instance, int32_t sample) {
+	/* Remove oldest sample from sum when window is full */
+	if (instance->Count == instance->Size) {
+		instance->Sum -= instance->Samples[instance->Index];
+	} else {
+		instance->Count++;
+	}
+	
+	/* Add new sample */
+	instance->Samples[instance->Index] = sample;
+	instance->Sum += sample;
+	if (++instance->Index >= instance->Size) {
+		instance->Index = 0;
+	}
+	
+	/* Calculate average */
+	if (instance->Count == instance->Size && instance->Shift != 0xFF) {
+		instance->Output = instance->Sum >> instance->Shift;
+	} else {
+		instance->Output = TM_FILTER_INT_DivFloor(instance->Sum, (int32_t)instance->Count);
+	}
+	
+	/* Return average */
+	return instance->Output;
+}
+
+TM_FILTER_MA_t* TM_FILTER_MA_Process(TM_FILTER_MA_t* instance, const int32_t* In, int32_t* Out, size_t count) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Process all samples */
+	while (count--) {
+		*Out++ = TM_FILTER_MA_Put(instance, *In++);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_MA_t* TM_FILTER_MA_Clear(TM_FILTER_MA_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Reset window */
+	instance->Index = 0;
+	instance->Count = 0;
+	instance->Sum = 0;
+	instance->Output = 0;
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_MA_DeInit(TM_FILTER_MA_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free sample buffer */
+	if (instance->Samples != NULL && instance->Flags.F.MallocSamples) {
+		LIB_FREE_FUNC(instance->Samples);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Init(uint16_t size, int32_t* Samples, int16_t* Indexes) {
+	TM_FILTER_MEDIAN_t* instance;
+	uint8_t malloc_samples = 0;
+	
+	/* Allocate memory for TM_FILTER_MEDIAN_t */
+	instance = (TM_FILTER_MEDIAN_t *) LIB_ALLOC_FUNC(sizeof(TM_FILTER_MEDIAN_t));
+	
+	/* Check value */
+	if (instance == NULL) {
+		return NULL;
+	}
+	
+	/* Allocate samples and indexes in one block */
+	if (Samples == NULL) {
+		Samples = (int32_t *) LIB_ALLOC_FUNC(size * sizeof(int32_t) + TM_FILTER_MEDIAN_INDEXES(size) * sizeof(int16_t));
+		
+		/* Check value */
+		if (Samples == NULL) {
+			LIB_FREE_FUNC(instance);
+			return NULL;
+		}
+		Indexes = (int16_t *)&Samples[size];
+		malloc_samples = 1;
+	}
+	
+	/* Initialize filter */
+	TM_FILTER_MEDIAN_InitStatic(instance, size, Samples, Indexes);
+	
+	/* Save allocation flags */
+	instance->Flags.F.MallocSamples = malloc_samples;
+	instance->Flags.F.MallocInstance = 1;
+	
+	/* Return pointer */
+	return instance;
+}
+
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_InitStatic(TM_FILTER_MEDIAN_t* instance, uint16_t size, int32_t* Samples, int16_t* Indexes) {
+	/* Reset structure */
+	memset(instance, 0, sizeof(TM_FILTER_MEDIAN_t));
+	
+	/* Save, heap pointer is in the middle so it can be indexed with negative values */
+	instance->Samples = Samples;
+	instance->Pos = Indexes;
+	instance->Heap = &Indexes[size + size / 2];
+	instance->Size = size;
+	
+	/* Set initial heap positions */
+	TM_FILTER_MEDIAN_Clear(instance);
+	
+	/* Return pointer */
+	return instance;
+}
+
+int32_t TM_FILTER_MEDIAN_Put(TM_FILTER_MEDIAN_t* instance, int32_t sample) {
+	uint8_t is_new = instance->Count < instance->Size;
+	int16_t p = instance->Pos[instance->Index];
+	int32_t old = instance->Samples[instance->Index];
+	
+	/* Replace oldest sample with new one */
+	instance->Samples[instance->Index] = sample;
+	if (++instance->Index >= instance->Size) {
+		instance->Index = 0;
+	}
+	instance->Count += is_new;
+	
+	/* Move new sample to correct heap position */
+	if (p > 0) {
+		/* Sample is in min heap */
+		if (!is_new && old < sample) {
+			TM_FILTER_INT_MEDIAN_MinSortDown(instance, p * 2);
+		} else if (TM_FILTER_INT_MEDIAN_MinSortUp(instance, p)) {
+			TM_FILTER_INT_MEDIAN_MaxSortDown(instance, -1);
+		}
+	} else if (p < 0) {
+		/* Sample is in max heap */
+		if (!is_new && sample < old) {
+			TM_FILTER_INT_MEDIAN_MaxSortDown(instance, p * 2);
+		} else if (TM_FILTER_INT_MEDIAN_MaxSortUp(instance, p)) {
+			TM_FILTER_INT_MEDIAN_MinSortDown(instance, 1);
+		}
+	} else {
+		/* Sample is median */
+		if (MEDIAN_MAX_COUNT(instance)) {
+			TM_FILTER_INT_MEDIAN_MaxSortDown(instance, -1);
+		}
+		if (MEDIAN_MIN_COUNT(instance)) {
+			TM_FILTER_INT_MEDIAN_MinSortDown(instance, 1);
+		}
+	}
+	
+	/* Return median */
+	return TM_FILTER_MEDIAN_Get(instance);
+}
+
+int32_t TM_FILTER_MEDIAN_Get(TM_FILTER_MEDIAN_t* instance) {
+	int32_t a, b;
+	
+	/* Check samples */
+	if (instance->Count == 0) {
+		return 0;
+	}
+	
+	/* Median is on heap position 0 */
+	a = instance->Samples[instance->Heap[0]];
+	
+	/* For even count, use mean with top of max heap */
+	if ((instance->Count & 1) == 0) {
+		b = instance->Samples[instance->Heap[-1]];
+		a = (a >> 1) + (b >> 1) + (a & b & 1);
+	}
+	
+	/* Return median */
+	return a;
+}
+
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Process(TM_FILTER_MEDIAN_t* instance, const int32_t* In, int32_t* Out, size_t count) {
+	/* Check input values */
+	if (instance == NULL || In == NULL || Out == NULL) {
+		return NULL;
+	}
+	
+	/* Process all samples */
+	while (count--) {
+		*Out++ = TM_FILTER_MEDIAN_Put(instance, *In++);
+	}
+	
+	/* Return instance value */
+	return instance;
+}
+
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Clear(TM_FILTER_MEDIAN_t* instance) {
+	int16_t i;
+	
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Reset window */
+	instance->Index = 0;
+	instance->Count = 0;
+	
+	/* Set initial heap fill pattern: median, max, min, max, min, ... */
+	for (i = instance->Size - 1; i >= 0; i--) {
+		instance->Pos[i] = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+		instance->Heap[instance->Pos[i]] = i;
+	}
+	
+	/* Return instance */
+	return instance;
+}
+
+void TM_FILTER_MEDIAN_DeInit(TM_FILTER_MEDIAN_t* instance) {
+	/* Check instance */
+	if (instance == NULL) {
+		return;
+	}
+	
+	/* Free buffers, indexes are allocated together with samples */
+	if (instance->Samples != NULL && instance->Flags.F.MallocSamples) {
+		LIB_FREE_FUNC(instance->Samples);
+	}
+	
+	/* Free main instance */
+	if (instance->Flags.F.MallocInstance) {
+		LIB_FREE_FUNC(instance);
+	}
+}
+
+TM_FILTER_EMA_t* TM_FILTER_EMA_Init(TM_FILTER_EMA_t* instance, uint8_t shift) {
+	/* Save */
+	instance->Acc = 0;
+	instance->Shift = shift;
+	instance->Started = 0;
+	
+	/* Return pointer */
+	return instance;
+}
+
+int32_t TM_FILTER_EMA_Put(TM_FILTER_EMA_t* instance, int32_t sample) {
+	/* Start from first sample to avoid slow rise from zero */
+	if (!instance->Started) {
+		instance->Acc = sample * (int32_t)(1UL << instance->Shift);
+		instance->Started = 1;
+	} else {
+		instance->Acc += sample - (instance->Acc >> instance->Shift);
+	}
+	
+	/* Return filtered value */
+	return TM_FILTER_EMA_Get(instance);
+}
+
+TM_FILTER_CIC_t* TM_FILTER_CIC_Init(TM_FILTER_CIC_t* instance, uint8_t stages, uint16_t decimation) {
+	uint8_t i;
+	uint64_t gain = 1;
+	
+	/* Check parameters */
+	if (stages == 0 || stages > FILTER_CIC_MAX_STAGES || decimation == 0) {
+		return NULL;
+	}
+	
+	/* Calculate gain R^N, it must fit to 31 bits */
+	for (i = 0; i < stages; i++) {
+		gain *= decimation;
+		if (gain > 0x7FFFFFFFUL) {
+			return NULL;
+		}
+	}
+	
+	/* Save */
+	instance->Stages = stages;
+	instance->Decimation = decimation;
+	instance->Gain = (uint32_t)gain;
+	
+	/* Use shift instead of division when possible */
+	instance->Shift = 0xFF;
+	if ((decimation & (decimation - 1)) == 0) {
+		instance->Shift = 0;
+		while ((1UL << instance->Shift) < instance->Gain) {
+			instance->Shift++;
+		}
+	}
+	
+	/* Clear states */
+	TM_FILTER_CIC_Clear(instance);
+	
+	/* Return pointer */
+	return instance;
+}
+
+uint8_t TM_FILTER_CIC_Put(TM_FILTER_CIC_t* instance, int32_t sample, int32_t* Out) {
+	uint32_t x = (uint32_t)sample, y;
+	uint8_t i;
+	
+	/* Integrators, overflows are allowed as they are removed by combs */
+	for (i = 0; i < instance->Stages; i++) {
+		instance->Integrators[i] += x;
+		x = instance->Integrators[i];
+	}
+	
+	/* Check for decimation */
+	if (++instance->Counter < instance->Decimation) {
+		return 0;
+	}
+	instance->Counter = 0;
+	
+	/* Combs at low rate */
+	for (i = 0; i < instance->Stages; i++) {
+		y = x - instance->Combs[i];
+		instance->Combs[i] = x;
+		x = y;
+	}
+	
+	/* Normalize with gain */
+	if (instance->Shift != 0xFF) {
+		*Out = (int32_t)x >> instance->Shift;
+	} else {
+		*Out = TM_FILTER_INT_DivFloor((int32_t)x, (int32_t)instance->Gain);
+	}
+	
+	/* Output is available */
+	return 1;
+}
+
+size_t TM_FILTER_CIC_Process(TM_FILTER_CIC_t* instance, const int32_t* In, int32_t* Out, size_t count) {
+	size_t outputs = 0;
+	
+	/* Process all samples */
+	while (count--) {
+		if (TM_FILTER_CIC_Put(instance, *In++, &Out[outputs])) {
+			outputs++;
+		}
+	}
+	
+	/* Return number of outputs */
+	return outputs;
+}
+
+TM_FILTER_CIC_t* TM_FILTER_CIC_Clear(TM_FILTER_CIC_t* instance) {
+	/* No filter selected */
+	if (instance == NULL) {
+		return instance;
+	}
+	
+	/* Reset integrators and combs */
+	memset(instance->Integrators, 0, sizeof(instance->Integrators));
+	memset(instance->Combs, 0, sizeof(instance->Combs));
+	instance->Counter = 0;
+	
+	/* Return instance */
+	return instance;
+}
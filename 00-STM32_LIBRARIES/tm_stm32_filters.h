@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2016/07/hal-library-34-dsp-filters-for-stm32fxxx/
- * @version v1.0
+ * @version v1.4
  * @ide     Keil uVision
  * @license MIT
  * @brief   Digital signal processing library for STM32 devices
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_FILTERS_H
-#define TM_FILTERS_H 100
+#define TM_FILTERS_H 140
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -55,17 +55,143 @@ extern "C" {
  * With support of ARM Math library, this library provides wrappers
  * for simple initialization and usage ARM filters for digital signal processing.
  *
- * Supported filters are IIR Biquad 1 for F32 and FIR filter for F32.
+ * Supported filters are:
+ *  - FIR and IIR Biquad 1 for F32
+ *  - IIR Biquad 1 for Q15 and Q31 for cores without FPU (Cortex-M0, STM32F0xx)
+ *  - Decimating FIR for F32 and Q15, interpolating FIR for F32
+ *  - FIR lattice for F32
+ *  - Normalized LMS adaptive FIR for F32
+ *  - FIR and IIR Biquad 1 filter banks for F32 with interleaved multichannel data
+ *  - Integer moving average, sliding median, exponential moving average and CIC decimator
  *
  * When you design DSP on ARM, always check ARM documentation:
  *
  * http://www.keil.com/pack/doc/CMSIS/DSP/html/index.html
  *
+ * \par Static filters without heap
+ *
+ * Init functions allocate filter structure and state buffer with @ref LIB_ALLOC_FUNC.
+ * For hard real-time code or when heap is not wanted, filter and its state buffer can be declared at compile time
+ * and initialized with <code>InitStatic</code> functions. No memory is allocated in this case.
+ *
+@code
+//Declare FIR filter with 32 coefficients and block size of 16 samples, in global scope
+TM_FILTER_FIR_F32_DEFINE(FIR, 32, 16);
+
+//Declare IIR filter with 2 stages
+TM_FILTER_IIR_F32_DEFINE(IIR, 2);
+
+//Initialize filters
+TM_FILTER_FIR_F32_INIT_STATIC(FIR, 32, FIR_Coeffs, 16);
+TM_FILTER_IIR_F32_INIT_STATIC(IIR, 2, IIR_Coeffs, 16);
+
+//Use filters
+TM_FILTER_FIR_F32_Process(&FIR, In, Out);
+TM_FILTER_IIR_F32_Process(&IIR, In, Out);
+@endcode
+ *
+ * ARM instance is part of filter structure, so processing needs only one pointer.
+ *
+ * \par Multi-rate filters
+ *
+ * When signal of interest is much narrower than sampling frequency, decimate as soon as possible.
+ * Decimating FIR filter calculates only every M-th output sample, so it costs M times less than normal FIR
+ * with the same coefficients and every filter after it runs at M times lower rate.
+ *
+ * For decimating filters, block size must be multiply of decimation factor M.
+ * For interpolating filters, number of coefficients must be multiply of interpolation factor L.
+ *
+ * \par Fixed point filters
+ *
+ * Q15 and Q31 IIR coefficients must be in range [-1, 1).
+ * When they are larger, scale them down by 2^postShift and pass postShift to init function.
+ * Q15 coefficients for each stage are in format {b0, 0, b1, b2, a1, a2}, Q31 format is the same as F32.
+ *
+ * \par Filter banks
+ *
+ * When the same filter runs on multiple channels, for example ADC scan mode with DMA,
+ * samples are interleaved in memory as {CH0, CH1, ..., CHn, CH0, CH1, ...}.
+ * Filter bank keeps states for all channels in one contiguous buffer and processes interleaved
+ * input block with one call, without separate de-interleave copy and separate filter instance for each channel.
+ *
+ * All channels can share one coefficients array or each channel can have its own.
+ * For per channel coefficients, place arrays one after another in single array.
+ *
+@code
+//Declare FIR bank for 8 channels, 32 coefficients and 16 samples per channel per block
+TM_FILTER_FIR_BANK_F32_DEFINE(Bank, 8, 32, 16);
+
+//Initialize with shared coefficients
+TM_FILTER_FIR_BANK_F32_INIT_STATIC(Bank, 8, 32, FIR_Coeffs, 0, 16);
+
+//Process 16 * 8 interleaved samples from DMA buffer
+TM_FILTER_FIR_BANK_F32_Process(&Bank, ADC_Samples, Out);
+@endcode
+ *
+ * \par Integer filters
+ *
+ * For sensor smoothing (ADC, temperature, encoders), float FIR filter is often too much.
+ * Integer filters work sample by sample on <code>int32_t</code> values, need no FPU and no ARM MATH calls.
+ * They are fast on STM32F0xx too.
+ *
+ *  - Moving average keeps running sum, each sample costs 1 add, 1 subtract and 1 shift when size is power of 2
+ *  - Sliding median uses 2 heaps (max heap below median, min heap above median), each sample costs O(log(size)) compares
+ *  - Exponential moving average uses factor alpha = 1 / 2^shift, each sample costs 1 add, 1 subtract and 1 shift
+ *  - CIC decimator has no multiplications, output is normalized by gain R^N
+ *
+ * Moving average sum is 32-bit, so <code>size * max(abs(sample))</code> must fit to 31 bits.
+ * CIC uses wrapping 32-bit arithmetic and its output before normalization is <code>sample * R^N</code>,
+ * so <code>max(abs(sample)) * R^N</code> must fit to <code>int32_t</code>, or input samples must fit to <code>32 - N * log2(R)</code> bits.
+ * Outputs of moving average and CIC are always rounded towards minus infinity,
+ * with shift or division and during moving average warm-up too.
+ *
+@code
+//Moving average of 16 samples and median of 5 samples, without heap
+TM_FILTER_MA_DEFINE(MA, 16);
+TM_FILTER_MEDIAN_DEFINE(Median, 5);
+TM_FILTER_EMA_t EMA;
+
+TM_FILTER_MA_INIT_STATIC(MA, 16);
+TM_FILTER_MEDIAN_INIT_STATIC(Median, 5);
+TM_FILTER_EMA_Init(&EMA, 3);
+
+//Put new ADC sample and get filtered value
+avg = TM_FILTER_MA_Put(&MA, adc);
+med = TM_FILTER_MEDIAN_Put(&Median, adc);
+ema = TM_FILTER_EMA_Put(&EMA, adc);
+@endcode
+ *
+ * \par LMS adaptive filter
+ *
+ * LMS filter adapts its coefficients in place, so coefficients array must be in RAM.
+ * Process function needs input and reference signal and returns output and error signals.
+ *
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added static filters without heap allocation
+  - ARM instance is now part of filter structure
+
+ Version 1.2
+  - October 19, 2026
+  - Added Q15 and Q31 IIR filters
+  - Added decimating, interpolating, lattice and LMS filters
+
+ Version 1.3
+  - October 19, 2026
+  - Added FIR and IIR filter banks for interleaved multichannel data
+
+ Version 1.4
+  - October 19, 2026
+  - Added integer moving average, sliding median, EMA and CIC decimator filters
+  - Decimator ProcessAll returns NULL when count is not multiply of M
+  - FIR filter bank keeps interleaved states and filters all channels in one pass over input samples
+  - Moving average and CIC outputs are always rounded towards minus infinity
 \endverbatim
  *
  * \par Dependencies
@@ -95,6 +221,228 @@ extern "C" {
 #define LIB_FREE_FUNC        free
 #endif
 
+/**
+ * @brief  Number of states for FIR F32 filter
+ * @param  coeff_size: Number of coefficients
+ * @param  block_size: Block size of data to process at one filter call
+ */
+#define TM_FILTER_FIR_F32_STATES(coeff_size, block_size)   ((coeff_size) + (block_size) - 1)
+
+/**
+ * @brief  Number of states for IIR F32 filter
+ * @param  numStages: Number of 2nd order stages
+ */
+#define TM_FILTER_IIR_F32_STATES(numStages)                (4 * (numStages))
+
+/**
+ * @brief  Declares FIR F32 filter with its state buffer
+ * @note   Use in global scope. <code>name</code> is filter structure and <code>name_States</code> is state buffer
+ * @param  name: Filter name
+ * @param  coeff_size: Number of coefficients
+ * @param  block_size: Block size of data to process at one filter call
+ */
+#define TM_FILTER_FIR_F32_DEFINE(name, coeff_size, block_size)   \
+	float32_t name##_States[TM_FILTER_FIR_F32_STATES(coeff_size, block_size)]; \
+	TM_FILTER_FIR_F32_t name
+
+/**
+ * @brief  Declares IIR F32 filter with its state buffer
+ * @note   Use in global scope. <code>name</code> is filter structure and <code>name_States</code> is state buffer
+ * @param  name: Filter name
+ * @param  numStages: Number of 2nd order stages
+ */
+#define TM_FILTER_IIR_F32_DEFINE(name, numStages)   \
+	float32_t name##_States[TM_FILTER_IIR_F32_STATES(numStages)]; \
+	TM_FILTER_IIR_F32_t name
+
+/**
+ * @brief  Initializes FIR F32 filter declared with @ref TM_FILTER_FIR_F32_DEFINE
+ * @param  name: Filter name
+ * @param  coeff_size: Number of coefficients, the same as in declaration
+ * @param  coeffs: Pointer to coefficients
+ * @param  block_size: Block size, the same as in declaration
+ * @retval Pointer to @ref TM_FILTER_FIR_F32_t filter
+ */
+#define TM_FILTER_FIR_F32_INIT_STATIC(name, coeff_size, coeffs, block_size)   \
+	TM_FILTER_FIR_F32_InitStatic(&(name), coeff_size, coeffs, name##_States, block_size)
+
+/**
+ * @brief  Initializes IIR F32 filter declared with @ref TM_FILTER_IIR_F32_DEFINE
+ * @param  name: Filter name
+ * @param  numStages: Number of 2nd order stages, the same as in declaration
+ * @param  coeffs: Pointer to coefficients
+ * @param  block_size: Block size of data to process at one filter call
+ * @retval Pointer to @ref TM_FILTER_IIR_F32_t filter
+ */
+#define TM_FILTER_IIR_F32_INIT_STATIC(name, numStages, coeffs, block_size)   \
+	TM_FILTER_IIR_F32_InitStatic(&(name), numStages, coeffs, name##_States, block_size)
+
+/**
+ * @brief  Number of states for decimating FIR filter
+ */
+#define TM_FILTER_FIR_DECIMATE_F32_STATES(coeff_size, block_size)   ((coeff_size) + (block_size) - 1)
+
+/**
+ * @brief  Number of states for decimating FIR filter
+ */
+#define TM_FILTER_FIR_DECIMATE_Q15_STATES(coeff_size, block_size)   ((coeff_size) + (block_size) - 1)
+
+/**
+ * @brief  Number of states for interpolating FIR filter
+ */
+#define TM_FILTER_FIR_INTERPOLATE_F32_STATES(L, coeff_size, block_size)   ((coeff_size) / (L) + (block_size) - 1)
+
+/**
+ * @brief  Number of states for IIR biquad filter
+ */
+#define TM_FILTER_IIR_Q15_STATES(numStages)   (4 * (numStages))
+
+/**
+ * @brief  Number of states for IIR biquad filter
+ */
+#define TM_FILTER_IIR_Q31_STATES(numStages)   (4 * (numStages))
+
+/**
+ * @brief  Number of states for FIR lattice filter
+ */
+#define TM_FILTER_FIR_LATTICE_F32_STATES(numStages)   (numStages)
+
+/**
+ * @brief  Number of states for LMS filter
+ */
+#define TM_FILTER_LMS_F32_STATES(coeff_size, block_size)   ((coeff_size) + (block_size) - 1)
+
+/**
+ * @brief  Number of states for FIR F32 filter bank
+ * @param  channels: Number of channels
+ * @param  coeff_size: Number of coefficients
+ * @param  block_size: Number of samples per channel to process at one filter call
+ */
+#define TM_FILTER_FIR_BANK_F32_STATES(channels, coeff_size, block_size)   ((channels) * ((coeff_size) + (block_size) - 1))
+
+/**
+ * @brief  Number of states for IIR F32 filter bank
+ * @param  channels: Number of channels
+ * @param  numStages: Number of 2nd order stages
+ */
+#define TM_FILTER_IIR_BANK_F32_STATES(channels, numStages)                ((channels) * 4 * (numStages))
+
+/**
+ * @brief  Declares FIR F32 filter bank with its state buffer
+ * @note   Use in global scope. <code>name</code> is filter bank structure and <code>name_States</code> is state buffer
+ * @param  name: Filter bank name
+ * @param  channels: Number of channels
+ * @param  coeff_size: Number of coefficients
+ * @param  block_size: Number of samples per channel to process at one filter call
+ */
+#define TM_FILTER_FIR_BANK_F32_DEFINE(name, channels, coeff_size, block_size)   \
+	float32_t name##_States[TM_FILTER_FIR_BANK_F32_STATES(channels, coeff_size, block_size)]; \
+	TM_FILTER_FIR_BANK_F32_t name
+
+/**
+ * @brief  Declares IIR F32 filter bank with its state buffer
+ * @note   Use in global scope. <code>name</code> is filter bank structure and <code>name_States</code> is state buffer
+ * @param  name: Filter bank name
+ * @param  channels: Number of channels
+ * @param  numStages: Number of 2nd order stages
+ */
+#define TM_FILTER_IIR_BANK_F32_DEFINE(name, channels, numStages)   \
+	float32_t name##_States[TM_FILTER_IIR_BANK_F32_STATES(channels, numStages)]; \
+	TM_FILTER_IIR_BANK_F32_t name
+
+/**
+ * @brief  Initializes FIR F32 filter bank declared with @ref TM_FILTER_FIR_BANK_F32_DEFINE
+ * @param  name: Filter bank name
+ * @param  channels: Number of channels, the same as in declaration
+ * @param  coeff_size: Number of coefficients, the same as in declaration
+ * @param  coeffs: Pointer to coefficients
+ * @param  per_channel: Set to 1 if each channel has its own coefficients
+ * @param  block_size: Block size, the same as in declaration
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t filter bank
+ */
+#define TM_FILTER_FIR_BANK_F32_INIT_STATIC(name, channels, coeff_size, coeffs, per_channel, block_size)   \
+	TM_FILTER_FIR_BANK_F32_InitStatic(&(name), channels, coeff_size, coeffs, per_channel, name##_States, block_size)
+
+/**
+ * @brief  Initializes IIR F32 filter bank declared with @ref TM_FILTER_IIR_BANK_F32_DEFINE
+ * @param  name: Filter bank name
+ * @param  channels: Number of channels, the same as in declaration
+ * @param  numStages: Number of 2nd order stages, the same as in declaration
+ * @param  coeffs: Pointer to coefficients
+ * @param  per_channel: Set to 1 if each channel has its own coefficients
+ * @param  block_size: Number of samples per channel to process at one filter call
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t filter bank
+ */
+#define TM_FILTER_IIR_BANK_F32_INIT_STATIC(name, channels, numStages, coeffs, per_channel, block_size)   \
+	TM_FILTER_IIR_BANK_F32_InitStatic(&(name), channels, numStages, coeffs, per_channel, name##_States, block_size)
+
+/**
+ * @brief  Maximal number of CIC integrator and comb stages
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef FILTER_CIC_MAX_STAGES
+#define FILTER_CIC_MAX_STAGES      4
+#endif
+
+/**
+ * @brief  Number of index entries for sliding median filter
+ * @param  size: Number of samples in median window
+ */
+#define TM_FILTER_MEDIAN_INDEXES(size)      (2 * (size))
+
+/**
+ * @brief  Declares integer moving average filter with its sample buffer
+ * @note   Use in global scope. <code>name</code> is filter structure and <code>name_Samples</code> is sample buffer
+ * @param  name: Filter name
+ * @param  size: Number of samples to average
+ */
+#define TM_FILTER_MA_DEFINE(name, size)   \
+	int32_t name##_Samples[size]; \
+	TM_FILTER_MA_t name
+
+/**
+ * @brief  Declares sliding median filter with its buffers
+ * @note   Use in global scope. <code>name</code> is filter structure, <code>name_Samples</code> and <code>name_Indexes</code> are buffers
+ * @param  name: Filter name
+ * @param  size: Number of samples in median window
+ */
+#define TM_FILTER_MEDIAN_DEFINE(name, size)   \
+	int32_t name##_Samples[size]; \
+	int16_t name##_Indexes[TM_FILTER_MEDIAN_INDEXES(size)]; \
+	TM_FILTER_MEDIAN_t name
+
+/**
+ * @brief  Initializes moving average filter declared with @ref TM_FILTER_MA_DEFINE
+ * @param  name: Filter name
+ * @param  size: Number of samples, the same as in declaration
+ * @retval Pointer to @ref TM_FILTER_MA_t filter
+ */
+#define TM_FILTER_MA_INIT_STATIC(name, size)   \
+	TM_FILTER_MA_InitStatic(&(name), size, name##_Samples)
+
+/**
+ * @brief  Initializes sliding median filter declared with @ref TM_FILTER_MEDIAN_DEFINE
+ * @param  name: Filter name
+ * @param  size: Number of samples, the same as in declaration
+ * @retval Pointer to @ref TM_FILTER_MEDIAN_t filter
+ */
+#define TM_FILTER_MEDIAN_INIT_STATIC(name, size)   \
+	TM_FILTER_MEDIAN_InitStatic(&(name), size, name##_Samples, name##_Indexes)
+
+/**
+ * @brief  Gets last output value of integer moving average filter
+ * @param  instance: Pointer to @ref TM_FILTER_MA_t filter
+ * @retval Average of samples in window
+ */
+#define TM_FILTER_MA_Get(instance)         ((instance)->Output)
+
+/**
+ * @brief  Gets last output value of exponential moving average filter
+ * @param  instance: Pointer to @ref TM_FILTER_EMA_t filter
+ * @retval Filtered value
+ */
+#define TM_FILTER_EMA_Get(instance)        ((int32_t)((instance)->Acc >> (instance)->Shift))
+
 /**
  * @}
  */
@@ -110,12 +458,14 @@ extern "C" {
  * @brief  FIR Filter structure
  */
 typedef struct _TM_FILTER_FIR_F32_t {
-	arm_fir_instance_f32* f;         /*!< Pointer to arm_fir_instance structure */
+	arm_fir_instance_f32 Instance;   /*!< ARM FIR instance */
 	size_t BlockSize;                /*!< Block size of data to process at one filter call */
+	arm_fir_instance_f32* f;         /*!< Pointer to Instance member, kept for compatibility */
 	size_t StatesCount;              /*!< Number of states used for temporary data */
 	union {
 		struct {
 			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
 		} F;
 		uint8_t FlagsValues;
 	} Flags;
@@ -125,16 +475,229 @@ typedef struct _TM_FILTER_FIR_F32_t {
  * @brief  IIR Filter structure
  */
 typedef struct _TM_FILTER_IIR_F32_t {
-	arm_biquad_casd_df1_inst_f32* f; /*!< Pointer to arm_iir_lattice_f32 structure */
+	arm_biquad_casd_df1_inst_f32 Instance; /*!< ARM biquad direct form 1 instance */
 	size_t BlockSize;                /*!< Block size of data to process at one filter call */
+	arm_biquad_casd_df1_inst_f32* f; /*!< Pointer to Instance member, kept for compatibility */
 	union {
 		struct {
 			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
 		} F;
 		uint8_t FlagsValues;
 	} Flags;
 } TM_FILTER_IIR_F32_t;
 
+/**
+ * @brief  Decimating FIR filter using F32 coefficients structure
+ */
+typedef struct _TM_FILTER_FIR_DECIMATE_F32_t {
+	arm_fir_decimate_instance_f32 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_FIR_DECIMATE_F32_t;
+
+/**
+ * @brief  Decimating FIR filter using Q15 coefficients structure
+ */
+typedef struct _TM_FILTER_FIR_DECIMATE_Q15_t {
+	arm_fir_decimate_instance_q15 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_FIR_DECIMATE_Q15_t;
+
+/**
+ * @brief  Interpolating FIR filter using F32 coefficients structure
+ */
+typedef struct _TM_FILTER_FIR_INTERPOLATE_F32_t {
+	arm_fir_interpolate_instance_f32 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_FIR_INTERPOLATE_F32_t;
+
+/**
+ * @brief  IIR biquad direct form 1 filter using Q15 coefficients structure
+ */
+typedef struct _TM_FILTER_IIR_Q15_t {
+	arm_biquad_casd_df1_inst_q15 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_IIR_Q15_t;
+
+/**
+ * @brief  IIR biquad direct form 1 filter using Q31 coefficients structure
+ */
+typedef struct _TM_FILTER_IIR_Q31_t {
+	arm_biquad_casd_df1_inst_q31 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_IIR_Q31_t;
+
+/**
+ * @brief  FIR lattice filter using F32 reflection coefficients structure
+ */
+typedef struct _TM_FILTER_FIR_LATTICE_F32_t {
+	arm_fir_lattice_instance_f32 Instance; /*!< ARM instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_FIR_LATTICE_F32_t;
+
+/**
+ * @brief  Normalized LMS filter structure
+ */
+typedef struct _TM_FILTER_LMS_F32_t {
+	arm_lms_norm_instance_f32 Instance; /*!< ARM normalized LMS instance */
+	size_t BlockSize;                /*!< Block size of input data to process at one filter call */
+	size_t StatesCount;              /*!< Number of states used for temporary data */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_LMS_F32_t;
+
+/**
+ * @brief  FIR filter bank structure for interleaved multichannel data
+ */
+typedef struct _TM_FILTER_FIR_BANK_F32_t {
+	const float32_t* Coeffs;         /*!< Pointer to coefficients in time reversed order */
+	size_t CoeffsStride;             /*!< Offset between coefficients of 2 channels. 0 when channels share coefficients */
+	float32_t* States;               /*!< Pointer to states for all channels, interleaved the same way as input samples */
+	uint16_t Channels;               /*!< Number of channels */
+	uint16_t NumTaps;                /*!< Number of coefficients */
+	size_t BlockSize;                /*!< Number of samples per channel to process at one filter call */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_FIR_BANK_F32_t;
+
+/**
+ * @brief  IIR biquad direct form 1 filter bank structure for interleaved multichannel data
+ */
+typedef struct _TM_FILTER_IIR_BANK_F32_t {
+	const float32_t* Coeffs;         /*!< Pointer to coefficients in format {b10, b11, b12, a11, a12, b20, ...} */
+	size_t CoeffsStride;             /*!< Offset between coefficients of 2 channels. 0 when channels share coefficients */
+	float32_t* States;               /*!< Pointer to states for all channels, one after another */
+	uint16_t Channels;               /*!< Number of channels */
+	uint8_t NumStages;               /*!< Number of 2nd order stages */
+	size_t BlockSize;                /*!< Number of samples per channel to process at one filter call */
+	union {
+		struct {
+			uint8_t MallocStates:1;  /*!< Set to 1 if malloc was used for state data allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_IIR_BANK_F32_t;
+
+/**
+ * @brief  Integer moving average filter structure
+ */
+typedef struct _TM_FILTER_MA_t {
+	int32_t* Samples;                /*!< Pointer to ring buffer of last samples */
+	uint16_t Size;                   /*!< Number of samples to average */
+	uint16_t Index;                  /*!< Write index in ring buffer */
+	uint16_t Count;                  /*!< Number of valid samples in ring buffer */
+	uint8_t Shift;                   /*!< log2(Size) when size is power of 2, 0xFF otherwise */
+	int32_t Sum;                     /*!< Running sum of samples in ring buffer */
+	int32_t Output;                  /*!< Last output value */
+	union {
+		struct {
+			uint8_t MallocSamples:1; /*!< Set to 1 if malloc was used for sample buffer allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_MA_t;
+
+/**
+ * @brief  Sliding median filter structure
+ */
+typedef struct _TM_FILTER_MEDIAN_t {
+	int32_t* Samples;                /*!< Pointer to ring buffer of last samples */
+	int16_t* Pos;                    /*!< Heap position for each sample in ring buffer */
+	int16_t* Heap;                   /*!< Points to median in heap array. Negative indexes are max heap, positive min heap */
+	uint16_t Size;                   /*!< Number of samples in window */
+	uint16_t Index;                  /*!< Write index in ring buffer */
+	uint16_t Count;                  /*!< Number of valid samples in ring buffer */
+	union {
+		struct {
+			uint8_t MallocSamples:1; /*!< Set to 1 if malloc was used for buffer allocation */
+			uint8_t MallocInstance:1;/*!< Set to 1 if malloc was used for filter structure allocation */
+		} F;
+		uint8_t FlagsValues;
+	} Flags;
+} TM_FILTER_MEDIAN_t;
+
+/**
+ * @brief  Fixed point exponential moving average filter structure
+ */
+typedef struct _TM_FILTER_EMA_t {
+	int32_t Acc;                     /*!< Filtered value multiplied with 2^Shift */
+	uint8_t Shift;                   /*!< Filter factor, alpha = 1 / 2^Shift */
+	uint8_t Started;                 /*!< Set to 1 after first sample */
+} TM_FILTER_EMA_t;
+
+/**
+ * @brief  CIC decimator structure
+ */
+typedef struct _TM_FILTER_CIC_t {
+	uint32_t Integrators[FILTER_CIC_MAX_STAGES]; /*!< Integrator stages */
+	uint32_t Combs[FILTER_CIC_MAX_STAGES];       /*!< Delay elements of comb stages */
+	uint8_t Stages;                  /*!< Number of integrator and comb stages N */
+	uint16_t Decimation;             /*!< Decimation factor R */
+	uint16_t Counter;                /*!< Input samples since last output */
+	uint8_t Shift;                   /*!< N * log2(R) when R is power of 2, 0xFF otherwise */
+	uint32_t Gain;                   /*!< Filter gain R^N, used when R is not power of 2 */
+} TM_FILTER_CIC_t;
+
 /**
  * @}
  */
@@ -157,6 +720,18 @@ typedef struct _TM_FILTER_IIR_F32_t {
  */
 TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Init(size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
 
+/**
+ * @brief  Initializes ARM FIR filter using F32 coefficients on user provided memory
+ * @note   No memory is allocated. @ref TM_FILTER_FIR_F32_INIT_STATIC can be used for filters declared with @ref TM_FILTER_FIR_F32_DEFINE
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_F32_t structure
+ * @param  coeff_size: Number of cofficients for FIR filtering
+ * @param  *coeffs: Pointer to coefficients FIR filter array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_F32_STATES length
+ * @param  block_size: size of block for FIR filtering. Number of elements for filtering at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_F32_t instance
+ */
+TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_InitStatic(TM_FILTER_FIR_F32_t* instance, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
 /**
  * @brief  Process data through ARM FIR F32 filter
  * @param  *instance: Pointer to @ref TM_FILTER_FIR_F32_t instance
@@ -185,6 +760,7 @@ TM_FILTER_FIR_F32_t* TM_FILTER_FIR_F32_Clear(TM_FILTER_FIR_F32_t* instance);
 
 /**
  * @brief  Deallocates ARM FIR filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_FIR_F32_InitStatic
  * @param  Pointer to @ref TM_FILTER_FIR_F32_t which will be used for deinit
  * @retval None 
  */
@@ -203,6 +779,18 @@ void TM_FILTER_FIR_F32_DeInit(TM_FILTER_FIR_F32_t* instance);
  */
 TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Init(size_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
 
+/**
+ * @brief  Initializes ARM IIR biquad direct form 1 filter using F32 coefficients on user provided memory
+ * @note   No memory is allocated. @ref TM_FILTER_IIR_F32_INIT_STATIC can be used for filters declared with @ref TM_FILTER_IIR_F32_DEFINE
+ * @param  *instance: Pointer to empty @ref TM_FILTER_IIR_F32_t structure
+ * @param  numStages: Number of 2nd order stages
+ * @param  *coeffs: Pointer to coeffs array. Coefficients length must be 5 * numStages parameter
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_F32_STATES length
+ * @param  block_size: Number of samples to use when processing filter
+ * @retval Pointer to @ref TM_FILTER_IIR_F32_t instance
+ */
+TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_InitStatic(TM_FILTER_IIR_F32_t* instance, size_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
 /**
  * @brief  Processes ARM IIR biquad direct form 1 filter using F32 coefficients
  * @param  *instance: Pointer to @ref TM_FILTER_IIR_F32_t structure with filled input buffer with input data
@@ -231,11 +819,715 @@ TM_FILTER_IIR_F32_t* TM_FILTER_IIR_F32_Clear(TM_FILTER_IIR_F32_t* instance);
 
 /**
  * @brief  Deallocates ARM IIR biquad direct form 1 filter with state buffer
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_IIR_F32_InitStatic
  * @param  Pointer to @ref TM_FILTER_IIR_F32_t which will be used for deinit
  * @retval None 
  */
 void TM_FILTER_IIR_F32_DeInit(TM_FILTER_IIR_F32_t* instance);
 
+/**
+ * @brief  Creates and initializes decimating FIR filter using F32 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  M: Decimation factor. block_size must be multiply of M
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_DECIMATE_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Init(uint8_t M, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes decimating FIR filter using F32 coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_DECIMATE_F32_t structure
+ * @param  M: Decimation factor. block_size must be multiply of M
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_DECIMATE_F32_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_InitStatic(TM_FILTER_FIR_DECIMATE_F32_t* instance, uint8_t M, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through decimating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size / M length
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ */
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Process(TM_FILTER_FIR_DECIMATE_F32_t* instance, float32_t* In, float32_t* Out);
+
+/**
+ * @brief  Process all input data through decimating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array with count / M elements
+ * @param  count: Number of elements in input array. It must be multiply of M
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance or NULL if count is not multiply of M.
+ *            Nothing is processed in this case, samples which do not make one output sample must be kept by caller for next call
+ */
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_ProcessAll(TM_FILTER_FIR_DECIMATE_F32_t* instance, float32_t* In, float32_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ */
+TM_FILTER_FIR_DECIMATE_F32_t* TM_FILTER_FIR_DECIMATE_F32_Clear(TM_FILTER_FIR_DECIMATE_F32_t* instance);
+
+/**
+ * @brief  Deallocates decimating FIR filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_FIR_DECIMATE_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_FIR_DECIMATE_F32_DeInit(TM_FILTER_FIR_DECIMATE_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes decimating FIR filter using Q15 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  M: Decimation factor. block_size must be multiply of M
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_DECIMATE_Q15_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Init(uint8_t M, size_t coeff_size, const q15_t* coeffs, q15_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes decimating FIR filter using Q15 coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_DECIMATE_Q15_t structure
+ * @param  M: Decimation factor. block_size must be multiply of M
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_DECIMATE_Q15_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_InitStatic(TM_FILTER_FIR_DECIMATE_Q15_t* instance, uint8_t M, size_t coeff_size, const q15_t* coeffs, q15_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through decimating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size / M length
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ */
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Process(TM_FILTER_FIR_DECIMATE_Q15_t* instance, q15_t* In, q15_t* Out);
+
+/**
+ * @brief  Process all input data through decimating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array with count / M elements
+ * @param  count: Number of elements in input array. It must be multiply of M
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance or NULL if count is not multiply of M.
+ *            Nothing is processed in this case, samples which do not make one output sample must be kept by caller for next call
+ */
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_ProcessAll(TM_FILTER_FIR_DECIMATE_Q15_t* instance, q15_t* In, q15_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ * @retval Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ */
+TM_FILTER_FIR_DECIMATE_Q15_t* TM_FILTER_FIR_DECIMATE_Q15_Clear(TM_FILTER_FIR_DECIMATE_Q15_t* instance);
+
+/**
+ * @brief  Deallocates decimating FIR filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_FIR_DECIMATE_Q15_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_DECIMATE_Q15_t instance
+ * @retval None 
+ */
+void TM_FILTER_FIR_DECIMATE_Q15_DeInit(TM_FILTER_FIR_DECIMATE_Q15_t* instance);
+
+/**
+ * @brief  Creates and initializes interpolating FIR filter using F32 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  L: Interpolation factor
+ * @param  coeff_size: Number of coefficients. It must be multiply of L
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_INTERPOLATE_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Init(uint8_t L, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes interpolating FIR filter using F32 coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_INTERPOLATE_F32_t structure
+ * @param  L: Interpolation factor
+ * @param  coeff_size: Number of coefficients. It must be multiply of L
+ * @param  *coeffs: Pointer to coefficients array coeff_size length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_INTERPOLATE_F32_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_InitStatic(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, uint8_t L, size_t coeff_size, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through interpolating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size * L length
+ * @retval Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ */
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Process(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, float32_t* In, float32_t* Out);
+
+/**
+ * @brief  Process all input data through interpolating FIR filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array with count * L elements
+ * @param  count: Number of elements in input array
+ * @retval Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ */
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_ProcessAll(TM_FILTER_FIR_INTERPOLATE_F32_t* instance, float32_t* In, float32_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ */
+TM_FILTER_FIR_INTERPOLATE_F32_t* TM_FILTER_FIR_INTERPOLATE_F32_Clear(TM_FILTER_FIR_INTERPOLATE_F32_t* instance);
+
+/**
+ * @brief  Deallocates interpolating FIR filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_FIR_INTERPOLATE_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_INTERPOLATE_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_FIR_INTERPOLATE_F32_DeInit(TM_FILTER_FIR_INTERPOLATE_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes IIR biquad direct form 1 filter using Q15 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  numStages: Number of 2nd order stages
+ * @param  *coeffs: Pointer to coefficients array 6 * numStages length in format {b10, 0, b11, b12, a11, a12, b20, 0, ...}
+ * @param  postShift: Shift of result to compensate coefficients scaled down to fit Q15 range
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_Q15_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_Q15_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Init(uint8_t numStages, const q15_t* coeffs, int8_t postShift, q15_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes IIR biquad direct form 1 filter using Q15 coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_IIR_Q15_t structure
+ * @param  numStages: Number of 2nd order stages
+ * @param  *coeffs: Pointer to coefficients array 6 * numStages length in format {b10, 0, b11, b12, a11, a12, b20, 0, ...}
+ * @param  postShift: Shift of result to compensate coefficients scaled down to fit Q15 range
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_Q15_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_Q15_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_InitStatic(TM_FILTER_IIR_Q15_t* instance, uint8_t numStages, const q15_t* coeffs, int8_t postShift, q15_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through IIR biquad filter
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size length
+ * @retval Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ */
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Process(TM_FILTER_IIR_Q15_t* instance, q15_t* In, q15_t* Out);
+
+/**
+ * @brief  Process all input data through IIR biquad filter
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array
+ * @param  count: Number of elements in input array
+ * @retval Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ */
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_ProcessAll(TM_FILTER_IIR_Q15_t* instance, q15_t* In, q15_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ * @retval Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ */
+TM_FILTER_IIR_Q15_t* TM_FILTER_IIR_Q15_Clear(TM_FILTER_IIR_Q15_t* instance);
+
+/**
+ * @brief  Deallocates IIR biquad filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_IIR_Q15_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q15_t instance
+ * @retval None 
+ */
+void TM_FILTER_IIR_Q15_DeInit(TM_FILTER_IIR_Q15_t* instance);
+
+/**
+ * @brief  Creates and initializes IIR biquad direct form 1 filter using Q31 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  numStages: Number of 2nd order stages
+ * @param  *coeffs: Pointer to coefficients array 5 * numStages length in format {b10, b11, b12, a11, a12, b20, ...}
+ * @param  postShift: Shift of result to compensate coefficients scaled down to fit Q31 range
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_Q31_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_Q31_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Init(uint8_t numStages, const q31_t* coeffs, int8_t postShift, q31_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes IIR biquad direct form 1 filter using Q31 coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_IIR_Q31_t structure
+ * @param  numStages: Number of 2nd order stages
+ * @param  *coeffs: Pointer to coefficients array 5 * numStages length in format {b10, b11, b12, a11, a12, b20, ...}
+ * @param  postShift: Shift of result to compensate coefficients scaled down to fit Q31 range
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_Q31_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_Q31_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_InitStatic(TM_FILTER_IIR_Q31_t* instance, uint8_t numStages, const q31_t* coeffs, int8_t postShift, q31_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through IIR biquad filter
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size length
+ * @retval Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ */
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Process(TM_FILTER_IIR_Q31_t* instance, q31_t* In, q31_t* Out);
+
+/**
+ * @brief  Process all input data through IIR biquad filter
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array
+ * @param  count: Number of elements in input array
+ * @retval Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ */
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_ProcessAll(TM_FILTER_IIR_Q31_t* instance, q31_t* In, q31_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ * @retval Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ */
+TM_FILTER_IIR_Q31_t* TM_FILTER_IIR_Q31_Clear(TM_FILTER_IIR_Q31_t* instance);
+
+/**
+ * @brief  Deallocates IIR biquad filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_IIR_Q31_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_Q31_t instance
+ * @retval None 
+ */
+void TM_FILTER_IIR_Q31_DeInit(TM_FILTER_IIR_Q31_t* instance);
+
+/**
+ * @brief  Creates and initializes FIR lattice filter using F32 reflection coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  numStages: Number of lattice stages
+ * @param  *coeffs: Pointer to reflection coefficients array numStages length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_LATTICE_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance or NULL if allocation failed or parameters are not valid
+ */
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Init(uint16_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes FIR lattice filter using F32 reflection coefficients on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_LATTICE_F32_t structure
+ * @param  numStages: Number of lattice stages
+ * @param  *coeffs: Pointer to reflection coefficients array numStages length
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_LATTICE_F32_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_InitStatic(TM_FILTER_FIR_LATTICE_F32_t* instance, uint16_t numStages, const float32_t* coeffs, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through FIR lattice filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Out: Output data array of block_size length
+ * @retval Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ */
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Process(TM_FILTER_FIR_LATTICE_F32_t* instance, float32_t* In, float32_t* Out);
+
+/**
+ * @brief  Process all input data through FIR lattice filter
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ * @param  *In: Input data array
+ * @param  *Out: Output data array
+ * @param  count: Number of elements in input array
+ * @retval Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ */
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_ProcessAll(TM_FILTER_FIR_LATTICE_F32_t* instance, float32_t* In, float32_t* Out, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ */
+TM_FILTER_FIR_LATTICE_F32_t* TM_FILTER_FIR_LATTICE_F32_Clear(TM_FILTER_FIR_LATTICE_F32_t* instance);
+
+/**
+ * @brief  Deallocates FIR lattice filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_FIR_LATTICE_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_LATTICE_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_FIR_LATTICE_F32_DeInit(TM_FILTER_FIR_LATTICE_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes normalized LMS filter using F32 coefficients
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to initial coefficients array coeff_size length. Array must be in RAM, coefficients are updated on each call
+ * @param  mu: Step size which controls adaptation rate
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_LMS_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_LMS_F32_t instance or NULL if allocation failed
+ */
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Init(size_t coeff_size, float32_t* coeffs, float32_t mu, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes normalized LMS filter on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_LMS_F32_t structure
+ * @param  coeff_size: Number of coefficients
+ * @param  *coeffs: Pointer to initial coefficients array coeff_size length. Array must be in RAM, coefficients are updated on each call
+ * @param  mu: Step size which controls adaptation rate
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_LMS_F32_STATES length
+ * @param  block_size: Number of input samples to process at a time
+ * @retval Pointer to @ref TM_FILTER_LMS_F32_t instance
+ */
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_InitStatic(TM_FILTER_LMS_F32_t* instance, size_t coeff_size, float32_t* coeffs, float32_t mu, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process data through LMS filter and adapt coefficients
+ * @param  *instance: Pointer to @ref TM_FILTER_LMS_F32_t instance
+ * @param  *In: Input data array of block_size length
+ * @param  *Ref: Reference (desired) data array of block_size length
+ * @param  *Out: Output data array of block_size length
+ * @param  *Err: Error data array of block_size length
+ * @retval Pointer to @ref TM_FILTER_LMS_F32_t instance
+ */
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Process(TM_FILTER_LMS_F32_t* instance, float32_t* In, float32_t* Ref, float32_t* Out, float32_t* Err);
+
+/**
+ * @brief  Process all input data through LMS filter and adapt coefficients
+ * @param  *instance: Pointer to @ref TM_FILTER_LMS_F32_t instance
+ * @param  *In: Input data array
+ * @param  *Ref: Reference (desired) data array
+ * @param  *Out: Output data array
+ * @param  *Err: Error data array
+ * @param  count: Number of elements in each array
+ * @retval Pointer to @ref TM_FILTER_LMS_F32_t instance
+ */
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_ProcessAll(TM_FILTER_LMS_F32_t* instance, float32_t* In, float32_t* Ref, float32_t* Out, float32_t* Err, size_t count);
+
+/**
+ * @brief  Clear filter's state buffer, set values to 0
+ * @note   Coefficients are not reset
+ * @param  *instance: Pointer to @ref TM_FILTER_LMS_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_LMS_F32_t instance
+ */
+TM_FILTER_LMS_F32_t* TM_FILTER_LMS_F32_Clear(TM_FILTER_LMS_F32_t* instance);
+
+/**
+ * @brief  Deallocates LMS filter with all allocated buffers
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_LMS_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_LMS_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_LMS_F32_DeInit(TM_FILTER_LMS_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes FIR filter bank for interleaved multichannel data
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  channels: Number of interleaved channels
+ * @param  coeff_size: Number of coefficients for each channel
+ * @param  *coeffs: Pointer to coefficients array in time reversed order, the same as for @ref TM_FILTER_FIR_F32_Init.
+ *            When per_channel is set, array has channels * coeff_size elements
+ * @param  per_channel: Set to 1 if each channel has its own coefficients or 0 if all channels use the same coefficients
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_BANK_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of samples per channel to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance or NULL if allocation failed
+ */
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Init(uint16_t channels, size_t coeff_size, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes FIR filter bank on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_FIR_BANK_F32_t structure
+ * @param  channels: Number of interleaved channels
+ * @param  coeff_size: Number of coefficients for each channel
+ * @param  *coeffs: Pointer to coefficients array in time reversed order, the same as for @ref TM_FILTER_FIR_F32_Init.
+ *            When per_channel is set, array has channels * coeff_size elements
+ * @param  per_channel: Set to 1 if each channel has its own coefficients or 0 if all channels use the same coefficients
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_FIR_BANK_F32_STATES length
+ * @param  block_size: Number of samples per channel to process at a time
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ */
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_InitStatic(TM_FILTER_FIR_BANK_F32_t* instance, uint16_t channels, size_t coeff_size, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process interleaved data block through filter bank
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ * @param  *In: Interleaved input data array of block_size * channels length
+ * @param  *Out: Interleaved output data array of block_size * channels length. It can be the same as input array
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ */
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Process(TM_FILTER_FIR_BANK_F32_t* instance, float32_t* In, float32_t* Out);
+
+/**
+ * @brief  Process all interleaved input data through filter bank
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ * @param  *In: Interleaved input data array of count * channels length
+ * @param  *Out: Interleaved output data array of count * channels length. It can be the same as input array
+ * @param  count: Number of samples per channel
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ */
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_ProcessAll(TM_FILTER_FIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count);
+
+/**
+ * @brief  Clears states of all channels and set them to zero
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ */
+TM_FILTER_FIR_BANK_F32_t* TM_FILTER_FIR_BANK_F32_Clear(TM_FILTER_FIR_BANK_F32_t* instance);
+
+/**
+ * @brief  Deallocates filter bank with all allocated buffers
+ * @note   Nothing is done for filter banks initialized with @ref TM_FILTER_FIR_BANK_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_FIR_BANK_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_FIR_BANK_F32_DeInit(TM_FILTER_FIR_BANK_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes IIR biquad direct form 1 filter bank for interleaved multichannel data
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  channels: Number of interleaved channels
+ * @param  numStages: Number of 2nd order stages for each channel
+ * @param  *coeffs: Pointer to coefficients array 5 * numStages length in format {b10, b11, b12, a11, a12, b20, ...}, the same as for @ref TM_FILTER_IIR_F32_Init.
+ *            When per_channel is set, array has channels * 5 * numStages elements
+ * @param  per_channel: Set to 1 if each channel has its own coefficients or 0 if all channels use the same coefficients
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_BANK_F32_STATES length. Set to null to let malloc allocate memory in heap
+ * @param  block_size: Number of samples per channel to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance or NULL if allocation failed
+ */
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Init(uint16_t channels, uint8_t numStages, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Initializes IIR biquad direct form 1 filter bank on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_IIR_BANK_F32_t structure
+ * @param  channels: Number of interleaved channels
+ * @param  numStages: Number of 2nd order stages for each channel
+ * @param  *coeffs: Pointer to coefficients array 5 * numStages length in format {b10, b11, b12, a11, a12, b20, ...}, the same as for @ref TM_FILTER_IIR_F32_Init.
+ *            When per_channel is set, array has channels * 5 * numStages elements
+ * @param  per_channel: Set to 1 if each channel has its own coefficients or 0 if all channels use the same coefficients
+ * @param  *StateBuffer: Pointer to state buffer of @ref TM_FILTER_IIR_BANK_F32_STATES length
+ * @param  block_size: Number of samples per channel to process at a time
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ */
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_InitStatic(TM_FILTER_IIR_BANK_F32_t* instance, uint16_t channels, uint8_t numStages, const float32_t* coeffs, uint8_t per_channel, float32_t* StateBuffer, size_t block_size);
+
+/**
+ * @brief  Process interleaved data block through filter bank
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ * @param  *In: Interleaved input data array of block_size * channels length
+ * @param  *Out: Interleaved output data array of block_size * channels length. It can be the same as input array
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ */
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Process(TM_FILTER_IIR_BANK_F32_t* instance, float32_t* In, float32_t* Out);
+
+/**
+ * @brief  Process all interleaved input data through filter bank
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ * @param  *In: Interleaved input data array of count * channels length
+ * @param  *Out: Interleaved output data array of count * channels length. It can be the same as input array
+ * @param  count: Number of samples per channel
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ */
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_ProcessAll(TM_FILTER_IIR_BANK_F32_t* instance, float32_t* In, float32_t* Out, size_t count);
+
+/**
+ * @brief  Clears states of all channels and set them to zero
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ * @retval Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ */
+TM_FILTER_IIR_BANK_F32_t* TM_FILTER_IIR_BANK_F32_Clear(TM_FILTER_IIR_BANK_F32_t* instance);
+
+/**
+ * @brief  Deallocates filter bank with all allocated buffers
+ * @note   Nothing is done for filter banks initialized with @ref TM_FILTER_IIR_BANK_F32_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_IIR_BANK_F32_t instance
+ * @retval None 
+ */
+void TM_FILTER_IIR_BANK_F32_DeInit(TM_FILTER_IIR_BANK_F32_t* instance);
+
+/**
+ * @brief  Creates and initializes integer moving average filter
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  size: Number of samples to average. Use power of 2 for fastest operation
+ * @param  *Samples: Pointer to sample buffer of size length. Set to null to let malloc allocate memory in heap
+ * @retval Pointer to @ref TM_FILTER_MA_t instance or NULL if allocation failed
+ */
+TM_FILTER_MA_t* TM_FILTER_MA_Init(uint16_t size, int32_t* Samples);
+
+/**
+ * @brief  Initializes integer moving average filter on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_MA_t structure
+ * @param  size: Number of samples to average. Use power of 2 for fastest operation
+ * @param  *Samples: Pointer to sample buffer of size length
+ * @retval Pointer to @ref TM_FILTER_MA_t instance
+ */
+TM_FILTER_MA_t* TM_FILTER_MA_InitStatic(TM_FILTER_MA_t* instance, uint16_t size, int32_t* Samples);
+
+/**
+ * @brief  Puts new sample to moving average filter
+ * @note   Until window is full, average of received samples is returned
+ * @param  *instance: Pointer to @ref TM_FILTER_MA_t instance
+ * @param  sample: New sample
+ * @retval Average of samples in window, rounded towards minus infinity
+ */
+int32_t TM_FILTER_MA_Put(TM_FILTER_MA_t* instance, int32_t sample);
+
+/**
+ * @brief  Process block of samples through moving average filter
+ * @param  *instance: Pointer to @ref TM_FILTER_MA_t instance
+ * @param  *In: Input samples
+ * @param  *Out: Output samples. It can be the same as input array
+ * @param  count: Number of samples
+ * @retval Pointer to @ref TM_FILTER_MA_t instance
+ */
+TM_FILTER_MA_t* TM_FILTER_MA_Process(TM_FILTER_MA_t* instance, const int32_t* In, int32_t* Out, size_t count);
+
+/**
+ * @brief  Clears moving average filter
+ * @param  *instance: Pointer to @ref TM_FILTER_MA_t instance
+ * @retval Pointer to @ref TM_FILTER_MA_t instance
+ */
+TM_FILTER_MA_t* TM_FILTER_MA_Clear(TM_FILTER_MA_t* instance);
+
+/**
+ * @brief  Deallocates moving average filter
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_MA_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_MA_t instance
+ * @retval None 
+ */
+void TM_FILTER_MA_DeInit(TM_FILTER_MA_t* instance);
+
+/**
+ * @brief  Creates and initializes sliding median filter
+ * @note   Malloc is used to initialize proper size of heap memory
+ * @param  size: Number of samples in median window. Use odd number to get real median
+ * @param  *Samples: Pointer to sample buffer of size length. Set to null to let malloc allocate both buffers in heap
+ * @param  *Indexes: Pointer to index buffer of @ref TM_FILTER_MEDIAN_INDEXES length. Ignored when Samples is null
+ * @retval Pointer to @ref TM_FILTER_MEDIAN_t instance or NULL if allocation failed
+ */
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Init(uint16_t size, int32_t* Samples, int16_t* Indexes);
+
+/**
+ * @brief  Initializes sliding median filter on user provided memory
+ * @param  *instance: Pointer to empty @ref TM_FILTER_MEDIAN_t structure
+ * @param  size: Number of samples in median window. Use odd number to get real median
+ * @param  *Samples: Pointer to sample buffer of size length
+ * @param  *Indexes: Pointer to index buffer of @ref TM_FILTER_MEDIAN_INDEXES length
+ * @retval Pointer to @ref TM_FILTER_MEDIAN_t instance
+ */
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_InitStatic(TM_FILTER_MEDIAN_t* instance, uint16_t size, int32_t* Samples, int16_t* Indexes);
+
+/**
+ * @brief  Puts new sample to sliding median filter, oldest sample is removed from window
+ * @param  *instance: Pointer to @ref TM_FILTER_MEDIAN_t instance
+ * @param  sample: New sample
+ * @retval Median of samples in window. For even number of samples, mean of 2 middle samples is returned
+ */
+int32_t TM_FILTER_MEDIAN_Put(TM_FILTER_MEDIAN_t* instance, int32_t sample);
+
+/**
+ * @brief  Gets median of samples in window
+ * @param  *instance: Pointer to @ref TM_FILTER_MEDIAN_t instance
+ * @retval Median of samples in window or 0 if no samples
+ */
+int32_t TM_FILTER_MEDIAN_Get(TM_FILTER_MEDIAN_t* instance);
+
+/**
+ * @brief  Process block of samples through sliding median filter
+ * @param  *instance: Pointer to @ref TM_FILTER_MEDIAN_t instance
+ * @param  *In: Input samples
+ * @param  *Out: Output samples. It can be the same as input array
+ * @param  count: Number of samples
+ * @retval Pointer to @ref TM_FILTER_MEDIAN_t instance
+ */
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Process(TM_FILTER_MEDIAN_t* instance, const int32_t* In, int32_t* Out, size_t count);
+
+/**
+ * @brief  Clears sliding median filter
+ * @param  *instance: Pointer to @ref TM_FILTER_MEDIAN_t instance
+ * @retval Pointer to @ref TM_FILTER_MEDIAN_t instance
+ */
+TM_FILTER_MEDIAN_t* TM_FILTER_MEDIAN_Clear(TM_FILTER_MEDIAN_t* instance);
+
+/**
+ * @brief  Deallocates sliding median filter
+ * @note   Nothing is done for filters initialized with @ref TM_FILTER_MEDIAN_InitStatic
+ * @param  *instance: Pointer to @ref TM_FILTER_MEDIAN_t instance
+ * @retval None 
+ */
+void TM_FILTER_MEDIAN_DeInit(TM_FILTER_MEDIAN_t* instance);
+
+/**
+ * @brief  Initializes fixed point exponential moving average filter
+ * @note   Filter calculates y = y + (x - y) / 2^shift
+ * @param  *instance: Pointer to @ref TM_FILTER_EMA_t structure
+ * @param  shift: Filter factor, alpha = 1 / 2^shift. Input samples must fit to 31 - shift bits
+ * @retval Pointer to @ref TM_FILTER_EMA_t instance
+ */
+TM_FILTER_EMA_t* TM_FILTER_EMA_Init(TM_FILTER_EMA_t* instance, uint8_t shift);
+
+/**
+ * @brief  Puts new sample to exponential moving average filter
+ * @note   First sample initializes filter output to its value
+ * @param  *instance: Pointer to @ref TM_FILTER_EMA_t instance
+ * @param  sample: New sample
+ * @retval Filtered value
+ */
+int32_t TM_FILTER_EMA_Put(TM_FILTER_EMA_t* instance, int32_t sample);
+
+/**
+ * @brief  Initializes CIC decimator
+ * @param  *instance: Pointer to @ref TM_FILTER_CIC_t structure
+ * @param  stages: Number of integrator and comb stages, N. Maximal value is @ref FILTER_CIC_MAX_STAGES
+ * @param  decimation: Decimation factor, R. Use power of 2 for fastest operation
+ * @note   Input range multiplied with gain R^N must fit to int32_t, otherwise output wraps
+ * @retval Pointer to @ref TM_FILTER_CIC_t instance or NULL if parameters are not valid
+ */
+TM_FILTER_CIC_t* TM_FILTER_CIC_Init(TM_FILTER_CIC_t* instance, uint8_t stages, uint16_t decimation);
+
+/**
+ * @brief  Puts new sample to CIC decimator
+ * @param  *instance: Pointer to @ref TM_FILTER_CIC_t instance
+ * @param  sample: New sample
+ * @param  *Out: Pointer to store output sample, normalized with gain R^N and rounded towards minus infinity
+ * @retval Output status:
+ *            - 0: Output is not available yet
+ *            - > 0: New output sample is stored to Out
+ */
+uint8_t TM_FILTER_CIC_Put(TM_FILTER_CIC_t* instance, int32_t sample, int32_t* Out);
+
+/**
+ * @brief  Process block of samples through CIC decimator
+ * @param  *instance: Pointer to @ref TM_FILTER_CIC_t instance
+ * @param  *In: Input samples
+ * @param  *Out: Output samples. It must have space for count / R + 1 samples
+ * @param  count: Number of input samples
+ * @retval Number of output samples stored to Out
+ */
+size_t TM_FILTER_CIC_Process(TM_FILTER_CIC_t* instance, const int32_t* In, int32_t* Out, size_t count);
+
+/**
+ * @brief  Clears CIC decimator
+ * @param  *instance: Pointer to @ref TM_FILTER_CIC_t instance
+ * @retval Pointer to @ref TM_FILTER_CIC_t instance
+ */
+TM_FILTER_CIC_t* TM_FILTER_CIC_Clear(TM_FILTER_CIC_t* instance);
+
 /**
  * @}
  */
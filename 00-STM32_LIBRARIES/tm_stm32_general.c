@@ -153,20 +153,17 @@ uint8_t TM_GENERAL_DWTCounterEnable(void) {
 	}
 	
     /* Enable TRC */
-    CoreDebug->DEMCR &= ~0x01000000;
-    CoreDebug->DEMCR |=  0x01000000;
+    CoreDebug->DEMCR |= 0x01000000;
 
 #if defined(STM32F7xx)
     /* Unclock DWT timer */
     DWT->LAR = 0xC5ACCE55;
 #endif
 
-    /* Enable counter */
-    DWT->CTRL &= ~0x00000001;
-    DWT->CTRL |=  0x00000001;
-	
-    /* Reset counter */
-    DWT->CYCCNT = 0;
+	/* Enable counter if not already, counter is not reset because other libraries use its value */
+	if (!(DWT->CTRL & 0x00000001)) {
+		DWT->CTRL |= 0x00000001;
+	}
 	
 	/* Check if DWT has started */
 	c = DWT->CYCCNT;
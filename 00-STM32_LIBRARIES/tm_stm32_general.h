@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2015/07/hal-library-09-general-for-stm32fxxx/
- * @version v1.1
+ * @version v1.2
  * @ide     Keil uVision
  * @license MIT
  * @brief   GENERAL library for STM32F4xx devices
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_GENERAL_H
-#define TM_GENERAL_H 110
+#define TM_GENERAL_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -77,6 +77,10 @@ extern "C" {
  Version 1.1
   - July 12, 2016
   - DWT counter did not start on STM32F7xx devices
+
+ Version 1.2
+  - October 19, 2026
+  - DWT counter is not reset in TM_GENERAL_DWTCounterEnable, TM CLOCK library uses its value
 \endverbatim
  *
  * \par Dependencies
@@ -25,22 +25,14 @@
  */
 #include "tm_stm32_gps.h"
 
-
-
 /* Is character a digit */
 #define GPS_IS_DIGIT(x)			((x) >= '0' && (x) <= '9')
 
 /* Char 2 digit conversions */
 #define GPS_C2N(a)				(((a) - 48))
-#define GPS_C2NM(a, x)			(C2N(a) * (x))
-#define GPS_CONCAT(x, y)		((x) << 5 | (y))
 
-/* NMEA statements */
-#define GPS_GPGGA				0
-#define GPS_GPRMC				1
-#define GPS_GPGSA				2
-#define GPS_GPGSV				3
-#define GPS_ERR					4
+/* Key from 3 characters of statement formatter, for example "GGA" */
+#define GPS_KEY(a, b, c)		((uint16_t)((((a) - 'A') & 0x1F) << 10 | (((b) - 'A') & 0x1F) << 5 | (((c) - 'A') & 0x1F)))
 
 /* GPGGA Flags */
 #define GPS_FLAG_LATITUDE		0x00000001	//GPGGA
@@ -66,44 +58,6 @@
 #define GPS_FLAG_SATSINVIEW		0x00010000	//GPGSV
 #define GPS_FLAG_SATSDESC       0x00040000  //GPGSV
 
-/* GPGGA Positions */
-#define GPS_POS_LATITUDE		GPS_CONCAT(GPS_GPGGA, 2)	//
-#define GPS_POS_LONGITUDE		GPS_CONCAT(GPS_GPGGA, 4)	//
-#define GPS_POS_SATS			GPS_CONCAT(GPS_GPGGA, 7)	//
-#define GPS_POS_FIX				GPS_CONCAT(GPS_GPGGA, 6)	//
-#define GPS_POS_ALTITUDE		GPS_CONCAT(GPS_GPGGA, 9)	//
-#define GPS_POS_TIME			GPS_CONCAT(GPS_GPGGA, 1)	//
-#define GPS_POS_EW				GPS_CONCAT(GPS_GPGGA, 5)	//
-#define GPS_POS_NS				GPS_CONCAT(GPS_GPGGA, 3)	//
-
-/* GPRMC Positions */
-#define GPS_POS_SPEED			GPS_CONCAT(GPS_GPRMC, 7)	//
-#define GPS_POS_DATE			GPS_CONCAT(GPS_GPRMC, 9)	//
-#define GPS_POS_VALIDITY		GPS_CONCAT(GPS_GPRMC, 2)	//
-#define GPS_POS_DIRECTION		GPS_CONCAT(GPS_GPRMC, 8)	//
-
-/* GPGSA Positions */
-#define GPS_POS_PDOP			GPS_CONCAT(GPS_GPGSA, 15)	//
-#define GPS_POS_HDOP			GPS_CONCAT(GPS_GPGSA, 16)	//
-#define GPS_POS_VDOP			GPS_CONCAT(GPS_GPGSA, 17)	//
-#define GPS_POS_FIXMODE			GPS_CONCAT(GPS_GPGSA, 2)	//
-
-#define GPS_POS_SAT1			GPS_CONCAT(GPS_GPGSA, 3)	//
-#define GPS_POS_SAT2			GPS_CONCAT(GPS_GPGSA, 4)	//
-#define GPS_POS_SAT3			GPS_CONCAT(GPS_GPGSA, 5)	//
-#define GPS_POS_SAT4			GPS_CONCAT(GPS_GPGSA, 6)	//
-#define GPS_POS_SAT5			GPS_CONCAT(GPS_GPGSA, 7)	//
-#define GPS_POS_SAT6			GPS_CONCAT(GPS_GPGSA, 8)	//
-#define GPS_POS_SAT7			GPS_CONCAT(GPS_GPGSA, 9)	//
-#define GPS_POS_SAT8			GPS_CONCAT(GPS_GPGSA, 10)	//
-#define GPS_POS_SAT9			GPS_CONCAT(GPS_GPGSA, 11)	//
-#define GPS_POS_SAT10			GPS_CONCAT(GPS_GPGSA, 12)	//
-#define GPS_POS_SAT11			GPS_CONCAT(GPS_GPGSA, 13)	//
-#define GPS_POS_SAT12			GPS_CONCAT(GPS_GPGSA, 14)	//
-
-/* GPGSV Positions */
-#define GPS_POS_SATSINVIEW		GPS_CONCAT(GPS_GPGSV, 3)	//
-
 /* Earth radius */
 #define GPS_EARTH_RADIUS		6371
 
@@ -111,98 +65,467 @@
 #define GPS_DEGREES2RADIANS(x)	((x) * (float)0.01745329251994)
 /* Radians to degrees */
 #define GPS_RADIANS2DEGREES(x)	((x) * (float)57.29577951308232)
-	
-/* Maximal number of satellites in view */
-#define GPS_MAX_SATS_IN_VIEW    24
-
-/* Internal variables */
-static char GPS_Term[15];
-static uint8_t GPS_Term_Number;
-static uint8_t GPS_Term_Pos;
-static uint8_t TM_GPS_CRC, TM_GPS_CRC_Received;
-static uint8_t TM_GPS_Star;
-static uint8_t TM_GPS_Statement = GPS_ERR;
-static uint32_t GPS_Flags = 0, GPS_Flags_OK;
-static TM_GPS_Data_t TM_GPS_INT_Data;
-static uint8_t TM_GPS_FirstTime;
-static char GPS_Statement_Name[7];
 
-#ifndef GPS_DISABLE_GPGSV
-uint8_t GPGSV_StatementsCount = 0;
-uint8_t GPSGV_StatementNumber = 0;
-uint8_t GPGSV_Term_Number = 0;
-uint8_t GPGSV_Term_Mod = 0;
-#endif
+/* Mean earth radius in meters for fast and haversine distance */
+#define GPS_EARTH_RADIUS_M		6371008.8
+
+/* WGS84 ellipsoid for Vincenty distance */
+#define GPS_WGS84_A				6378137.0
+#define GPS_WGS84_F				(1.0 / 298.257223563)
+#define GPS_WGS84_B				(GPS_WGS84_A * (1.0 - GPS_WGS84_F))
+
+/* Maximal number of iterations for Vincenty distance */
+#define GPS_VINCENTY_ITERATIONS	100
+
+/* Degrees * 10^7 to radians, in float and double */
+#define GPS_E72RADIANS_F(x)		((float)(x) * 1.745329252e-9f)
+#define GPS_E72RADIANS(x)		((double)(x) * 1.745329251994330e-9)
+/* Radians to degrees in double */
+#define GPS_RADIANS2DEGREES_D(x)	((x) * 57.29577951308232)
+
+
+/* Term handler, returns 1 when term flag can be set */
+typedef uint8_t (*TM_GPS_INT_Handler_t)(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P);
+
+/* Field description in statement */
+typedef struct {
+	uint8_t Term;                       /* First term number for this field */
+	uint8_t TermLast;                   /* Last term number for this field */
+	uint8_t CallEmpty;                  /* Set to 1 to call handler on empty term too */
+	uint32_t Flag;                      /* Flag to set when term is received */
+	TM_GPS_INT_Handler_t Handler;       /* Term handler */
+} TM_GPS_INT_Field_t;
+
+/* Statement dispatch table entry */
+typedef struct {
+	uint16_t Key;                       /* Key of statement formatter */
+	const TM_GPS_INT_Field_t* Fields;   /* Fields of statement */
+	uint8_t FieldsCount;                /* Number of fields */
+	uint32_t EndFlag;                   /* Flag set by end handler */
+	TM_GPS_INT_Handler_t End;           /* Called at the end of statement */
+} TM_GPS_INT_Sentence_t;
 
 /* Private */
-TM_GPS_Result_t TM_GPS_INT_Do(TM_GPS_t* GPS_Data, char c);
-void TM_GPS_INT_CheckTerm(TM_GPS_t* GPS_Data);
-TM_GPS_Result_t TM_GPS_INT_Return(TM_GPS_t* GPS_Data);
+static TM_GPS_Result_t TM_GPS_INT_Return(TM_GPS_t* GPS_Data);
+static void TM_GPS_INT_StartTerm(TM_GPS_Parser_t* P);
+static void TM_GPS_INT_AddChar(TM_GPS_t* GPS_Data, char c);
+static void TM_GPS_INT_EndTerm(TM_GPS_t* GPS_Data);
+static const TM_GPS_INT_Sentence_t* TM_GPS_INT_FindSentence(TM_GPS_Parser_t* P);
+static float TM_GPS_INT_Float(TM_GPS_Parser_t* P);
+static int32_t TM_GPS_INT_Coordinate(TM_GPS_Parser_t* P);
+static int32_t TM_GPS_INT_LongitudeDiff(int32_t from, int32_t to);
 uint8_t TM_GPS_INT_StringStartsWith(char* string, const char* str);
-uint8_t TM_GPS_INT_Atoi(char* str, uint32_t* val);
 uint32_t TM_GPS_INT_Pow(uint8_t x, uint8_t y);
 uint8_t TM_GPS_INT_Hex2Dec(char c);
 uint8_t TM_GPS_INT_FlagsOk(TM_GPS_t* GPS_Data);
 void TM_GPS_INT_ClearFlags(TM_GPS_t* GPS_Data);
-void TM_GPS_INT_CheckEmpty(TM_GPS_t* GPS_Data);
 
-#define TM_GPS_INT_Add2CRC(c)                            (TM_GPS_CRC ^= c)
+#define TM_GPS_INT_Add2CRC(P, c)                         ((P)->Checksum ^= (c))
 #define TM_GPS_INT_ReturnWithStatus(GPS_Data, status)    (GPS_Data)->Status = status; return status;
-#define TM_GPS_INT_SetFlag(flag)                         (GPS_Flags |= (flag))
+#define TM_GPS_INT_SetFlag(P, flag)                      ((P)->Flags |= (flag))
 
-/* Public */
-void TM_GPS_Init(TM_GPS_t* GPS_Data, uint32_t baudrate) {
-	/* Initialize USART */
-	GPS_USART_INIT(baudrate);
-	/* Set first-time variable */
-	TM_GPS_FirstTime = 1;
+/* Check if current GSV statement belongs to constellation of started group */
+#define TM_GPS_INT_GSVGroupOk(P)                         ((P)->System < TM_GPS_System_Count && (P)->System == (P)->Work.Sats.System)
+
+/* Check and get character from receiver USART */
+#define TM_GPS_INT_BufferEmpty(GPS_Data)                 ((GPS_Data)->USARTx != NULL ? TM_USART_BufferEmpty((GPS_Data)->USARTx) : GPS_USART_BUFFER_EMPTY)
+#define TM_GPS_INT_GetChar(GPS_Data)                     ((GPS_Data)->USARTx != NULL ? TM_USART_Getc((GPS_Data)->USARTx) : GPS_USART_BUFFER_GET_CHAR)
+
+/* Term handlers */
+#ifndef GPS_DISABLE_GPGGA
+static uint8_t TM_GPS_INT_Latitude(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.LatitudeE7 = TM_GPS_INT_Coordinate(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_NS(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	if (P->First == 'S') {
+		P->Work.LatitudeE7 = -P->Work.LatitudeE7;	/* South has negative coordinate */
+	}
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Longitude(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.LongitudeE7 = TM_GPS_INT_Coordinate(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_EW(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	if (P->First == 'W') {
+		P->Work.LongitudeE7 = -P->Work.LongitudeE7;	/* West has negative coordinate */
+	}
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Sats(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Satellites = P->Int;
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Fix(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Fix = P->Int;
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Altitude(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Altitude = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Time(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Time.Seconds = P->Int % 100;
+	P->Work.Time.Minutes = (P->Int / 100) % 100;
+	P->Work.Time.Hours = (P->Int / 10000) % 100;
 	
-	/* Reset everything */
-	GPS_Data->CustomStatementsCount = 0;
+	/* Hundredths from up to 2 decimal digits */
+	if (P->FracDigits == 1) {
+		P->Work.Time.Hundredths = P->Frac * 10;
+	} else {
+		P->Work.Time.Hundredths = P->Frac / TM_GPS_INT_Pow(10, P->FracDigits > 2 ? P->FracDigits - 2 : 0);
+	}
+	return 1;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_GGA[] = {
+	{1, 1, 0, GPS_FLAG_TIME, TM_GPS_INT_Time},
+	{2, 2, 0, GPS_FLAG_LATITUDE, TM_GPS_INT_Latitude},
+	{3, 3, 0, GPS_FLAG_NS, TM_GPS_INT_NS},
+	{4, 4, 0, GPS_FLAG_LONGITUDE, TM_GPS_INT_Longitude},
+	{5, 5, 0, GPS_FLAG_EW, TM_GPS_INT_EW},
+	{6, 6, 0, GPS_FLAG_FIX, TM_GPS_INT_Fix},
+	{7, 7, 0, GPS_FLAG_SATS, TM_GPS_INT_Sats},
+	{9, 9, 0, GPS_FLAG_ALTITUDE, TM_GPS_INT_Altitude},
+};
+#endif
+
+#ifndef GPS_DISABLE_GPRMC
+static uint8_t TM_GPS_INT_Validity(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Validity = P->First == 'A';
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Speed(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Speed = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Direction(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Direction = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_Date(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.Date.Year = P->Int % 100;
+	P->Work.Date.Month = (P->Int / 100) % 100;
+	P->Work.Date.Date = (P->Int / 10000) % 100;
+	return 1;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_RMC[] = {
+	{2, 2, 0, GPS_FLAG_VALIDITY, TM_GPS_INT_Validity},
+	{7, 7, 0, GPS_FLAG_SPEED, TM_GPS_INT_Speed},
+	{8, 8, 0, GPS_FLAG_DIRECTION, TM_GPS_INT_Direction},
+	{9, 9, 0, GPS_FLAG_DATE, TM_GPS_INT_Date},
+};
+#endif
+
+#ifndef GPS_DISABLE_GPGSA
+static uint8_t TM_GPS_INT_GSAStart(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	/* Clear IDs from previous statement */
+	memset(P->Work.SatelliteIDs, 0, sizeof(P->Work.SatelliteIDs));
+	return 0;
+}
+
+static uint8_t TM_GPS_INT_FixMode(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.FixMode = P->Int;
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_SatIDs(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.SatelliteIDs[P->TermNumber - 3] = P->Int;
+	
+	/* Multi-constellation receivers send more GSA statements with up to 12 IDs, last term is complete */
+	return P->TermNumber == 14;
+}
+
+static uint8_t TM_GPS_INT_PDOP(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.PDOP = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_HDOP(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.HDOP = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_VDOP(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->Work.VDOP = TM_GPS_INT_Float(P);
+	return 1;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_GSA[] = {
+	{1, 1, 1, 0, TM_GPS_INT_GSAStart},
+	{2, 2, 0, GPS_FLAG_FIXMODE, TM_GPS_INT_FixMode},
+	{3, 14, 0, GPS_FLAG_SATS1_12, TM_GPS_INT_SatIDs},
+	{15, 15, 0, GPS_FLAG_PDOP, TM_GPS_INT_PDOP},
+	{16, 16, 0, GPS_FLAG_HDOP, TM_GPS_INT_HDOP},
+	{17, 17, 0, GPS_FLAG_VDOP, TM_GPS_INT_VDOP},
+};
+#endif
+
+#ifndef GPS_DISABLE_GPGSV
+static uint8_t TM_GPS_INT_GSVCount(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->GSVCount = P->Int;
+	return 0;
+}
+
+static uint8_t TM_GPS_INT_GSVNumber(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	P->GSVNumber = P->Int;
+	
+	/* New group of statements for constellation */
+	if (P->GSVNumber == 1) {
+		P->Work.Sats.System = P->System;
+		P->Work.Sats.InView = 0;
+		P->Work.Sats.Count = 0;
+	}
+	return 0;
+}
+
+static uint8_t TM_GPS_INT_SatsInView(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	if (TM_GPS_INT_GSVGroupOk(P)) {
+		P->Work.Sats.InView = P->Int;
+	}
+	return 1;
+}
+
+static uint8_t TM_GPS_INT_SatDesc(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	uint8_t term = P->TermNumber - 4;
+	uint16_t sat;
 	
-	/* Clear all flags */
-	TM_GPS_INT_ClearFlags(GPS_Data);
+	(void)GPS_Data;
 	
-	/* Set flags used */
+	/* Check constellation and statement number */
+	if (!TM_GPS_INT_GSVGroupOk(P) || P->GSVNumber == 0) {
+		return 0;
+	}
+	
+	/* Satellite number in constellation, terms after last satellite (signal ID) are ignored */
+	sat = (P->GSVNumber - 1) * 4 + term / 4;
+	if (sat >= P->Work.Sats.InView || sat >= TM_GPS_SAT_CAPACITY(P->System)) {
+		return 0;
+	}
+	
+	switch (term % 4) {
+		case 0: 
+			P->Work.Sats.ID[sat] = P->Int;
+			P->Work.Sats.Count = sat + 1;
+			break;
+		case 1: P->Work.Sats.Elevation[sat] = P->Int; break;
+		case 2: P->Work.Sats.Azimuth[sat] = P->Int; break;
+		default: P->Work.Sats.SNR[sat] = P->Int; break;
+	}
+	return 0;
+}
+
+static uint8_t TM_GPS_INT_GSVEnd(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	TM_GPS_SatsGroup_t* g = &P->Work.Sats;
+	uint16_t offset;
+	uint8_t i;
+	
+	/* All satellites are received on last statement */
+	if (P->GSVCount != P->GSVNumber || !TM_GPS_INT_GSVGroupOk(P)) {
+		return 0;
+	}
+	
+	/* Update only part of table for this constellation */
+	offset = TM_GPS_SAT_OFFSET(g->System);
+	memcpy(&GPS_Data->Sats.ID[offset], g->ID, g->Count * sizeof(g->ID[0]));
+	memcpy(&GPS_Data->Sats.Elevation[offset], g->Elevation, g->Count * sizeof(g->Elevation[0]));
+	memcpy(&GPS_Data->Sats.Azimuth[offset], g->Azimuth, g->Count * sizeof(g->Azimuth[0]));
+	memcpy(&GPS_Data->Sats.SNR[offset], g->SNR, g->Count * sizeof(g->SNR[0]));
+	GPS_Data->Sats.InView[g->System] = g->InView;
+	GPS_Data->Sats.Count[g->System] = g->Count;
+	g->System = TM_GPS_System_Count;					/* Group is closed */
+	
+	/* Satellites in view for all constellations */
+	GPS_Data->SatellitesInView = 0;
+	for (i = 0; i < TM_GPS_System_Count; i++) {
+		GPS_Data->SatellitesInView += GPS_Data->Sats.InView[i];
+	}
+	return 1;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_GSV[] = {
+	{1, 1, 0, 0, TM_GPS_INT_GSVCount},
+	{2, 2, 0, 0, TM_GPS_INT_GSVNumber},
+	{3, 3, 0, GPS_FLAG_SATSINVIEW, TM_GPS_INT_SatsInView},
+	{4, 19, 1, 0, TM_GPS_INT_SatDesc},
+};
+#endif
+
+#ifndef GPS_DISABLE_VTG
+static uint8_t TM_GPS_INT_VTG(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	switch (P->TermNumber) {
+		case 1: P->Work.VTG.CourseTrue = TM_GPS_INT_Float(P); break;
+		case 3: P->Work.VTG.CourseMagnetic = TM_GPS_INT_Float(P); break;
+		case 5: P->Work.VTG.SpeedKnots = TM_GPS_INT_Float(P); break;
+		default: P->Work.VTG.SpeedKmh = TM_GPS_INT_Float(P); break;
+	}
+	return 0;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_VTG[] = {
+	{1, 1, 0, 0, TM_GPS_INT_VTG},
+	{3, 3, 0, 0, TM_GPS_INT_VTG},
+	{5, 5, 0, 0, TM_GPS_INT_VTG},
+	{7, 7, 0, 0, TM_GPS_INT_VTG},
+};
+#endif
+
+#ifndef GPS_DISABLE_GST
+static uint8_t TM_GPS_INT_GST(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	switch (P->TermNumber) {
+		case 2: P->Work.GST.RMS = TM_GPS_INT_Float(P); break;
+		case 6: P->Work.GST.Latitude = TM_GPS_INT_Float(P); break;
+		case 7: P->Work.GST.Longitude = TM_GPS_INT_Float(P); break;
+		default: P->Work.GST.Altitude = TM_GPS_INT_Float(P); break;
+	}
+	return 0;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_GST[] = {
+	{2, 2, 0, 0, TM_GPS_INT_GST},
+	{6, 8, 0, 0, TM_GPS_INT_GST},
+};
+#endif
+
+#ifndef GPS_DISABLE_ZDA
+static uint8_t TM_GPS_INT_ZDA(TM_GPS_t* GPS_Data, TM_GPS_Parser_t* P) {
+	(void)GPS_Data;
+	switch (P->TermNumber) {
+		case 1: 
+			P->Work.ZDA.Time.Seconds = P->Int % 100;
+			P->Work.ZDA.Time.Minutes = (P->Int / 100) % 100;
+			P->Work.ZDA.Time.Hours = (P->Int / 10000) % 100;
+			P->Work.ZDA.Time.Hundredths = P->FracDigits == 1 ? P->Frac * 10 : P->Frac / TM_GPS_INT_Pow(10, P->FracDigits > 2 ? P->FracDigits - 2 : 0);
+			break;
+		case 2: P->Work.ZDA.Day = P->Int; break;
+		case 3: P->Work.ZDA.Month = P->Int; break;
+		case 4: P->Work.ZDA.Year = P->Int; break;
+		case 5: P->Work.ZDA.ZoneHours = P->Neg ? -(int8_t)P->Int : (int8_t)P->Int; break;
+		default: P->Work.ZDA.ZoneMinutes = P->Int; break;
+	}
+	return 0;
+}
+
+static const TM_GPS_INT_Field_t GPS_Fields_ZDA[] = {
+	{1, 6, 0, 0, TM_GPS_INT_ZDA},
+};
+#endif
+
+/* Statements dispatch table */
+static const TM_GPS_INT_Sentence_t GPS_Sentences[] = {
 #ifndef GPS_DISABLE_GPGGA
-	GPS_Flags_OK |= GPS_FLAG_LATITUDE;
-	GPS_Flags_OK |= GPS_FLAG_NS;
-	GPS_Flags_OK |= GPS_FLAG_LONGITUDE;
-	GPS_Flags_OK |= GPS_FLAG_EW;
-	GPS_Flags_OK |= GPS_FLAG_SATS;
-	GPS_Flags_OK |= GPS_FLAG_FIX;
-	GPS_Flags_OK |= GPS_FLAG_ALTITUDE;
-	GPS_Flags_OK |= GPS_FLAG_TIME;
+	{GPS_KEY('G', 'G', 'A'), GPS_Fields_GGA, sizeof(GPS_Fields_GGA) / sizeof(GPS_Fields_GGA[0]), 0, NULL},
 #endif
 #ifndef GPS_DISABLE_GPRMC
-	GPS_Flags_OK |= GPS_FLAG_SPEED;
-	GPS_Flags_OK |= GPS_FLAG_DATE;
-	GPS_Flags_OK |= GPS_FLAG_VALIDITY;
-	GPS_Flags_OK |= GPS_FLAG_DIRECTION;
+	{GPS_KEY('R', 'M', 'C'), GPS_Fields_RMC, sizeof(GPS_Fields_RMC) / sizeof(GPS_Fields_RMC[0]), 0, NULL},
 #endif
 #ifndef GPS_DISABLE_GPGSA
-	GPS_Flags_OK |= GPS_FLAG_HDOP;
-	GPS_Flags_OK |= GPS_FLAG_VDOP;
-	GPS_Flags_OK |= GPS_FLAG_PDOP;
-	GPS_Flags_OK |= GPS_FLAG_FIXMODE;
-	GPS_Flags_OK |= GPS_FLAG_SATS1_12;
+	{GPS_KEY('G', 'S', 'A'), GPS_Fields_GSA, sizeof(GPS_Fields_GSA) / sizeof(GPS_Fields_GSA[0]), 0, NULL},
+#endif
+#ifndef GPS_DISABLE_GPGSV
+	{GPS_KEY('G', 'S', 'V'), GPS_Fields_GSV, sizeof(GPS_Fields_GSV) / sizeof(GPS_Fields_GSV[0]), GPS_FLAG_SATSDESC, TM_GPS_INT_GSVEnd},
+#endif
+#ifndef GPS_DISABLE_VTG
+	{GPS_KEY('V', 'T', 'G'), GPS_Fields_VTG, sizeof(GPS_Fields_VTG) / sizeof(GPS_Fields_VTG[0]), 0, NULL},
 #endif
-#ifndef GPS_DISABLE_GPGSV	
-	GPS_Flags_OK |= GPS_FLAG_SATSINVIEW;
-	GPS_Flags_OK |= GPS_FLAG_SATSDESC;
+#ifndef GPS_DISABLE_GST
+	{GPS_KEY('G', 'S', 'T'), GPS_Fields_GST, sizeof(GPS_Fields_GST) / sizeof(GPS_Fields_GST[0]), 0, NULL},
+#endif
+#ifndef GPS_DISABLE_ZDA
+	{GPS_KEY('Z', 'D', 'A'), GPS_Fields_ZDA, sizeof(GPS_Fields_ZDA) / sizeof(GPS_Fields_ZDA[0]), 0, NULL},
+#endif
+	{0, NULL, 0, 0, NULL}
+};
+
+/* Public */
+void TM_GPS_Init(TM_GPS_t* GPS_Data, uint32_t baudrate) {
+	/* Initialize USART */
+	GPS_USART_INIT(baudrate);
+	
+	/* Initialize parser, use default USART */
+	TM_GPS_InitParser(GPS_Data);
+}
+
+void TM_GPS_InitUSART(TM_GPS_t* GPS_Data, USART_TypeDef* USARTx, TM_USART_PinsPack_t pinspack, uint32_t baudrate) {
+	/* Initialize USART */
+	TM_USART_Init(USARTx, pinspack, baudrate);
+	
+	/* Initialize parser and save USART */
+	TM_GPS_InitParser(GPS_Data);
+	GPS_Data->USARTx = USARTx;
+	GPS_Data->PinsPack = pinspack;
+}
+
+void TM_GPS_InitParser(TM_GPS_t* GPS_Data) {
+	const TM_GPS_INT_Sentence_t* s;
+	uint8_t i;
+	
+	/* Reset everything */
+	memset(&GPS_Data->Parser, 0, sizeof(GPS_Data->Parser));
+	GPS_Data->CustomStatementsCount = 0;
+#ifndef GPS_DISABLE_GPGSV
+	GPS_Data->Parser.Work.Sats.System = TM_GPS_System_Count;	/* No GSV group started */
 #endif
+	GPS_Data->USARTx = NULL;
+	GPS_Data->Status = TM_GPS_Result_FirstDataWaiting;
+	
+	/* Set first-time variable */
+	GPS_Data->Parser.FirstTime = 1;
+	
+	/* Set flags used by enabled statements */
+	for (s = GPS_Sentences; s->Fields != NULL; s++) {
+		for (i = 0; i < s->FieldsCount; i++) {
+			GPS_Data->Parser.FlagsOK |= s->Fields[i].Flag;
+		}
+		GPS_Data->Parser.FlagsOK |= s->EndFlag;
+	}
 }
 
 TM_GPS_Result_t TM_GPS_Update(TM_GPS_t* GPS_Data) {
 	/* Check for data in USART */
-	while (!GPS_USART_BUFFER_EMPTY) {
-		TM_GPS_INT_Do(GPS_Data, (char)GPS_USART_BUFFER_GET_CHAR);
+	while (!TM_GPS_INT_BufferEmpty(GPS_Data)) {
+		TM_GPS_ParseChar(GPS_Data, (char)TM_GPS_INT_GetChar(GPS_Data));
 		if (GPS_Data->Status == TM_GPS_Result_NewData) {
 			return GPS_Data->Status;
 		}
 	}
 	
-	if (TM_GPS_FirstTime) {
+	if (GPS_Data->Parser.FirstTime) {
 		/* No any valid data, return First Data Waiting */
 		/* Returning only after power up and calling when no all data is received */
 		TM_GPS_INT_ReturnWithStatus(GPS_Data, TM_GPS_Result_FirstDataWaiting);
@@ -212,6 +535,57 @@ TM_GPS_Result_t TM_GPS_Update(TM_GPS_t* GPS_Data) {
 	TM_GPS_INT_ReturnWithStatus(GPS_Data, TM_GPS_Result_OldData);
 }
 
+TM_GPS_Result_t TM_GPS_ParseChar(TM_GPS_t* GPS_Data, char c) {
+	TM_GPS_Parser_t* P = &GPS_Data->Parser;
+	const TM_GPS_INT_Sentence_t* s;
+	
+	if (TM_GPS_INT_FlagsOk(GPS_Data)) {
+		TM_GPS_INT_ClearFlags(GPS_Data);				/* Data were valid before, new data are coming, not new anymore */
+		GPS_Data->Status = TM_GPS_Result_OldData;		/* Data were "new" on last call, now are only "Old data", no NEW data */
+	}
+	if (c == '$') {										/* Start of string detected */
+		P->Star = 0;									/* Star detection reset */
+		P->Checksum = 0;								/* Reset checksum */
+		P->ChecksumReceived = 0;
+		P->TermNumber = 0;								/* First term in new statement */
+		P->Key = 0;
+		P->Sentence = NULL;
+		P->CustomMatch = 0;
+		TM_GPS_INT_StartTerm(P);						/* At position 0 of a first term */
+		P->Name[P->TermPos++] = c;						/* Add character to statement name */
+	} else if (c == ',' || c == '*') {
+		if (c == ',') {
+			TM_GPS_INT_Add2CRC(P, c);					/* Add to parity */
+		} else {
+			P->Star = 1;								/* Star detected */
+		}
+		TM_GPS_INT_EndTerm(GPS_Data);					/* Process term */
+		P->TermNumber++;								/* Increase term number */
+		TM_GPS_INT_StartTerm(P);						/* At position 0 of next term */
+	} else if (c == '\n') {
+		/* Call end of statement handler */
+		s = (const TM_GPS_INT_Sentence_t *)P->Sentence;
+		if (s != NULL && s->End != NULL && s->End(GPS_Data, P)) {
+			TM_GPS_INT_SetFlag(P, s->EndFlag);
+		}
+		P->Sentence = NULL;
+		P->TermNumber = 0;								/* Reset term number */
+	} else if (c == '\r') {
+		if (P->ChecksumReceived != P->Checksum) {	/* CRC is not OK, data failed somewhere */
+			TM_GPS_INT_ClearFlags(GPS_Data);			/* Clear all flags */
+			P->Sentence = NULL;							/* Ignore end of statement */
+		}
+		P->TermNumber = 0;								/* Reset term number */
+	} else if (P->Star) {
+		/* Between * and \r are 2 characters of checksum */
+		P->ChecksumReceived = (P->ChecksumReceived << 4) | TM_GPS_INT_Hex2Dec(c);
+	} else {
+		TM_GPS_INT_Add2CRC(P, c);						/* Add to parity */
+		TM_GPS_INT_AddChar(GPS_Data, c);				/* Add to term */
+	}
+	return TM_GPS_INT_Return(GPS_Data);					/* Return current GPS status */
+}
+
 TM_GPS_Custom_t * TM_GPS_AddCustom(TM_GPS_t* GPS_Data, char* GPG_Statement, uint8_t TermNumber) {
 	TM_GPS_Custom_t * temp;
 	
@@ -306,350 +680,362 @@ void TM_GPS_DistanceBetween(TM_GPS_Distance_t* Distance_Data) {
 	}
 }
 
-/* Private */
-TM_GPS_Result_t TM_GPS_INT_Do(TM_GPS_t* GPS_Data, char c) {
-	if (TM_GPS_INT_FlagsOk(GPS_Data)) {
-		TM_GPS_INT_ClearFlags(GPS_Data);				/* Data were valid before, new data are coming, not new anymore */
-		GPS_Data->Status = TM_GPS_Result_OldData;		/* Data were "new" on last call, now are only "Old data", no NEW data */
-	}
-	if (c == '$') {										/* Start of string detected */
-		TM_GPS_Star = 0;								/* Star detection reset */
-		TM_GPS_CRC = 0;									/* Reset CRC */
-		GPS_Term_Number = 0;							/* First term in new statement */
-		GPS_Term_Pos = 0;								/* At position 0 of a first term */
-		GPS_Term[GPS_Term_Pos++] = c;					/* Add character to first term */
-	} else if (c == ',') {
-		TM_GPS_INT_Add2CRC(c);							/* Add to parity */
-		GPS_Term[GPS_Term_Pos++] = 0;					/* End of term */
-		TM_GPS_INT_CheckEmpty(GPS_Data);				/* Check if term is empty */
-		TM_GPS_INT_CheckTerm(GPS_Data);					/* Check term */
-		GPS_Term_Number++;								/* Increase term number */
-		GPS_Term_Pos = 0;								/* At position 0 of a first term */
-	} else if (c == '\n') {
-		GPS_Term_Number = 0;							/* Reset term number */
-#ifndef GPS_DISABLE_GPGSV
-		/* Check for GPGSV statement */
-		if (TM_GPS_Statement == GPS_GPGSV && GPGSV_StatementsCount == GPSGV_StatementNumber) {
-			TM_GPS_INT_SetFlag(GPS_FLAG_SATSDESC);		/* Set flag */
+float TM_GPS_DistanceFast(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, float* Bearing) {
+	float distance;
+	
+	/* Calculate for one point */
+	TM_GPS_DistanceFastMany(From, To, &distance, Bearing, 1);
+	return distance;
+}
+
+void TM_GPS_DistanceFastMany(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, float* Distances, float* Bearings, uint16_t count) {
+	float lat, c, s, x, y, b;
+	uint16_t i;
+	
+	/* Values of starting point, only once */
+	lat = GPS_E72RADIANS_F(From->LatitudeE7);
+	c = cosf(lat);
+	s = sinf(lat);
+	
+	for (i = 0; i < count; i++) {
+		/* Differences as integers, only small values are converted to float */
+		y = GPS_E72RADIANS_F(To[i].LatitudeE7 - From->LatitudeE7);
+		x = GPS_E72RADIANS_F(TM_GPS_INT_LongitudeDiff(From->LongitudeE7, To[i].LongitudeE7));
+		
+		/* Cosine of mean latitude, cos(lat + y / 2) with first order approximation */
+		x *= c - s * y * 0.5f;
+		
+		/* Distance on plane */
+		Distances[i] = (float)GPS_EARTH_RADIUS_M * sqrtf(x * x + y * y);
+		
+		/* Bearing from 0 to 360 degrees */
+		if (Bearings != NULL) {
+			b = GPS_RADIANS2DEGREES(atan2f(x, y));
+			Bearings[i] = b < 0 ? b + 360 : b;
 		}
-#endif
-	} else if (c == '\r') {
-		GPS_Term[GPS_Term_Pos++] = 0;					/* End of character string */
-		TM_GPS_CRC_Received = TM_GPS_INT_Hex2Dec(GPS_Term[0]) * 16 + TM_GPS_INT_Hex2Dec(GPS_Term[1]);	/* Between * and \r are 2 characters of Checksum */
-		if (TM_GPS_CRC_Received != TM_GPS_CRC) {		/* CRC is not OK, data failed somewhere */			
-			TM_GPS_INT_ClearFlags(GPS_Data);			/* Clear all flags */
+	}
+}
+
+double TM_GPS_DistanceHaversine(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Bearing) {
+	double distance;
+	
+	/* Calculate for one point */
+	TM_GPS_DistanceHaversineMany(From, To, &distance, Bearing, 1);
+	return distance;
+}
+
+void TM_GPS_DistanceHaversineMany(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Distances, double* Bearings, uint16_t count) {
+	double c1, s1, c2, s2, dlat, dlon, a, b;
+	uint16_t i;
+	
+	/* Values of starting point, only once */
+	a = GPS_E72RADIANS(From->LatitudeE7);
+	c1 = cos(a);
+	s1 = sin(a);
+	
+	for (i = 0; i < count; i++) {
+		a = GPS_E72RADIANS(To[i].LatitudeE7);
+		c2 = cos(a);
+		s2 = sin(a);
+		dlat = GPS_E72RADIANS(To[i].LatitudeE7 - From->LatitudeE7);
+		dlon = GPS_E72RADIANS(TM_GPS_INT_LongitudeDiff(From->LongitudeE7, To[i].LongitudeE7));
+		
+		/* Haversine formula */
+		a = sin(dlat * 0.5) * sin(dlat * 0.5) + c1 * c2 * sin(dlon * 0.5) * sin(dlon * 0.5);
+		Distances[i] = GPS_EARTH_RADIUS_M * 2 * atan2(sqrt(a), sqrt(1 - a));
+		
+		/* Initial bearing from 0 to 360 degrees */
+		if (Bearings != NULL) {
+			b = GPS_RADIANS2DEGREES_D(atan2(sin(dlon) * c2, c1 * s2 - s1 * c2 * cos(dlon)));
+			Bearings[i] = b < 0 ? b + 360 : b;
 		}
-		GPS_Term_Number = 0;							/* Reset term number */
-	} else if (c == '*') {
-		TM_GPS_Star = 1;								/* Star detected */
-		GPS_Term[GPS_Term_Pos++] = 0;					/* Add 0 at the end */
-		TM_GPS_INT_CheckEmpty(GPS_Data);				/* Check empty */
-		TM_GPS_INT_CheckTerm(GPS_Data);					/* Check term */		
-		GPS_Term_Number++;								/* Increase term number */
-		GPS_Term_Pos = 0;								/* At position 0 of a first term */
-	} else {
-		/* Other characters detected */
-		if (!TM_GPS_Star) {								/* If star is not detected yet */
-			TM_GPS_INT_Add2CRC(c);						/* Add to parity */
+	}
+}
+
+double TM_GPS_DistanceVincenty(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Bearing) {
+	double L, U1, U2, sinU1, cosU1, sinU2, cosU2;
+	double lambda, lambdaP, sinLambda, cosLambda;
+	double sinSigma, cosSigma, sigma, sinAlpha, cos2Alpha, cos2SigmaM, C;
+	double u2, A, B, deltaSigma, b;
+	uint8_t iter = 0;
+	
+	/* Reduced latitudes */
+	L = GPS_E72RADIANS(TM_GPS_INT_LongitudeDiff(From->LongitudeE7, To->LongitudeE7));
+	U1 = atan((1 - GPS_WGS84_F) * tan(GPS_E72RADIANS(From->LatitudeE7)));
+	U2 = atan((1 - GPS_WGS84_F) * tan(GPS_E72RADIANS(To->LatitudeE7)));
+	sinU1 = sin(U1);
+	cosU1 = cos(U1);
+	sinU2 = sin(U2);
+	cosU2 = cos(U2);
+	
+	/* Iterate until change in lambda is negligible */
+	lambda = L;
+	do {
+		sinLambda = sin(lambda);
+		cosLambda = cos(lambda);
+		sinSigma = sqrt((cosU2 * sinLambda) * (cosU2 * sinLambda) +
+			(cosU1 * sinU2 - sinU1 * cosU2 * cosLambda) * (cosU1 * sinU2 - sinU1 * cosU2 * cosLambda));
+		if (sinSigma == 0) {
+			/* Coincident points */
+			if (Bearing != NULL) {
+				*Bearing = 0;
+			}
+			return 0;
 		}
-		GPS_Term[GPS_Term_Pos++] = c;					/* Add to term */
+		cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+		sigma = atan2(sinSigma, cosSigma);
+		sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+		cos2Alpha = 1 - sinAlpha * sinAlpha;
+		cos2SigmaM = cos2Alpha != 0 ? cosSigma - 2 * sinU1 * sinU2 / cos2Alpha : 0;	/* Equatorial line */
+		C = GPS_WGS84_F / 16 * cos2Alpha * (4 + GPS_WGS84_F * (4 - 3 * cos2Alpha));
+		lambdaP = lambda;
+		lambda = L + (1 - C) * GPS_WGS84_F * sinAlpha *
+			(sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+	} while (fabs(lambda - lambdaP) > 1e-12 && ++iter < GPS_VINCENTY_ITERATIONS);
+	
+	/* Failed to converge */
+	if (fabs(lambda - lambdaP) > 1e-12) {
+		return -1;
 	}
-	return TM_GPS_INT_Return(GPS_Data);					/* Return current GPS status */
+	
+	/* Distance on ellipsoid */
+	u2 = cos2Alpha * (GPS_WGS84_A * GPS_WGS84_A - GPS_WGS84_B * GPS_WGS84_B) / (GPS_WGS84_B * GPS_WGS84_B);
+	A = 1 + u2 / 16384 * (4096 + u2 * (-768 + u2 * (320 - 175 * u2)));
+	B = u2 / 1024 * (256 + u2 * (-128 + u2 * (74 - 47 * u2)));
+	deltaSigma = B * sinSigma * (cos2SigmaM + B / 4 * (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM) -
+		B / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma) * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+	
+	/* Initial bearing from 0 to 360 degrees */
+	if (Bearing != NULL) {
+		b = GPS_RADIANS2DEGREES_D(atan2(cosU2 * sinLambda, cosU1 * sinU2 - sinU1 * cosU2 * cosLambda));
+		*Bearing = b < 0 ? b + 360 : b;
+	}
+	
+	return GPS_WGS84_B * A * (sigma - deltaSigma);
 }
 
-void TM_GPS_INT_CheckTerm(TM_GPS_t* GPS_Data) {
-	uint32_t temp;
-#ifndef GPS_DISABLE_GPGSA
-	static uint8_t ids_count = 0;
-#endif
-	uint8_t count, i;
-	if (GPS_Term_Number == 0) {
-		/* Statement indicator */
-		if (TM_GPS_INT_StringStartsWith(GPS_Term, "$GPGGA")) {
-			TM_GPS_Statement = GPS_GPGGA;
-		} else if (TM_GPS_INT_StringStartsWith(GPS_Term, "$GPRMC")) {
-			TM_GPS_Statement = GPS_GPRMC;
-		} else if (TM_GPS_INT_StringStartsWith(GPS_Term, "$GPGSA")) {
-			TM_GPS_Statement = GPS_GPGSA;
-		} else if (TM_GPS_INT_StringStartsWith(GPS_Term, "$GPGSV")) {
-			TM_GPS_Statement = GPS_GPGSV;
-		} else {
-			TM_GPS_Statement = GPS_ERR;
+/* Private */
+static void TM_GPS_INT_StartTerm(TM_GPS_Parser_t* P) {
+	/* Reset values for new term */
+	P->TermPos = 0;
+	P->Int = 0;
+	P->Frac = 0;
+	P->FracDigits = 0;
+	P->Dot = 0;
+	P->Neg = 0;
+	P->First = 0;
+}
+
+static void TM_GPS_INT_AddChar(TM_GPS_t* GPS_Data, char c) {
+	TM_GPS_Parser_t* P = &GPS_Data->Parser;
+	uint8_t i;
+	
+	/* Statement name */
+	if (P->TermNumber == 0) {
+		if (P->TermPos < sizeof(P->Name) - 1) {
+			P->Name[P->TermPos] = c;
 		}
-		
-		strcpy(GPS_Statement_Name, GPS_Term);			/* Copy term to variable */
-		return;											/* Do nothing */
-	}
-	
-	/* Check custom terms one by one */
-	for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {
-		/* Term is inside current statement */
-		if (TM_GPS_INT_StringStartsWith(GPS_Statement_Name, GPS_Data->CustomStatements[i]->Statement)) {
-			/* Term number is correct */
-			if (GPS_Term_Number == GPS_Data->CustomStatements[i]->TermNumber) {
-				/* Copy string value */
-				strcpy(GPS_Data->CustomStatements[i]->Value, GPS_Term);
-				
-				/* Set updated flag */
-				GPS_Data->CustomStatements[i]->Updated = 1;
+		/* Formatter characters are used for statement key */
+		if (P->TermPos >= 3 && P->TermPos <= 5) {
+			P->Key = (P->Key << 5) | ((c - 'A') & 0x1F);
+		}
+		P->TermPos++;
+		return;
+	}
+	
+	/* Parse number in place */
+	if (GPS_IS_DIGIT(c)) {
+		if (!P->Dot) {
+			P->Int = P->Int * 10 + GPS_C2N(c);
+		} else if (P->FracDigits < 9) {
+			P->Frac = P->Frac * 10 + GPS_C2N(c);
+			P->FracDigits++;
+		}
+	} else if (c == '.') {
+		P->Dot = 1;
+	} else if (c == '-' && P->TermPos == 0) {
+		P->Neg = 1;
+	}
+	if (P->TermPos == 0) {
+		P->First = c;
+	}
+	
+	/* Copy to custom statements */
+	if (P->CustomMatch) {
+		for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {
+			if ((P->CustomMatch & (1UL << i)) && GPS_Data->CustomStatements[i]->TermNumber == P->TermNumber && P->TermPos < sizeof(GPS_Data->CustomStatements[i]->Value) - 1) {
+				GPS_Data->CustomStatements[i]->Value[P->TermPos] = c;
 			}
 		}
 	}
+	P->TermPos++;
+}
+
+static void TM_GPS_INT_EndTerm(TM_GPS_t* GPS_Data) {
+	TM_GPS_Parser_t* P = &GPS_Data->Parser;
+	const TM_GPS_INT_Sentence_t* s;
+	const TM_GPS_INT_Field_t* f;
+	uint8_t i, pos;
 	
-	switch (GPS_CONCAT(TM_GPS_Statement, GPS_Term_Number)) {
-#ifndef GPS_DISABLE_GPGGA
-		case GPS_POS_LATITUDE:	/* GPGGA */
-			/* Convert latitude */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Latitude = temp / 100;
-			TM_GPS_INT_Data.Latitude += (float)(temp % 100) / (float)60;
+	if (P->TermNumber == 0) {
+		/* End of statement name */
+		P->Name[P->TermPos < sizeof(P->Name) ? P->TermPos : sizeof(P->Name) - 1] = 0;
 		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.Latitude += temp / (TM_GPS_INT_Pow(10, count) * 60.0);
-			TM_GPS_INT_SetFlag(GPS_FLAG_LATITUDE);
-			break;
-		case GPS_POS_NS: /* GPGGA */
-			if (GPS_Term[0] == 'S') {
-				TM_GPS_INT_Data.Latitude = -TM_GPS_INT_Data.Latitude;	/* South has negative coordinate */
-			}
-			TM_GPS_INT_SetFlag(GPS_FLAG_NS);
-			break;
-		case GPS_POS_LONGITUDE: /* GPGGA */
-			/* Convert longitude */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Longitude = temp / 100; /* Degrees */
-			TM_GPS_INT_Data.Longitude += (float)(temp % 100) / (float)60;
+		/* Find statement in dispatch table */
+		P->Sentence = TM_GPS_INT_FindSentence(P);
 		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.Longitude += temp / (TM_GPS_INT_Pow(10, count) * 60.0);
-			TM_GPS_INT_SetFlag(GPS_FLAG_LONGITUDE);
-			break;
-		case GPS_POS_EW: /* GPGGA */
-			if (GPS_Term[0] == 'W') {
-				TM_GPS_INT_Data.Longitude = -TM_GPS_INT_Data.Longitude;	/* West has negative coordinate */
+		/* Check custom statements once per statement */
+		for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {
+			if (TM_GPS_INT_StringStartsWith(P->Name, GPS_Data->CustomStatements[i]->Statement)) {
+				P->CustomMatch |= 1UL << i;
 			}
-			TM_GPS_INT_SetFlag(GPS_FLAG_EW);
-			break;
-		case GPS_POS_SATS: /* GPGGA */
-			/* Satellites in use */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Satellites = temp;
-			TM_GPS_INT_SetFlag(GPS_FLAG_SATS);
-			break;
-		case GPS_POS_FIX: /* GPGGA */
-			/* GPS Fix */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Fix = temp;
-			TM_GPS_INT_SetFlag(GPS_FLAG_FIX);
-			break;
-		case GPS_POS_ALTITUDE: /* GPGGA */
-			/* Convert altitude above sea */
-			if (GPS_Term[0] == '-') {
-				count = TM_GPS_INT_Atoi(&GPS_Term[1], &temp);
-				TM_GPS_INT_Data.Altitude = temp;
-				
-				count++;
-				count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-				TM_GPS_INT_Data.Altitude += temp / (TM_GPS_INT_Pow(10, count) * 1.0);
-				
-				TM_GPS_INT_Data.Altitude = -TM_GPS_INT_Data.Altitude;
-			} else {
-				count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-				TM_GPS_INT_Data.Altitude = temp;
-		
-				count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-				TM_GPS_INT_Data.Altitude += temp / (TM_GPS_INT_Pow(10, count) * 1.0);
+		}
+		return;
+	}
+	
+	/* Finish custom values */
+	if (P->CustomMatch) {
+		for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {
+			if ((P->CustomMatch & (1UL << i)) && GPS_Data->CustomStatements[i]->TermNumber == P->TermNumber) {
+				pos = P->TermPos < sizeof(GPS_Data->CustomStatements[i]->Value) ? P->TermPos : sizeof(GPS_Data->CustomStatements[i]->Value) - 1;
+				GPS_Data->CustomStatements[i]->Value[pos] = 0;
+				GPS_Data->CustomStatements[i]->Updated = 1;
 			}
-			TM_GPS_INT_SetFlag(GPS_FLAG_ALTITUDE);
-			break;
-		case GPS_POS_TIME: /* GPGGA */
-			/* Set time */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Time.Seconds = temp % 100;
-			TM_GPS_INT_Data.Time.Minutes = (int)(temp * (float) 0.01) % 100;
-			TM_GPS_INT_Data.Time.Hours = (int)(temp * (float)0.0001) % 100;
-			/* Hundredths */
-			TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.Time.Hundredths = temp;
-			TM_GPS_INT_SetFlag(GPS_FLAG_TIME);
-			break;
-#endif
-#ifndef GPS_DISABLE_GPRMC
-		case GPS_POS_SPEED:	/* GPRMC */	
-			/* Convert speed */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Speed = (float)temp;
-		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.Speed += (float)((float)temp / (TM_GPS_INT_Pow(10, count) * 1.0));
-		
-			/* Set flag */
-			TM_GPS_INT_SetFlag(GPS_FLAG_SPEED);
-			break;
-		case GPS_POS_DATE: /* GPRMC */	
-			/* Set date */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Date.Year = temp % 100;
-			TM_GPS_INT_Data.Date.Month = (int)(temp * 0.01f) % 100;
-			TM_GPS_INT_Data.Date.Date = (int)(temp * 0.0001f) % 100;
-			TM_GPS_INT_SetFlag(GPS_FLAG_DATE);
-			break;
-		case GPS_POS_VALIDITY: /* GPRMC */	
-			/* GPS valid status */
-			TM_GPS_INT_Data.Validity = GPS_Term[0] == 'A';
-			TM_GPS_INT_SetFlag(GPS_FLAG_VALIDITY);
-			break;
-		case GPS_POS_DIRECTION: /* GPRMC */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.Direction = (float)temp;
-		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.Direction += (float)((float)temp / (TM_GPS_INT_Pow(10, count) * 1.0f));
-			TM_GPS_INT_SetFlag(GPS_FLAG_DIRECTION);
-			break;
-#endif
-#ifndef GPS_DISABLE_GPGSA
-		case GPS_POS_HDOP: /* GPGSA */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.HDOP = (float)temp;
-		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.HDOP += (float)((float)temp / (TM_GPS_INT_Pow(10, count) * 1.0f));
-			TM_GPS_INT_SetFlag(GPS_FLAG_HDOP);
-			break;
-		case GPS_POS_PDOP: /* GPGSA */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.PDOP = (float)temp;
-		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.PDOP += (float)((float)temp / (TM_GPS_INT_Pow(10, count) * 1.0f));
-			TM_GPS_INT_SetFlag(GPS_FLAG_PDOP);
-			break;
-		case GPS_POS_VDOP: /* GPGSA */
-			count = TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.VDOP = (float)temp;
-		
-			count = TM_GPS_INT_Atoi(&GPS_Term[++count], &temp);
-			TM_GPS_INT_Data.VDOP += (float)((float)temp / (TM_GPS_INT_Pow(10, count) * 1.0f));
-			TM_GPS_INT_SetFlag(GPS_FLAG_VDOP);
-			break;
-		case GPS_POS_FIXMODE: /* GPGSA */
-			/* Satellites in view */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.FixMode = temp;
-			TM_GPS_INT_SetFlag(GPS_FLAG_FIXMODE);
-			break;
-		case GPS_POS_SAT1:
-		case GPS_POS_SAT2:
-		case GPS_POS_SAT3:
-		case GPS_POS_SAT4:
-		case GPS_POS_SAT5:
-		case GPS_POS_SAT6:
-		case GPS_POS_SAT7:
-		case GPS_POS_SAT8:
-		case GPS_POS_SAT9:
-		case GPS_POS_SAT10:
-		case GPS_POS_SAT11:
-		case GPS_POS_SAT12:
-			/* Satellite numbers */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.SatelliteIDs[GPS_Term_Number - 3] = temp;
-			ids_count++;							/* Increase number of satellites found */
-		
-			if (ids_count == TM_GPS_INT_Data.Satellites) {
-				ids_count = 0;						/* Reset count, we have all statements */
-				TM_GPS_INT_SetFlag(GPS_FLAG_SATS1_12);
+		}
+	}
+	
+	/* Unknown statement */
+	s = (const TM_GPS_INT_Sentence_t *)P->Sentence;
+	if (s == NULL) {
+		return;
+	}
+	
+	/* Find field for term and call its handler */
+	for (f = s->Fields; f < &s->Fields[s->FieldsCount]; f++) {
+		if (P->TermNumber >= f->Term && P->TermNumber <= f->TermLast) {
+			if (P->TermPos == 0 && !f->CallEmpty) {
+				TM_GPS_INT_SetFlag(P, f->Flag);			/* Empty term is valid too */
+			} else if (f->Handler(GPS_Data, P)) {
+				TM_GPS_INT_SetFlag(P, f->Flag);
 			}
 			break;
-#endif
-#ifndef GPS_DISABLE_GPGSV
-		case GPS_POS_SATSINVIEW: /* GPGSV */
-			/* Satellites in view */
-			TM_GPS_INT_Atoi(GPS_Term, &temp);
-			TM_GPS_INT_Data.SatellitesInView = temp;
-			TM_GPS_INT_SetFlag(GPS_FLAG_SATSINVIEW);
-			break;
-#endif
-		default: 
-			break;
+		}
 	}
+}
+
+static const TM_GPS_INT_Sentence_t* TM_GPS_INT_FindSentence(TM_GPS_Parser_t* P) {
+	const TM_GPS_INT_Sentence_t* s;
 	
-#ifndef GPS_DISABLE_GPGSV
-	/* Check for GPGSV statement separatelly */
-	if (TM_GPS_Statement == GPS_GPGSV) {	
-		if (GPS_Term_Number == 1) {
-			TM_GPS_INT_Atoi(GPS_Term, &temp);			/* Save number of GPGSV statements */
-			GPGSV_StatementsCount = temp;
-		}
-		if (GPS_Term_Number == 2) {
-			TM_GPS_INT_Atoi(GPS_Term, &temp);			/* Save current of GPGSV statement number */
-			GPSGV_StatementNumber = temp;
+	/* Address must be 5 characters long */
+	if (P->TermPos != 6) {
+		return NULL;
+	}
+	
+	/* Get constellation from talker */
+	if (P->Name[1] == 'G') {
+		switch (P->Name[2]) {
+			case 'P': P->System = TM_GPS_System_GPS; break;
+			case 'L': P->System = TM_GPS_System_GLONASS; break;
+			case 'A': P->System = TM_GPS_System_Galileo; break;
+			case 'B': P->System = TM_GPS_System_BeiDou; break;
+			case 'N': P->System = TM_GPS_System_Count; break;
+			default: return NULL;
 		}
-		
-		/* Data */
-		if (GPS_Term_Number >= 4) {
-			TM_GPS_INT_Atoi(GPS_Term, &temp);			/* Convert to number */
-			
-			GPGSV_Term_Number = GPS_Term_Number - 4;	/* Get proper value */
-			GPGSV_Term_Mod = GPGSV_Term_Number % 4;
-			GPGSV_Term_Number = (GPSGV_StatementNumber - 1) * 4 + (GPGSV_Term_Number / 4);
-			
-			if (GPGSV_Term_Number < GPS_MAX_SATS_IN_VIEW) {	/* If still memory available */
-				/* Check offset from 4 */
-				if (GPGSV_Term_Mod == 0) {
-					TM_GPS_INT_Data.SatDesc[GPGSV_Term_Number].ID = temp;
-				} else if (GPGSV_Term_Mod == 1) {
-					TM_GPS_INT_Data.SatDesc[GPGSV_Term_Number].Elevation = temp;
-				} else if (GPGSV_Term_Mod == 2) {
-					TM_GPS_INT_Data.SatDesc[GPGSV_Term_Number].Azimuth = temp;
-				} else if (GPGSV_Term_Mod == 3) {
-					TM_GPS_INT_Data.SatDesc[GPGSV_Term_Number].SNR = temp;
-				}
-			}
+	} else if (P->Name[1] == 'B' && P->Name[2] == 'D') {
+		P->System = TM_GPS_System_BeiDou;
+	} else {
+		return NULL;
+	}
+	
+	/* Compare keys */
+	for (s = GPS_Sentences; s->Fields != NULL; s++) {
+		if (s->Key == P->Key) {
+			return s;
 		}
 	}
-#endif
+	return NULL;
+}
+
+static float TM_GPS_INT_Float(TM_GPS_Parser_t* P) {
+	float val;
+	
+	/* Integer and decimal part */
+	val = (float)P->Int + (float)P->Frac / (float)TM_GPS_INT_Pow(10, P->FracDigits);
+	return P->Neg ? -val : val;
+}
+
+static int32_t TM_GPS_INT_Coordinate(TM_GPS_Parser_t* P) {
+	uint32_t minutes;
+	
+	/* Format is dddmm.mmmm, decimal part of minutes scaled to 7 digits */
+	if (P->FracDigits <= 7) {
+		minutes = P->Frac * TM_GPS_INT_Pow(10, 7 - P->FracDigits);
+	} else {
+		minutes = P->Frac / TM_GPS_INT_Pow(10, P->FracDigits - 7);
+	}
+	minutes += (P->Int % 100) * 10000000UL;
+	
+	/* Degrees * 1e7, rounded */
+	return (int32_t)((P->Int / 100) * 10000000UL + (minutes + 30) / 60);
+}
+
+static int32_t TM_GPS_INT_LongitudeDiff(int32_t from, int32_t to) {
+	int64_t diff = (int64_t)to - from;
+	
+	/* Shortest way over 180 degrees meridian */
+	if (diff > 1800000000) {
+		diff -= 3600000000LL;
+	} else if (diff < -1800000000) {
+		diff += 3600000000LL;
+	}
+	return (int32_t)diff;
 }
 
-TM_GPS_Result_t TM_GPS_INT_Return(TM_GPS_t* GPS_Data) {
+static TM_GPS_Result_t TM_GPS_INT_Return(TM_GPS_t* GPS_Data) {
+	TM_GPS_Parser_t* P = &GPS_Data->Parser;
 	uint8_t i;
 	if (TM_GPS_INT_FlagsOk(GPS_Data)) {
-		TM_GPS_FirstTime = 0;							/* Clear first time */
+		P->FirstTime = 0;								/* Clear first time */
 		
 		/* Set data */
 #ifndef GPS_DISABLE_GPGGA
-		GPS_Data->Latitude = TM_GPS_INT_Data.Latitude;
-		GPS_Data->Longitude = TM_GPS_INT_Data.Longitude;
-		GPS_Data->Satellites = TM_GPS_INT_Data.Satellites;
-		GPS_Data->Fix = TM_GPS_INT_Data.Fix;
-		GPS_Data->Altitude = TM_GPS_INT_Data.Altitude;
-		GPS_Data->Time = TM_GPS_INT_Data.Time;
+		GPS_Data->LatitudeE7 = P->Work.LatitudeE7;
+		GPS_Data->LongitudeE7 = P->Work.LongitudeE7;
+		GPS_Data->Latitude = TM_GPS_E7_TO_DEGREES(P->Work.LatitudeE7);
+		GPS_Data->Longitude = TM_GPS_E7_TO_DEGREES(P->Work.LongitudeE7);
+		GPS_Data->Satellites = P->Work.Satellites;
+		GPS_Data->Fix = P->Work.Fix;
+		GPS_Data->Altitude = P->Work.Altitude;
+		GPS_Data->Time = P->Work.Time;
 #endif
 #ifndef GPS_DISABLE_GPRMC
-		GPS_Data->Speed = TM_GPS_INT_Data.Speed;
-		GPS_Data->Date = TM_GPS_INT_Data.Date;
-		GPS_Data->Validity = TM_GPS_INT_Data.Validity;
-		GPS_Data->Direction = TM_GPS_INT_Data.Direction;
+		GPS_Data->Speed = P->Work.Speed;
+		GPS_Data->Date = P->Work.Date;
+		GPS_Data->Validity = P->Work.Validity;
+		GPS_Data->Direction = P->Work.Direction;
 #endif
 #ifndef GPS_DISABLE_GPGSA
-		GPS_Data->HDOP = TM_GPS_INT_Data.HDOP;
-		GPS_Data->VDOP = TM_GPS_INT_Data.VDOP;
-		GPS_Data->PDOP = TM_GPS_INT_Data.PDOP;
-		GPS_Data->FixMode = TM_GPS_INT_Data.FixMode;
+		GPS_Data->HDOP = P->Work.HDOP;
+		GPS_Data->VDOP = P->Work.VDOP;
+		GPS_Data->PDOP = P->Work.PDOP;
+		GPS_Data->FixMode = P->Work.FixMode;
 		for (i = 0; i < 12; i++) {
-			GPS_Data->SatelliteIDs[i] = TM_GPS_INT_Data.SatelliteIDs[i];
+			GPS_Data->SatelliteIDs[i] = P->Work.SatelliteIDs[i];
 		}
 #endif
-#ifndef GPS_DISABLE_GPGSV
-		GPS_Data->SatellitesInView = TM_GPS_INT_Data.SatellitesInView;
-		for (i = 0; i < GPS_MAX_SATS_IN_VIEW; i++) {
-			GPS_Data->SatDesc[i] = TM_GPS_INT_Data.SatDesc[i];
-		}
+#ifndef GPS_DISABLE_VTG
+		GPS_Data->VTG = P->Work.VTG;
+#endif
+#ifndef GPS_DISABLE_GST
+		GPS_Data->GST = P->Work.GST;
+#endif
+#ifndef GPS_DISABLE_ZDA
+		GPS_Data->ZDA = P->Work.ZDA;
 #endif
 		TM_GPS_INT_ReturnWithStatus(GPS_Data, TM_GPS_Result_NewData);	/* Return new data */
 	}
 	
-	if (TM_GPS_FirstTime) {
+	if (P->FirstTime) {
 		TM_GPS_INT_ReturnWithStatus(GPS_Data, TM_GPS_Result_FirstDataWaiting);	/* We are first time */
 	}
 	TM_GPS_INT_ReturnWithStatus(GPS_Data, TM_GPS_Result_OldData);	/* Return old data */
@@ -664,16 +1050,6 @@ uint8_t TM_GPS_INT_StringStartsWith(char* string, const char* str) {
 	return 1;
 }
 
-uint8_t TM_GPS_INT_Atoi(char* str, uint32_t* val) {
-	uint8_t count = 0;
-	*val = 0;
-	while (GPS_IS_DIGIT(*str)) {
-		*val = *val * 10 + GPS_C2N(*str++);
-		count++;
-	}
-	return count;
-}
-
 uint32_t TM_GPS_INT_Pow(uint8_t x, uint8_t y) {
 	uint32_t ret = 1;
 	while (y--) {
@@ -694,7 +1070,7 @@ uint8_t TM_GPS_INT_Hex2Dec(char c) {
 }
 
 uint8_t TM_GPS_INT_FlagsOk(TM_GPS_t* GPS_Data) {
-	if (GPS_Flags == GPS_Flags_OK) {					/* Check main flags */
+	if (GPS_Data->Parser.Flags == GPS_Data->Parser.FlagsOK) {	/* Check main flags */
 		uint8_t i;
 		for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {	/* Check custom terms */
 			if (GPS_Data->CustomStatements[i]->Updated == 0) {	/* If not flag set */
@@ -709,57 +1085,8 @@ uint8_t TM_GPS_INT_FlagsOk(TM_GPS_t* GPS_Data) {
 void TM_GPS_INT_ClearFlags(TM_GPS_t* GPS_Data) {
 	uint8_t i;
 	
-	GPS_Flags = 0;						/* Reset main flags */
+	GPS_Data->Parser.Flags = 0;							/* Reset main flags */
 	for (i = 0; i < GPS_Data->CustomStatementsCount; i++) {	/* Clear custom terms */
 		GPS_Data->CustomStatements[i]->Updated = 0;		/* If not flag set */
 	}
 }
-
-void TM_GPS_INT_CheckEmpty(TM_GPS_t* GPS_Data) {
-	if (GPS_Term_Pos == 1) {
-		switch (GPS_CONCAT(TM_GPS_Statement, GPS_Term_Number)) {
-#ifndef GPS_DISABLE_GPGGA
-			case GPS_POS_LATITUDE: 	TM_GPS_INT_SetFlag(GPS_FLAG_LATITUDE); break;
-			case GPS_POS_NS: 		TM_GPS_INT_SetFlag(GPS_FLAG_NS); break;
-			case GPS_POS_LONGITUDE: TM_GPS_INT_SetFlag(GPS_FLAG_LONGITUDE); break;
-			case GPS_POS_EW: 		TM_GPS_INT_SetFlag(GPS_FLAG_EW); break;
-			case GPS_POS_SATS:		TM_GPS_INT_SetFlag(GPS_FLAG_SATS); break;
-			case GPS_POS_FIX: 		TM_GPS_INT_SetFlag(GPS_FLAG_FIX); break;
-			case GPS_POS_ALTITUDE: 	TM_GPS_INT_SetFlag(GPS_FLAG_ALTITUDE); break;
-			case GPS_POS_TIME: 		TM_GPS_INT_SetFlag(GPS_FLAG_TIME); break;
-#endif
-#ifndef GPS_DISABLE_GPRMC
-			case GPS_POS_SPEED: 	TM_GPS_INT_SetFlag(GPS_FLAG_SPEED); break;
-			case GPS_POS_DATE: 		TM_GPS_INT_SetFlag(GPS_FLAG_DATE); break;
-			case GPS_POS_VALIDITY: 	TM_GPS_INT_SetFlag(GPS_FLAG_VALIDITY); break;
-			case GPS_POS_DIRECTION: TM_GPS_INT_SetFlag(GPS_FLAG_DIRECTION); break;
-#endif
-#ifndef GPS_DISABLE_GPGSA
-			case GPS_POS_HDOP: 		TM_GPS_INT_SetFlag(GPS_FLAG_HDOP); break;
-			case GPS_POS_PDOP: 		TM_GPS_INT_SetFlag(GPS_FLAG_PDOP); break;
-			case GPS_POS_VDOP: 		TM_GPS_INT_SetFlag(GPS_FLAG_VDOP); break;
-			case GPS_POS_FIXMODE: 	TM_GPS_INT_SetFlag(GPS_FLAG_FIXMODE); break;
-
-			case GPS_POS_SAT1:
-			case GPS_POS_SAT2:
-			case GPS_POS_SAT3:
-			case GPS_POS_SAT4:
-			case GPS_POS_SAT5:
-			case GPS_POS_SAT6:
-			case GPS_POS_SAT7:
-			case GPS_POS_SAT8:
-			case GPS_POS_SAT9:
-			case GPS_POS_SAT10:
-			case GPS_POS_SAT11:
-			case GPS_POS_SAT12:
-				TM_GPS_INT_SetFlag(GPS_FLAG_SATS1_12);
-				break;
-#endif
-#ifndef GPS_DISABLE_GPGSV
-			case GPS_POS_SATSINVIEW: TM_GPS_INT_SetFlag(GPS_FLAG_SATSINVIEW); break;
-#endif
-			default: 
-				break;
-		}
-	}
-}
@@ -3,7 +3,7 @@
  * @email   tilen@majerle.eu
  * @website http://stm32f4-discovery.net
  * @link    http://stm32f4-discovery.net/2016/07/hal-library-35-gps-parser-stm32fxxx/
- * @version v1.0
+ * @version v1.4
  * @ide     Keil uVision
  * @license MIT
  * @brief   GPS NMEA standard data parser for STM32Fxxx devices
@@ -35,7 +35,7 @@
 \endverbatim
  */
 #ifndef TM_GPS_H
-#define TM_GPS_H 100
+#define TM_GPS_H 140
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -85,6 +85,38 @@ extern C {
  *     - Satellites in view
  *     - Description of all satellites in view
  *  - Custom statements defined by user
+ *
+ * Statements are accepted from all GNSS talkers: GP (GPS), GL (GLONASS), GA (Galileo), GB or BD (BeiDou)
+ * and GN (combined solution), so $GNGGA and $GNRMC from multi-constellation receivers are parsed too.
+ * GSV statements are stored to satellite table of constellation given by talker.
+ *
+ * These statements are parsed when received, but they are not required for new data.
+ * Their values are updated together with other data:
+ *  - VTG: Course over ground and ground speed
+ *  - GST: Pseudorange error statistics (position error estimates)
+ *  - ZDA: Time and date with 4 digits year and local zone
+ *
+ * \par Satellite tables
+ *
+ * Satellites in view are stored in @ref TM_GPS_Sats_t structure, in struct-of-arrays layout.
+ * Each constellation has its own part of arrays with size set by GPS_SATS_xxx defines,
+ * so 60+ satellites from all constellations can be stored without overflow.
+ * Part of constellation is updated when last GSV statement of its group is received, other constellations are not touched:
+ *
+\code
+//Print all GLONASS satellites in view
+uint16_t i, idx;
+for (i = 0; i < GPS_Data.Sats.Count[TM_GPS_System_GLONASS]; i++) {
+	idx = TM_GPS_SAT_OFFSET(TM_GPS_System_GLONASS) + i;
+	printf("ID: %d, SNR: %d\n", GPS_Data.Sats.ID[idx], GPS_Data.Sats.SNR[idx]);
+}
+
+//Change sizes in defines.h file if necessary
+#define GPS_SATS_GPS        32
+#define GPS_SATS_GLONASS    24
+#define GPS_SATS_GALILEO    36
+#define GPS_SATS_BEIDOU     32
+\endcode
  *
  * By default, each of this data has to be detected in order to get "VALID" data.
  * If your GPS does not return any of this statement, you can disable option.
@@ -100,6 +132,10 @@ extern C {
 #define GPS_DISABLE_GPGSA
 //Disable GPGSV statement
 #define GPS_DISABLE_GPGSV
+//Disable parsing of VTG, GST or ZDA statements
+#define GPS_DISABLE_VTG
+#define GPS_DISABLE_GST
+#define GPS_DISABLE_ZDA
 \endcode
  *
  * \par Pinout
@@ -142,6 +178,34 @@ extern C {
  * in which direction (bearing) he has to move according to the north. 
  * Then, you just have to compare your calculated bearing with actual direction provided from GPS.
  * And you will know, if he needs to go more left, right, etc. You can tune PID then according to values.
+ *
+ * Coordinates are parsed to LatitudeE7 and LongitudeE7 members as integers (degrees * 10^7, about 1cm resolution).
+ * Float Latitude and Longitude members have only about 1 meter resolution and are kept for compatibility.
+ * Points for distance functions are @ref TM_GPS_Point_t structures with the same integer coordinates:
+ *
+ *  - @ref TM_GPS_DistanceFast: Equirectangular approximation in float, for short ranges up to few kilometers.
+ *       Coordinates are subtracted as integers first, so precision is not lost on small differences
+ *  - @ref TM_GPS_DistanceHaversine: Great circle distance on sphere in double
+ *  - @ref TM_GPS_DistanceVincenty: Distance on WGS84 ellipsoid in double, accurate to millimeters on any range
+ *
+ * Each function also calculates bearing if pointer is not NULL. Functions with "Many" suffix calculate distances
+ * from one point to array of waypoints, where values of first point are calculated only once:
+ *
+\code
+TM_GPS_Point_t home = {461234567, 145054321}, here;
+TM_GPS_Point_t waypoints[10];
+float distances[10], distance, bearing;
+
+//Current position
+here.LatitudeE7 = GPS_Data.LatitudeE7;
+here.LongitudeE7 = GPS_Data.LongitudeE7;
+
+//Distance and bearing to home
+distance = TM_GPS_DistanceFast(&here, &home, &bearing);
+
+//Distances to all waypoints
+TM_GPS_DistanceFastMany(&here, waypoints, distances, NULL, 10);
+\endcode
  *
  * \par Custom GPS statements
  *
@@ -167,11 +231,64 @@ GPRMB_3_Pointer = TM_GPS_AddCustom(&GPS_Data, "$GPRMB", 3);
  *       If module will not return this statement, you will not be able to read anything from library,
  *       because it will never happen that everything will be updated before new data are available.
  *
+ * \par Multiple receivers
+ *
+ * Parser state is part of @ref TM_GPS_t structure, so each receiver has its own working structure
+ * and more receivers can be parsed at the same time, for example 2 receivers for heading calculation.
+ *
+ * First receiver uses default USART from @ref TM_GPS_Init function, others can be initialized with @ref TM_GPS_InitUSART.
+ * When data come from other source (DMA, file, etc), use @ref TM_GPS_InitParser and @ref TM_GPS_ParseChar.
+ *
+\code
+TM_GPS_t GPS1, GPS2;
+
+//First receiver on default USART, second on USART2
+TM_GPS_Init(&GPS1, 115200);
+TM_GPS_InitUSART(&GPS2, USART2, TM_USART_PinsPack_1, 115200);
+
+while (1) {
+	TM_GPS_Update(&GPS1);
+	TM_GPS_Update(&GPS2);
+}
+\endcode
+ *
+ * Sentences are detected with numeric key calculated from received characters and dispatched
+ * with table of field handlers. Numbers are parsed while characters are received, without temporary string buffer.
+ *
+ * \par u-blox binary protocol
+ *
+ * For u-blox receivers, @ref TM_GPS_UBX module decodes UBX binary messages from the same USART
+ * into the same @ref TM_GPS_t structure, while NMEA statements in the same stream are still parsed.
+ *
  * \par Changelog
  *
 \verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Parser state moved to TM_GPS_t structure, multiple receivers are supported
+  - Added TM_GPS_InitUSART, TM_GPS_InitParser and TM_GPS_ParseChar functions
+  - Table driven sentence parser with numbers parsed in place
+
+ Version 1.2
+  - October 19, 2026
+  - Statements from all GNSS talkers (GN, GL, GA, GB, BD) are accepted
+  - Added VTG, GST and ZDA statements
+  - SatDesc array replaced with per constellation satellite tables in Sats member
+
+ Version 1.3
+  - October 19, 2026
+  - USART pinspack saved in TM_GPS_t for receiver reconfiguration
+  - Added @ref TM_GPS_UBX module for u-blox binary protocol
+
+ Version 1.4
+  - October 19, 2026
+  - Coordinates are parsed to LatitudeE7 and LongitudeE7 integers, degrees * 10^7
+  - Added fast equirectangular, haversine and Vincenty distance and bearing with TM_GPS_Point_t
+  - Added batch distance functions from one point to many waypoints
+  - Parser keeps satellites of one constellation only, each constellation is updated at the end of its GSV group
 \endverbatim
  *
  * \par Dependencies
@@ -221,7 +338,42 @@ GPRMB_3_Pointer = TM_GPS_AddCustom(&GPS_Data, "$GPRMB", 3);
 #define GPS_USART_INIT(baudrate)    TM_USART_Init(GPS_USART, GPS_USART_PINSPACK, baudrate)
 #endif
 
-/* Maximum number of custom GPGxx values */
+/* Maximum number of satellites in view stored for each constellation */
+#ifndef GPS_SATS_GPS
+#define GPS_SATS_GPS            32
+#endif
+#ifndef GPS_SATS_GLONASS
+#define GPS_SATS_GLONASS        24
+#endif
+#ifndef GPS_SATS_GALILEO
+#define GPS_SATS_GALILEO        36
+#endif
+#ifndef GPS_SATS_BEIDOU
+#define GPS_SATS_BEIDOU         32
+#endif
+
+/* Total number of satellites in tables */
+#define TM_GPS_SATS_TOTAL       (GPS_SATS_GPS + GPS_SATS_GLONASS + GPS_SATS_GALILEO + GPS_SATS_BEIDOU)
+
+/* Largest number of satellites of one constellation, size of parser working table */
+#define TM_GPS_MAX(a, b)            ((a) > (b) ? (a) : (b))
+#define TM_GPS_SATS_MAX             TM_GPS_MAX(TM_GPS_MAX(GPS_SATS_GPS, GPS_SATS_GLONASS), TM_GPS_MAX(GPS_SATS_GALILEO, GPS_SATS_BEIDOU))
+
+/* Offset of first satellite of constellation in satellite table arrays */
+#define TM_GPS_SAT_OFFSET(system)   (((system) > TM_GPS_System_GPS ? GPS_SATS_GPS : 0) + \
+                                     ((system) > TM_GPS_System_GLONASS ? GPS_SATS_GLONASS : 0) + \
+                                     ((system) > TM_GPS_System_Galileo ? GPS_SATS_GALILEO : 0))
+
+/* Number of satellites which can be stored for constellation */
+#define TM_GPS_SAT_CAPACITY(system) ((system) == TM_GPS_System_GPS ? GPS_SATS_GPS : \
+                                     (system) == TM_GPS_System_GLONASS ? GPS_SATS_GLONASS : \
+                                     (system) == TM_GPS_System_Galileo ? GPS_SATS_GALILEO : GPS_SATS_BEIDOU)
+
+/* Coordinate in degrees * 10^7 to float degrees and back */
+#define TM_GPS_E7_TO_DEGREES(x)     ((float)(x) / 10000000.0f)
+#define TM_GPS_DEGREES_TO_E7(x)     ((int32_t)((x) * 10000000.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+/* Maximum number of custom GPGxx values, 32 is maximum */
 #ifndef GPS_CUSTOM_NUMBER
 #define GPS_CUSTOM_NUMBER       10
 #endif
@@ -246,6 +398,17 @@ typedef enum {
 } TM_GPS_Result_t;
 
 
+/**
+ * @brief  GNSS constellation enumeration
+ */
+typedef enum {
+	TM_GPS_System_GPS = 0x00, /*!< GPS, talker GP */
+	TM_GPS_System_GLONASS,    /*!< GLONASS, talker GL */
+	TM_GPS_System_Galileo,    /*!< Galileo, talker GA */
+	TM_GPS_System_BeiDou,     /*!< BeiDou, talker GB or BD */
+	TM_GPS_System_Count       /*!< Number of constellations, also used for combined GN talker */
+} TM_GPS_System_t;
+
 /**
  * @brief  Speed conversion enumeration
  * @note   Speed from GPS is in knots, use TM_GPS_ConvertSpeed() to convert to useable value
@@ -315,6 +478,65 @@ typedef struct {
 	uint8_t SNR;       /*!< SNR, 00-99 dB (0 when not tracking) */
 } TM_GPS_Satellite_t;
 
+/**
+ * @brief  Satellites in view for all constellations, in struct-of-arrays layout
+ * @note   Satellites of constellation start at @ref TM_GPS_SAT_OFFSET index in each array
+ */
+typedef struct {
+	uint8_t InView[TM_GPS_System_Count];  /*!< Number of satellites in view reported by receiver for each constellation */
+	uint8_t Count[TM_GPS_System_Count];   /*!< Number of satellites stored in table for each constellation */
+	uint8_t ID[TM_GPS_SATS_TOTAL];        /*!< SV PRN numbers */
+	uint8_t Elevation[TM_GPS_SATS_TOTAL]; /*!< Elevations in degrees, 90 maximum */
+	uint16_t Azimuth[TM_GPS_SATS_TOTAL];  /*!< Azimuths, degrees from true north, 000 to 359 */
+	uint8_t SNR[TM_GPS_SATS_TOTAL];       /*!< SNRs, 00-99 dB (0 when not tracking) */
+} TM_GPS_Sats_t;
+
+/**
+ * @brief  Satellites of one constellation from current group of GSV statements
+ * @note   Meant for private use
+ */
+typedef struct {
+	uint8_t System;                       /*!< Constellation of group, value of @ref TM_GPS_System_t */
+	uint8_t InView;                       /*!< Number of satellites in view reported by receiver */
+	uint8_t Count;                        /*!< Number of satellites stored in table */
+	uint8_t ID[TM_GPS_SATS_MAX];          /*!< SV PRN numbers */
+	uint8_t Elevation[TM_GPS_SATS_MAX];   /*!< Elevations in degrees, 90 maximum */
+	uint16_t Azimuth[TM_GPS_SATS_MAX];    /*!< Azimuths, degrees from true north, 000 to 359 */
+	uint8_t SNR[TM_GPS_SATS_MAX];         /*!< SNRs, 00-99 dB (0 when not tracking) */
+} TM_GPS_SatsGroup_t;
+
+/**
+ * @brief  Course and speed from VTG statement
+ */
+typedef struct {
+	float CourseTrue;     /*!< Course over ground in relation to true north */
+	float CourseMagnetic; /*!< Course over ground in relation to magnetic north */
+	float SpeedKnots;     /*!< Speed over ground in knots */
+	float SpeedKmh;       /*!< Speed over ground in kilometers per hour */
+} TM_GPS_VTG_t;
+
+/**
+ * @brief  Position error statistics from GST statement
+ */
+typedef struct {
+	float RMS;            /*!< RMS value of standard deviation of range inputs */
+	float Latitude;       /*!< Standard deviation of latitude error in meters */
+	float Longitude;      /*!< Standard deviation of longitude error in meters */
+	float Altitude;       /*!< Standard deviation of altitude error in meters */
+} TM_GPS_GST_t;
+
+/**
+ * @brief  Time and date from ZDA statement
+ */
+typedef struct {
+	TM_GPS_Time_t Time;   /*!< UTC time */
+	uint8_t Day;          /*!< Day in month */
+	uint8_t Month;        /*!< Month */
+	uint16_t Year;        /*!< Year with 4 digits */
+	int8_t ZoneHours;     /*!< Local zone hours offset */
+	uint8_t ZoneMinutes;  /*!< Local zone minutes offset */
+} TM_GPS_ZDA_t;
+
 /**
  * @brief  Custom NMEA statement and term, selected by user 
  */
@@ -326,13 +548,84 @@ typedef struct {
 	uint8_t Updated;    /*!< Updated flag. If this parameter is set to 1, then new update has been made. Meant for private use */
 } TM_GPS_Custom_t;
 
+/**
+ * @brief  Working values while statements are received, copied to @ref TM_GPS_t when all are received
+ * @note   Meant for private use
+ */
+typedef struct {
+#ifndef GPS_DISABLE_GPGGA
+	int32_t LatitudeE7;                 /*!< Latitude position in degrees * 10^7 */
+	int32_t LongitudeE7;                /*!< Longitude position in degrees * 10^7 */
+	float Altitude;                     /*!< Altitude above the sea */
+	uint8_t Satellites;                 /*!< Number of satellites in use */
+	uint8_t Fix;                        /*!< GPS fix */
+	TM_GPS_Time_t Time;                 /*!< Current time */
+#endif
+#ifndef GPS_DISABLE_GPRMC
+	TM_GPS_Date_t Date;                 /*!< Current date */
+	float Speed;                        /*!< Speed in knots */
+	uint8_t Validity;                   /*!< GPS validation */
+	float Direction;                    /*!< Course on the ground */
+#endif
+#ifndef GPS_DISABLE_GPGSA
+	float HDOP;                         /*!< Horizontal dilution of precision */
+	float PDOP;                         /*!< Position dilution of precision */
+	float VDOP;                         /*!< Vertical dilution of precision */
+	uint8_t FixMode;                    /*!< Current fix mode */
+	uint8_t SatelliteIDs[12];           /*!< IDs of satellites in use */
+#endif
+#ifndef GPS_DISABLE_GPGSV
+	TM_GPS_SatsGroup_t Sats;            /*!< Satellites of constellation from current GSV group */
+#endif
+#ifndef GPS_DISABLE_VTG
+	TM_GPS_VTG_t VTG;                   /*!< Course and speed */
+#endif
+#ifndef GPS_DISABLE_GST
+	TM_GPS_GST_t GST;                   /*!< Error statistics */
+#endif
+#ifndef GPS_DISABLE_ZDA
+	TM_GPS_ZDA_t ZDA;                   /*!< Time and date */
+#endif
+} TM_GPS_Work_t;
+
+/**
+ * @brief  NMEA parser state for one receiver
+ * @note   Meant for private use
+ */
+typedef struct {
+	uint32_t Flags;                     /*!< Flags of received terms */
+	uint32_t FlagsOK;                   /*!< Flags which must be received before new data are available */
+	uint32_t Int;                       /*!< Integer part of current term */
+	uint32_t Frac;                      /*!< Decimal part of current term */
+	uint32_t CustomMatch;               /*!< Bit mask of custom statements matching current statement */
+	const void* Sentence;               /*!< Pointer to dispatch table entry of current statement or NULL */
+	uint16_t Key;                       /*!< Key calculated from current statement formatter */
+	char Name[7];                       /*!< Current statement name, including "$" */
+	char First;                         /*!< First character of current term */
+	uint8_t FracDigits;                 /*!< Number of digits in decimal part of current term */
+	uint8_t Dot;                        /*!< Set to 1 when decimal dot is received in current term */
+	uint8_t Neg;                        /*!< Set to 1 when term is negative number */
+	uint8_t TermNumber;                 /*!< Current term number in statement */
+	uint8_t TermPos;                    /*!< Current character position in term */
+	uint8_t Checksum;                   /*!< Calculated checksum */
+	uint8_t ChecksumReceived;           /*!< Received checksum */
+	uint8_t Star;                       /*!< Set to 1 when checksum star is received */
+	uint8_t FirstTime;                  /*!< Set to 1 until first complete data are received */
+	uint8_t GSVCount;                   /*!< Number of GSV statements in current group */
+	uint8_t GSVNumber;                  /*!< Current GSV statement number */
+	uint8_t System;                     /*!< Constellation of current statement from talker, value of @ref TM_GPS_System_t */
+	TM_GPS_Work_t Work;                 /*!< Working values */
+} TM_GPS_Parser_t;
+
 /**
  * @brief  Main GPS data structure 
  */
 typedef struct {
 #ifndef GPS_DISABLE_GPGGA
-	float Latitude;                                       /*!< Latitude position from GPS, -90 to 90 degrees response. */
-	float Longitude;                                      /*!< Longitude position from GPS, -180 to 180 degrees response. */
+	int32_t LatitudeE7;                                   /*!< Latitude position from GPS in degrees * 10^7, -900000000 to 900000000. */
+	int32_t LongitudeE7;                                  /*!< Longitude position from GPS in degrees * 10^7, -1800000000 to 1800000000. */
+	float Latitude;                                       /*!< Latitude position from GPS, -90 to 90 degrees response. Converted from LatitudeE7 */
+	float Longitude;                                      /*!< Longitude position from GPS, -180 to 180 degrees response. Converted from LongitudeE7 */
 	float Altitude;                                       /*!< Altitude above the seain units of meters */
 	uint8_t Satellites;                                   /*!< Number of satellites in use for GPS position. */
 	uint8_t Fix;                                          /*!< GPS fix; 0: Invalid; 1: GPS Fix; 2: DGPS Fix. */
@@ -353,13 +646,25 @@ typedef struct {
 	                                                           Only first data are valid, so if you have 5 satellites in use, only SatelliteIDs[4:0] are valid */
 #endif
 #ifndef GPS_DISABLE_GPGSV	
-	uint8_t SatellitesInView;                             /*!< Number of satellites in view */
-	TM_GPS_Satellite_t SatDesc[30];                       /*!< Description of each satellite in view */ 
+	uint8_t SatellitesInView;                             /*!< Number of satellites in view for all constellations */
+	TM_GPS_Sats_t Sats;                                   /*!< Description of each satellite in view for each constellation */
+#endif
+#ifndef GPS_DISABLE_VTG
+	TM_GPS_VTG_t VTG;                                     /*!< Course and speed from VTG statement */
+#endif
+#ifndef GPS_DISABLE_GST
+	TM_GPS_GST_t GST;                                     /*!< Position error statistics from GST statement */
+#endif
+#ifndef GPS_DISABLE_ZDA
+	TM_GPS_ZDA_t ZDA;                                     /*!< Time and date from ZDA statement */
 #endif
 	TM_GPS_Result_t Status;                               /*!< GPS result. This parameter is value of @ref TM_GPS_Result_t */
 	TM_GPS_Custom_t* CustomStatements[GPS_CUSTOM_NUMBER]; /*!< Array of pointers for custom GPS NMEA statements, selected by user.
 	                                                              You can use @ref GPS_CUSTOM_NUMBER number of custom statements */
 	uint8_t CustomStatementsCount;                        /*!< Number of custom GPS statements selected by user */
+	USART_TypeDef* USARTx;                                /*!< USART used for this receiver or NULL for default GPS USART */
+	TM_USART_PinsPack_t PinsPack;                         /*!< USART pinspack used for this receiver when USARTx is not NULL */
+	TM_GPS_Parser_t Parser;                               /*!< Parser state for this receiver. Meant for private use */
 } TM_GPS_t;
 
 /* Backward compatibility */
@@ -377,6 +682,14 @@ typedef struct {
 	float Bearing;    /*!< Bearing from start to stop point according to North. */
 } TM_GPS_Distance_t;
 
+/**
+ * @brief  Point on earth with coordinates in degrees * 10^7, as parsed by library
+ */
+typedef struct {
+	int32_t LatitudeE7;  /*!< Latitude in degrees * 10^7 */
+	int32_t LongitudeE7; /*!< Longitude in degrees * 10^7 */
+} TM_GPS_Point_t;
+
 /**
  * @}
  */
@@ -396,6 +709,33 @@ typedef struct {
  */
 void TM_GPS_Init(TM_GPS_t* GPS_Data, uint32_t baudrate);
 
+/**
+ * @brief  Initializes GPS on custom USART peripheral
+ * @note   Use this function for each additional receiver
+ * @param  *GPS_Data: Pointer to @ref TM_GPS_t structure to set default values
+ * @param  *USARTx: Pointer to USARTx peripheral where receiver is connected
+ * @param  pinspack: Pinspack used for USART. This parameter can be a value of @ref TM_USART_PinsPack_t enumeration
+ * @param  baudrate: Specify GPS baudrate for USART
+ * @retval None
+ */
+void TM_GPS_InitUSART(TM_GPS_t* GPS_Data, USART_TypeDef* USARTx, TM_USART_PinsPack_t pinspack, uint32_t baudrate);
+
+/**
+ * @brief  Initializes parser only, without USART peripheral
+ * @note   Use with @ref TM_GPS_ParseChar when data are received from other source
+ * @param  *GPS_Data: Pointer to @ref TM_GPS_t structure to set default values
+ * @retval None
+ */
+void TM_GPS_InitParser(TM_GPS_t* GPS_Data);
+
+/**
+ * @brief  Parses one received character
+ * @param  *GPS_Data: Pointer to working @ref TM_GPS_t structure
+ * @param  c: Received character
+ * @retval Returns value of @ref TM_GPS_Result_t structure
+ */
+TM_GPS_Result_t TM_GPS_ParseChar(TM_GPS_t* GPS_Data, char c);
+
 /**
  * @brief  Update GPS data.
  * @note   This function must be called periodically, as fast as possible. 
@@ -439,6 +779,57 @@ void TM_GPS_ConvertFloat(float num, TM_GPS_Float_t* Float_Data, uint8_t decimals
  */
 void TM_GPS_DistanceBetween(TM_GPS_Distance_t* Distance_Data);
 
+/**
+ * @brief  Calculates distance and bearing between 2 close points with equirectangular approximation
+ * @note   Error is below 0.1% for distances up to 10km and grows with distance, use for short ranges only
+ * @param  *From: Pointer to @ref TM_GPS_Point_t starting point
+ * @param  *To: Pointer to @ref TM_GPS_Point_t ending point
+ * @param  *Bearing: Pointer to save bearing from start to end point in degrees, 0 to 360. Set to NULL if not needed
+ * @retval Distance in meters
+ */
+float TM_GPS_DistanceFast(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, float* Bearing);
+
+/**
+ * @brief  Calculates great circle distance and initial bearing between 2 points with haversine formula in double precision
+ * @param  *From: Pointer to @ref TM_GPS_Point_t starting point
+ * @param  *To: Pointer to @ref TM_GPS_Point_t ending point
+ * @param  *Bearing: Pointer to save initial bearing from start to end point in degrees, 0 to 360. Set to NULL if not needed
+ * @retval Distance in meters
+ */
+double TM_GPS_DistanceHaversine(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Bearing);
+
+/**
+ * @brief  Calculates distance and initial bearing between 2 points on WGS84 ellipsoid with Vincenty inverse formula
+ * @note   Function is iterative and slowest, use it when precision is important on long ranges
+ * @param  *From: Pointer to @ref TM_GPS_Point_t starting point
+ * @param  *To: Pointer to @ref TM_GPS_Point_t ending point
+ * @param  *Bearing: Pointer to save initial bearing from start to end point in degrees, 0 to 360. Set to NULL if not needed
+ * @retval Distance in meters or -1 if calculation does not converge (nearly antipodal points)
+ */
+double TM_GPS_DistanceVincenty(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Bearing);
+
+/**
+ * @brief  Calculates distances and bearings from one point to many waypoints with equirectangular approximation
+ * @param  *From: Pointer to @ref TM_GPS_Point_t starting point
+ * @param  *To: Pointer to array of @ref TM_GPS_Point_t waypoints
+ * @param  *Distances: Pointer to array to save distances in meters
+ * @param  *Bearings: Pointer to array to save bearings in degrees. Set to NULL if not needed
+ * @param  count: Number of waypoints
+ * @retval None
+ */
+void TM_GPS_DistanceFastMany(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, float* Distances, float* Bearings, uint16_t count);
+
+/**
+ * @brief  Calculates distances and bearings from one point to many waypoints with haversine formula in double precision
+ * @param  *From: Pointer to @ref TM_GPS_Point_t starting point
+ * @param  *To: Pointer to array of @ref TM_GPS_Point_t waypoints
+ * @param  *Distances: Pointer to array to save distances in meters
+ * @param  *Bearings: Pointer to array to save bearings in degrees. Set to NULL if not needed
+ * @param  count: Number of waypoints
+ * @retval None
+ */
+void TM_GPS_DistanceHaversineMany(const TM_GPS_Point_t* From, const TM_GPS_Point_t* To, double* Distances, double* Bearings, uint16_t count);
+
 /**
  * @brief  Adds custom GPG statement to array of user selectable statements.
  *            Array is available to user using @ref TM_GPS_t workign structure
@@ -0,0 +1,411 @@
+/**
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software,
+ * | and to permit persons to whom the Software is furnished to do so,
+ * | subject to the following conditions:
+ * |
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * |
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_gps_ubx.h"
+
+/* Sync characters */
+#define GPS_UBX_SYNC1				0xB5
+#define GPS_UBX_SYNC2				0x62
+
+/* Framing states */
+#define GPS_UBX_STATE_SYNC1			0x00
+#define GPS_UBX_STATE_SYNC2			0x01
+#define GPS_UBX_STATE_CLASS			0x02
+#define GPS_UBX_STATE_ID			0x03
+#define GPS_UBX_STATE_LENGTH1		0x04
+#define GPS_UBX_STATE_LENGTH2		0x05
+#define GPS_UBX_STATE_PAYLOAD		0x06
+#define GPS_UBX_STATE_CK_A			0x07
+#define GPS_UBX_STATE_CK_B			0x08
+
+/* NAV-SAT header and satellite block sizes */
+#define GPS_UBX_SAT_HEADER			8
+#define GPS_UBX_SAT_BLOCK			12
+
+/* NAV-PVT flags */
+#define GPS_UBX_PVT_FIX_OK			0x01
+#define GPS_UBX_PVT_DIFF			0x02
+
+/* Speed in mm/s to knots */
+#define GPS_UBX_MMS2KNOTS(x)		((float)(x) / 514.444f)
+
+/* Little endian values from buffer */
+#define GPS_UBX_U16(b, o)			((uint16_t)((b)[o] | (uint16_t)(b)[(o) + 1] << 8))
+#define GPS_UBX_U32(b, o)			((uint32_t)(b)[o] | (uint32_t)(b)[(o) + 1] << 8 | (uint32_t)(b)[(o) + 2] << 16 | (uint32_t)(b)[(o) + 3] << 24)
+#define GPS_UBX_I16(b, o)			((int16_t)GPS_UBX_U16(b, o))
+#define GPS_UBX_I32(b, o)			((int32_t)GPS_UBX_U32(b, o))
+
+/* USART of receiver, the same as used by TM GPS library */
+#define TM_GPS_UBX_INT_USART(GPS_Data)			((GPS_Data)->USARTx != NULL ? (GPS_Data)->USARTx : GPS_USART)
+#define TM_GPS_UBX_INT_BufferEmpty(GPS_Data)	((GPS_Data)->USARTx != NULL ? TM_USART_BufferEmpty((GPS_Data)->USARTx) : GPS_USART_BUFFER_EMPTY)
+#define TM_GPS_UBX_INT_GetChar(GPS_Data)		((GPS_Data)->USARTx != NULL ? TM_USART_Getc((GPS_Data)->USARTx) : GPS_USART_BUFFER_GET_CHAR)
+
+/* Add byte to Fletcher checksum */
+#define TM_GPS_UBX_INT_AddCK(UBX, c)			do { (UBX)->CK_A += (c); (UBX)->CK_B += (UBX)->CK_A; } while (0)
+
+/* Private functions */
+static void TM_GPS_UBX_INT_Payload(TM_GPS_UBX_t* UBX, uint8_t c);
+static void TM_GPS_UBX_INT_Frame(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX);
+static void TM_GPS_UBX_INT_PVT(TM_GPS_t* GPS_Data, const uint8_t* p);
+static void TM_GPS_UBX_INT_Sat(TM_GPS_UBX_t* UBX, const uint8_t* p);
+static void TM_GPS_UBX_INT_Put16(uint8_t* p, uint16_t v);
+static void TM_GPS_UBX_INT_Put32(uint8_t* p, uint32_t v);
+
+void TM_GPS_UBX_Init(TM_GPS_UBX_t* UBX) {
+	/* Reset everything */
+	memset(UBX, 0, sizeof(TM_GPS_UBX_t));
+}
+
+TM_GPS_Result_t TM_GPS_UBX_ParseByte(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX, uint8_t c) {
+	switch (UBX->State) {
+		case GPS_UBX_STATE_SYNC1:
+			if (c != GPS_UBX_SYNC1) {
+				return TM_GPS_ParseChar(GPS_Data, (char)c);	/* Not UBX, give it to NMEA parser */
+			}
+			UBX->State = GPS_UBX_STATE_SYNC2;
+			break;
+		case GPS_UBX_STATE_SYNC2:
+			if (c != GPS_UBX_SYNC2) {
+				UBX->State = GPS_UBX_STATE_SYNC1;				/* False sync, parse byte again */
+				return TM_GPS_UBX_ParseByte(GPS_Data, UBX, c);
+			}
+			UBX->CK_A = 0;
+			UBX->CK_B = 0;
+			UBX->State = GPS_UBX_STATE_CLASS;
+			break;
+		case GPS_UBX_STATE_CLASS:
+			UBX->Class = c;
+			TM_GPS_UBX_INT_AddCK(UBX, c);
+			UBX->State = GPS_UBX_STATE_ID;
+			break;
+		case GPS_UBX_STATE_ID:
+			UBX->ID = c;
+			TM_GPS_UBX_INT_AddCK(UBX, c);
+			UBX->State = GPS_UBX_STATE_LENGTH1;
+			break;
+		case GPS_UBX_STATE_LENGTH1:
+			UBX->Length = c;
+			TM_GPS_UBX_INT_AddCK(UBX, c);
+			UBX->State = GPS_UBX_STATE_LENGTH2;
+			break;
+		case GPS_UBX_STATE_LENGTH2:
+			UBX->Length |= (uint16_t)c << 8;
+			TM_GPS_UBX_INT_AddCK(UBX, c);
+			UBX->Index = 0;
+			if (UBX->Length > GPS_UBX_MAX_LENGTH) {
+				UBX->Errors++;									/* Length is not possible, wait for new sync */
+				UBX->State = GPS_UBX_STATE_SYNC1;
+			} else {
+				UBX->State = UBX->Length ? GPS_UBX_STATE_PAYLOAD : GPS_UBX_STATE_CK_A;
+			}
+			break;
+		case GPS_UBX_STATE_PAYLOAD:
+			TM_GPS_UBX_INT_AddCK(UBX, c);
+			TM_GPS_UBX_INT_Payload(UBX, c);
+			if (++UBX->Index == UBX->Length) {
+				UBX->State = GPS_UBX_STATE_CK_A;
+			}
+			break;
+		case GPS_UBX_STATE_CK_A:
+			if (c != UBX->CK_A) {
+				UBX->Errors++;									/* Checksum failed, ignore frame */
+				UBX->State = GPS_UBX_STATE_SYNC1;
+			} else {
+				UBX->State = GPS_UBX_STATE_CK_B;
+			}
+			break;
+		case GPS_UBX_STATE_CK_B:
+			UBX->State = GPS_UBX_STATE_SYNC1;
+			if (c != UBX->CK_B) {
+				UBX->Errors++;
+			} else {
+				UBX->Frames++;
+				TM_GPS_UBX_INT_Frame(GPS_Data, UBX);			/* Valid frame, decode it */
+				return GPS_Data->Status;
+			}
+			break;
+		default:
+			UBX->State = GPS_UBX_STATE_SYNC1;
+			break;
+	}
+
+	/* New data were returned before, now they are old */
+	if (GPS_Data->Status == TM_GPS_Result_NewData) {
+		GPS_Data->Status = TM_GPS_Result_OldData;
+	}
+	return GPS_Data->Status;
+}
+
+TM_GPS_Result_t TM_GPS_UBX_Update(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX) {
+	/* Check for data in USART */
+	while (!TM_GPS_UBX_INT_BufferEmpty(GPS_Data)) {
+		if (TM_GPS_UBX_ParseByte(GPS_Data, UBX, (uint8_t)TM_GPS_UBX_INT_GetChar(GPS_Data)) == TM_GPS_Result_NewData) {
+			return TM_GPS_Result_NewData;
+		}
+	}
+
+	/* No new data */
+	GPS_Data->Status = GPS_Data->Parser.FirstTime ? TM_GPS_Result_FirstDataWaiting : TM_GPS_Result_OldData;
+	return GPS_Data->Status;
+}
+
+void TM_GPS_UBX_Send(TM_GPS_t* GPS_Data, uint8_t msg_class, uint8_t msg_id, const void* payload, uint16_t length) {
+	USART_TypeDef* USARTx = TM_GPS_UBX_INT_USART(GPS_Data);
+	uint8_t header[6], ck[2] = {0, 0};
+	uint16_t i;
+
+	/* Fill header */
+	header[0] = GPS_UBX_SYNC1;
+	header[1] = GPS_UBX_SYNC2;
+	header[2] = msg_class;
+	header[3] = msg_id;
+	TM_GPS_UBX_INT_Put16(&header[4], length);
+
+	/* Calculate checksum */
+	for (i = 2; i < 6; i++) {
+		ck[0] += header[i];
+		ck[1] += ck[0];
+	}
+	for (i = 0; i < length; i++) {
+		ck[0] += ((const uint8_t *)payload)[i];
+		ck[1] += ck[0];
+	}
+
+	/* Send frame */
+	TM_USART_Send(USARTx, header, 6);
+	if (length) {
+		TM_USART_Send(USARTx, (uint8_t *)payload, length);
+	}
+	TM_USART_Send(USARTx, ck, 2);
+}
+
+void TM_GPS_UBX_Configure(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX, uint32_t baudrate, uint16_t rate_ms) {
+	uint8_t data[20];
+
+	/* CFG-PRT: 8N1 at new baudrate, UBX and NMEA input, UBX output */
+	memset(data, 0, sizeof(data));
+	data[0] = GPS_UBX_PORT;
+	TM_GPS_UBX_INT_Put32(&data[4], 0x000008D0);
+	TM_GPS_UBX_INT_Put32(&data[8], baudrate);
+	TM_GPS_UBX_INT_Put16(&data[12], 0x0003);
+	TM_GPS_UBX_INT_Put16(&data[14], 0x0001);
+	TM_GPS_UBX_Send(GPS_Data, GPS_UBX_CLASS_CFG, GPS_UBX_CFG_PRT, data, 20);
+
+	/* Wait for last bytes and for receiver to change baudrate */
+	HAL_Delay(GPS_UBX_SWITCH_DELAY);
+
+	/* Set new baudrate on STM32 side */
+	if (GPS_Data->USARTx != NULL) {
+		TM_USART_Init(GPS_Data->USARTx, GPS_Data->PinsPack, baudrate);
+	} else {
+		GPS_USART_INIT(baudrate);
+	}
+	TM_USART_ClearBuffer(TM_GPS_UBX_INT_USART(GPS_Data));
+
+	/* Data received at old baudrate are not valid anymore */
+	UBX->State = GPS_UBX_STATE_SYNC1;
+
+	/* CFG-RATE: measurement period, 1 measurement per solution, UTC time reference */
+	TM_GPS_UBX_INT_Put16(&data[0], rate_ms);
+	TM_GPS_UBX_INT_Put16(&data[2], 1);
+	TM_GPS_UBX_INT_Put16(&data[4], 0);
+	TM_GPS_UBX_Send(GPS_Data, GPS_UBX_CLASS_CFG, GPS_UBX_CFG_RATE, data, 6);
+
+	/* CFG-MSG: NAV-PVT and NAV-DOP every solution, NAV-SAT less often */
+	data[0] = GPS_UBX_CLASS_NAV;
+	data[1] = GPS_UBX_NAV_PVT;
+	data[2] = 1;
+	TM_GPS_UBX_Send(GPS_Data, GPS_UBX_CLASS_CFG, GPS_UBX_CFG_MSG, data, 3);
+	data[1] = GPS_UBX_NAV_DOP;
+	TM_GPS_UBX_Send(GPS_Data, GPS_UBX_CLASS_CFG, GPS_UBX_CFG_MSG, data, 3);
+	data[1] = GPS_UBX_NAV_SAT;
+	data[2] = GPS_UBX_SAT_RATE;
+	TM_GPS_UBX_Send(GPS_Data, GPS_UBX_CLASS_CFG, GPS_UBX_CFG_MSG, data, 3);
+}
+
+/* Private */
+static void TM_GPS_UBX_INT_Payload(TM_GPS_UBX_t* UBX, uint8_t c) {
+	uint16_t pos = UBX->Index;
+
+	if (UBX->Class == GPS_UBX_CLASS_NAV && UBX->ID == GPS_UBX_NAV_SAT) {
+		/* Satellites are decoded one by one, buffer keeps header and current satellite */
+		if (pos >= GPS_UBX_SAT_HEADER) {
+			pos = GPS_UBX_SAT_HEADER + (pos - GPS_UBX_SAT_HEADER) % GPS_UBX_SAT_BLOCK;
+		}
+		UBX->Buffer[pos] = c;
+		if (UBX->Index == GPS_UBX_SAT_HEADER - 1) {
+			/* Header received, start new tables */
+#ifndef GPS_DISABLE_GPGSV
+			memset(UBX->Sats.InView, 0, sizeof(UBX->Sats.InView));
+			memset(UBX->Sats.Count, 0, sizeof(UBX->Sats.Count));
+#endif
+#ifndef GPS_DISABLE_GPGSA
+			UBX->SatelliteIDsCount = 0;
+#endif
+		} else if (pos == GPS_UBX_SAT_HEADER + GPS_UBX_SAT_BLOCK - 1) {
+			TM_GPS_UBX_INT_Sat(UBX, &UBX->Buffer[GPS_UBX_SAT_HEADER]);
+		}
+	} else if (pos < GPS_UBX_BUFFER_SIZE) {
+		UBX->Buffer[pos] = c;
+	}
+}
+
+static void TM_GPS_UBX_INT_Frame(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX) {
+	const uint8_t* p = UBX->Buffer;
+
+	if (UBX->Class == GPS_UBX_CLASS_NAV) {
+		if (UBX->ID == GPS_UBX_NAV_PVT) {
+			if (UBX->Length >= GPS_UBX_PVT_LENGTH) {
+				TM_GPS_UBX_INT_PVT(GPS_Data, p);
+				GPS_Data->Parser.FirstTime = 0;
+				GPS_Data->Status = TM_GPS_Result_NewData;
+				return;
+			}
+		} else if (UBX->ID == GPS_UBX_NAV_DOP) {
+#ifndef GPS_DISABLE_GPGSA
+			if (UBX->Length >= GPS_UBX_DOP_LENGTH) {
+				GPS_Data->PDOP = (float)GPS_UBX_U16(p, 6) * 0.01f;
+				GPS_Data->VDOP = (float)GPS_UBX_U16(p, 10) * 0.01f;
+				GPS_Data->HDOP = (float)GPS_UBX_U16(p, 12) * 0.01f;
+			}
+#endif
+		} else if (UBX->ID == GPS_UBX_NAV_SAT) {
+#ifndef GPS_DISABLE_GPGSV
+			uint8_t i;
+			GPS_Data->Sats = UBX->Sats;
+			GPS_Data->SatellitesInView = 0;
+			for (i = 0; i < TM_GPS_System_Count; i++) {
+				GPS_Data->SatellitesInView += UBX->Sats.InView[i];
+			}
+#endif
+#ifndef GPS_DISABLE_GPGSA
+			memset(GPS_Data->SatelliteIDs, 0, sizeof(GPS_Data->SatelliteIDs));
+			memcpy(GPS_Data->SatelliteIDs, UBX->SatelliteIDs, UBX->SatelliteIDsCount);
+#endif
+		}
+	} else if (UBX->Class == GPS_UBX_CLASS_ACK && UBX->Length >= 2) {
+		/* Save result of configuration message */
+		UBX->AckClass = p[0];
+		UBX->AckID = p[1];
+		UBX->Ack = UBX->ID == GPS_UBX_ACK_ACK;
+	}
+
+	/* No new solution */
+	if (GPS_Data->Status == TM_GPS_Result_NewData) {
+		GPS_Data->Status = TM_GPS_Result_OldData;
+	}
+}
+
+static void TM_GPS_UBX_INT_PVT(TM_GPS_t* GPS_Data, const uint8_t* p) {
+	uint8_t flags = p[21];
+	int32_t nano = GPS_UBX_I32(p, 16);
+
+#ifndef GPS_DISABLE_GPGGA
+	GPS_Data->LatitudeE7 = GPS_UBX_I32(p, 28);
+	GPS_Data->LongitudeE7 = GPS_UBX_I32(p, 24);
+	GPS_Data->Latitude = TM_GPS_E7_TO_DEGREES(GPS_Data->LatitudeE7);
+	GPS_Data->Longitude = TM_GPS_E7_TO_DEGREES(GPS_Data->LongitudeE7);
+	GPS_Data->Altitude = (float)GPS_UBX_I32(p, 36) / 1000.0f;
+	GPS_Data->Satellites = p[23];
+	GPS_Data->Fix = (flags & GPS_UBX_PVT_FIX_OK) ? ((flags & GPS_UBX_PVT_DIFF) ? 2 : 1) : 0;
+	GPS_Data->Time.Hours = p[8];
+	GPS_Data->Time.Minutes = p[9];
+	GPS_Data->Time.Seconds = p[10];
+	GPS_Data->Time.Hundredths = nano > 0 ? nano / 10000000 : 0;
+#endif
+#ifndef GPS_DISABLE_GPRMC
+	GPS_Data->Date.Date = p[7];
+	GPS_Data->Date.Month = p[6];
+	GPS_Data->Date.Year = GPS_UBX_U16(p, 4) % 100;
+	GPS_Data->Speed = GPS_UBX_MMS2KNOTS(GPS_UBX_I32(p, 60));
+	GPS_Data->Validity = flags & GPS_UBX_PVT_FIX_OK;
+	GPS_Data->Direction = (float)GPS_UBX_I32(p, 64) / 100000.0f;
+#endif
+#ifndef GPS_DISABLE_GPGSA
+	GPS_Data->PDOP = (float)GPS_UBX_U16(p, 76) * 0.01f;
+	GPS_Data->FixMode = p[20] == 2 ? 2 : (p[20] == 3 || p[20] == 4) ? 3 : 1;
+#endif
+#ifndef GPS_DISABLE_VTG
+	GPS_Data->VTG.CourseTrue = (float)GPS_UBX_I32(p, 64) / 100000.0f;
+	GPS_Data->VTG.SpeedKnots = GPS_UBX_MMS2KNOTS(GPS_UBX_I32(p, 60));
+	GPS_Data->VTG.SpeedKmh = (float)GPS_UBX_I32(p, 60) * 0.0036f;
+#endif
+#ifndef GPS_DISABLE_ZDA
+	GPS_Data->ZDA.Time.Hours = p[8];
+	GPS_Data->ZDA.Time.Minutes = p[9];
+	GPS_Data->ZDA.Time.Seconds = p[10];
+	GPS_Data->ZDA.Time.Hundredths = nano > 0 ? nano / 10000000 : 0;
+	GPS_Data->ZDA.Day = p[7];
+	GPS_Data->ZDA.Month = p[6];
+	GPS_Data->ZDA.Year = GPS_UBX_U16(p, 4);
+	GPS_Data->ZDA.ZoneHours = 0;
+	GPS_Data->ZDA.ZoneMinutes = 0;
+#endif
+	(void)flags;
+	(void)nano;
+}
+
+static void TM_GPS_UBX_INT_Sat(TM_GPS_UBX_t* UBX, const uint8_t* p) {
+	uint8_t system;
+
+	/* Get constellation from GNSS ID */
+	switch (p[0]) {
+		case 0: system = TM_GPS_System_GPS; break;
+		case 2: system = TM_GPS_System_Galileo; break;
+		case 3: system = TM_GPS_System_BeiDou; break;
+		case 6: system = TM_GPS_System_GLONASS; break;
+		default: return;								/* SBAS, QZSS and others are not stored */
+	}
+
+#ifndef GPS_DISABLE_GPGSV
+	UBX->Sats.InView[system]++;
+	if (UBX->Sats.Count[system] < TM_GPS_SAT_CAPACITY(system)) {
+		uint16_t idx = TM_GPS_SAT_OFFSET(system) + UBX->Sats.Count[system]++;
+		int16_t azimuth = GPS_UBX_I16(p, 4);
+
+		UBX->Sats.ID[idx] = p[1];
+		UBX->Sats.SNR[idx] = p[2];
+		UBX->Sats.Elevation[idx] = (int8_t)p[3] > 0 ? p[3] : 0;
+		UBX->Sats.Azimuth[idx] = azimuth > 0 ? azimuth : 0;
+	}
+#endif
+#ifndef GPS_DISABLE_GPGSA
+	/* svUsed flag, satellite is used for navigation */
+	if ((p[8] & 0x08) && UBX->SatelliteIDsCount < sizeof(UBX->SatelliteIDs)) {
+		UBX->SatelliteIDs[UBX->SatelliteIDsCount++] = p[1];
+	}
+#endif
+	(void)system;
+}
+
+static void TM_GPS_UBX_INT_Put16(uint8_t* p, uint16_t v) {
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+}
+
+static void TM_GPS_UBX_INT_Put32(uint8_t* p, uint32_t v) {
+	TM_GPS_UBX_INT_Put16(p, v & 0xFFFF);
+	TM_GPS_UBX_INT_Put16(p + 2, v >> 16);
+}
@@ -0,0 +1,317 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   u-blox UBX binary protocol parser and configurator for TM GPS library
+ *
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_GPS_UBX_H
+#define TM_GPS_UBX_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_GPS_UBX
+ * @brief    u-blox UBX binary protocol parser and configurator for TM GPS library
+ * @{
+ *
+ * NMEA statements are text and need a lot of bytes and parsing for each value.
+ * u-blox receivers also have UBX binary protocol, where one NAV-PVT message (100 bytes)
+ * has position, velocity, time and accuracy of one navigation solution, with integer values ready to use.
+ *
+ * Library reads bytes from the same USART as @ref TM_GPS library. Bytes of UBX frames are decoded here,
+ * all other bytes are passed to @ref TM_GPS_ParseChar, so mixed NMEA and UBX stream is supported.
+ * Decoded values are saved to the same @ref TM_GPS_t structure as with NMEA statements.
+ *
+ * \par Frame
+ *
+ * Each frame starts with 0xB5 0x62 sync characters, followed by class, ID, 16-bit little endian length,
+ * payload and 2 bytes of Fletcher checksum over class, ID, length and payload.
+ * Checksum is calculated while bytes are received, so there is no second pass over frame.
+ * Values are saved to @ref TM_GPS_t only when checksum is valid.
+ *
+ * \par Supported messages
+ *
+ *  - NAV-PVT: Navigation position, velocity and time solution
+ *     - Latitude, Longitude, Altitude, Satellites, Fix, Time (GGA values)
+ *     - Date, Speed, Validity, Direction (RMC values)
+ *     - PDOP, FixMode (GSA values)
+ *     - VTG and ZDA structures
+ *     - @ref TM_GPS_Result_NewData is returned when received
+ *  - NAV-DOP: HDOP, VDOP and PDOP
+ *  - NAV-SAT: Satellites in view for all constellations and IDs of satellites in use.
+ *       Message can be longer than buffer, because each satellite is decoded when its 12 bytes are received
+ *  - ACK-ACK and ACK-NAK: Result of last configuration message
+ *
+ * \par Configuration
+ *
+ * Most receivers start with NMEA output at 9600 bauds. @ref TM_GPS_UBX_Configure switches receiver port
+ * to UBX output at higher baudrate, changes STM32 USART to new baudrate and enables messages above.
+ *
+\code
+TM_GPS_t GPS_Data;
+TM_GPS_UBX_t UBX_Data;
+
+//Receiver starts at 9600 bauds
+TM_GPS_Init(&GPS_Data, 9600);
+TM_GPS_UBX_Init(&UBX_Data);
+
+//Switch to UBX at 115200 bauds, 5 solutions per second
+TM_GPS_UBX_Configure(&GPS_Data, &UBX_Data, 115200, 200);
+
+while (1) {
+	if (TM_GPS_UBX_Update(&GPS_Data, &UBX_Data) == TM_GPS_Result_NewData) {
+		//New solution is available in GPS_Data
+	}
+}
+\endcode
+ *
+ * @note  Configuration is not saved to receiver flash, so @ref TM_GPS_UBX_Configure has to be called after each receiver power up.
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - TM GPS
+ - TM USART
+ - string.h
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+#include "tm_stm32_gps.h"
+#include "string.h"
+
+/**
+ * @defgroup TM_GPS_UBX_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Size of payload buffer in bytes, at least 92 bytes for NAV-PVT message
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef GPS_UBX_BUFFER_SIZE
+#define GPS_UBX_BUFFER_SIZE         100
+#endif
+
+/**
+ * @brief  Maximal accepted payload length. Frames with longer length are treated as false sync
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef GPS_UBX_MAX_LENGTH
+#define GPS_UBX_MAX_LENGTH          1024
+#endif
+
+/**
+ * @brief  Receiver port where STM32 is connected, 1 = UART1 on receiver
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef GPS_UBX_PORT
+#define GPS_UBX_PORT                1
+#endif
+
+/**
+ * @brief  Time in milliseconds to wait for receiver to change baudrate
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef GPS_UBX_SWITCH_DELAY
+#define GPS_UBX_SWITCH_DELAY        100
+#endif
+
+/**
+ * @brief  NAV-SAT message is sent every GPS_UBX_SAT_RATE navigation solutions
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef GPS_UBX_SAT_RATE
+#define GPS_UBX_SAT_RATE            5
+#endif
+
+/* Message classes */
+#define GPS_UBX_CLASS_NAV           0x01
+#define GPS_UBX_CLASS_ACK           0x05
+#define GPS_UBX_CLASS_CFG           0x06
+
+/* Message IDs */
+#define GPS_UBX_NAV_DOP             0x04
+#define GPS_UBX_NAV_PVT             0x07
+#define GPS_UBX_NAV_SAT             0x35
+#define GPS_UBX_ACK_NAK             0x00
+#define GPS_UBX_ACK_ACK             0x01
+#define GPS_UBX_CFG_PRT             0x00
+#define GPS_UBX_CFG_MSG             0x01
+#define GPS_UBX_CFG_RATE            0x08
+
+/* Payload lengths */
+#define GPS_UBX_PVT_LENGTH          92
+#define GPS_UBX_DOP_LENGTH          18
+
+/* Whole NAV-PVT payload must fit to buffer */
+#if GPS_UBX_BUFFER_SIZE < GPS_UBX_PVT_LENGTH
+#error "GPS_UBX_BUFFER_SIZE must be at least 92 bytes for NAV-PVT message"
+#endif
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_GPS_UBX_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  UBX parser state for one receiver
+ */
+typedef struct {
+	uint8_t State;                      /*!< Framing state. Meant for private use */
+	uint8_t Class;                      /*!< Class of current frame */
+	uint8_t ID;                         /*!< ID of current frame */
+	uint8_t CK_A;                       /*!< First checksum byte, calculated */
+	uint8_t CK_B;                       /*!< Second checksum byte, calculated */
+	uint16_t Length;                    /*!< Payload length of current frame */
+	uint16_t Index;                     /*!< Number of payload bytes received in current frame */
+	uint8_t Buffer[GPS_UBX_BUFFER_SIZE];/*!< Payload buffer */
+#ifndef GPS_DISABLE_GPGSV
+	TM_GPS_Sats_t Sats;                 /*!< Satellites while NAV-SAT message is received */
+#endif
+#ifndef GPS_DISABLE_GPGSA
+	uint8_t SatelliteIDs[12];           /*!< IDs of satellites in use while NAV-SAT message is received */
+	uint8_t SatelliteIDsCount;          /*!< Number of satellites in use in SatelliteIDs */
+#endif
+	uint8_t AckClass;                   /*!< Class of message from last ACK-ACK or ACK-NAK */
+	uint8_t AckID;                      /*!< ID of message from last ACK-ACK or ACK-NAK */
+	uint8_t Ack;                        /*!< Set to 1 when last acknowledge was ACK-ACK, 0 when ACK-NAK */
+	uint32_t Frames;                    /*!< Number of received frames with valid checksum */
+	uint32_t Errors;                    /*!< Number of frames with checksum or length error */
+} TM_GPS_UBX_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_GPS_UBX_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes UBX parser
+ * @note   GPS USART has to be initialized with @ref TM_GPS_Init or @ref TM_GPS_InitUSART
+ * @param  *UBX: Pointer to @ref TM_GPS_UBX_t structure to set default values
+ * @retval None
+ */
+void TM_GPS_UBX_Init(TM_GPS_UBX_t* UBX);
+
+/**
+ * @brief  Parses one received byte
+ * @note   Bytes which are not part of UBX frame are passed to @ref TM_GPS_ParseChar
+ * @param  *GPS_Data: Pointer to working @ref TM_GPS_t structure
+ * @param  *UBX: Pointer to @ref TM_GPS_UBX_t structure for this receiver
+ * @param  c: Received byte
+ * @retval Returns value of @ref TM_GPS_Result_t structure
+ */
+TM_GPS_Result_t TM_GPS_UBX_ParseByte(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX, uint8_t c);
+
+/**
+ * @brief  Update GPS data from UBX and NMEA messages
+ * @note   Use this function instead of @ref TM_GPS_Update. It must be called periodically, as fast as possible
+ * @param  *GPS_Data: Pointer to working @ref TM_GPS_t structure
+ * @param  *UBX: Pointer to @ref TM_GPS_UBX_t structure for this receiver
+ * @retval Returns value of @ref TM_GPS_Result_t structure
+ */
+TM_GPS_Result_t TM_GPS_UBX_Update(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX);
+
+/**
+ * @brief  Sends UBX message to receiver
+ * @note   Sync characters, length and checksum are added by function
+ * @param  *GPS_Data: Pointer to working @ref TM_GPS_t structure
+ * @param  msg_class: Message class
+ * @param  msg_id: Message ID
+ * @param  *payload: Pointer to payload data
+ * @param  length: Payload length in bytes
+ * @retval None
+ */
+void TM_GPS_UBX_Send(TM_GPS_t* GPS_Data, uint8_t msg_class, uint8_t msg_id, const void* payload, uint16_t length);
+
+/**
+ * @brief  Switches receiver to UBX output at new baudrate
+ * @note   Receiver port is set to 8N1 with UBX and NMEA input and UBX output only,
+ *         STM32 USART is reinitialized at new baudrate, NAV-PVT and NAV-DOP are enabled for each solution
+ *         and NAV-SAT for each @ref GPS_UBX_SAT_RATE solutions
+ * @note   Function is blocking for @ref GPS_UBX_SWITCH_DELAY milliseconds
+ * @param  *GPS_Data: Pointer to working @ref TM_GPS_t structure
+ * @param  *UBX: Pointer to @ref TM_GPS_UBX_t structure for this receiver
+ * @param  baudrate: New baudrate for receiver and USART
+ * @param  rate_ms: Navigation solution period in milliseconds, for example 1000 for 1Hz or 100 for 10Hz
+ * @retval None
+ */
+void TM_GPS_UBX_Configure(TM_GPS_t* GPS_Data, TM_GPS_UBX_t* UBX, uint32_t baudrate, uint16_t rate_ms);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,296 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_memmon.h"
+#if MEMMON_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/* Pattern for unused stack */
+#define MEMMON_PATTERN        0xCDCDCDCD
+
+/* Magic value in block header */
+#define MEMMON_MAGIC          0x4D454D31
+
+/* Block header, 8 bytes to keep alignment */
+typedef struct {
+	uint32_t Size;
+	uint32_t Magic;
+} TM_MEMMON_Header_t;
+
+/* Heap statistics */
+static __IO uint32_t MEMMON_Live = 0;
+static __IO uint32_t MEMMON_Peak = 0;
+static __IO uint32_t MEMMON_Allocs = 0;
+static __IO uint32_t MEMMON_Frees = 0;
+static __IO uint32_t MEMMON_Failed = 0;
+static __IO uint32_t MEMMON_Errors = 0;
+
+#if MEMMON_FREERTOS
+/* Task states for snapshot */
+static TaskStatus_t MEMMON_TaskStatus[MEMMON_MAX_TASKS];
+#endif
+
+/* Main stack limits from linker */
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+/* Keil, STACK section from startup file */
+extern uint32_t STACK$$Base;
+extern uint32_t STACK$$Limit;
+#define MEMMON_STACK_BOTTOM   (&STACK$$Base)
+#define MEMMON_STACK_TOP      (&STACK$$Limit)
+#elif defined(__ICCARM__)
+/* IAR, CSTACK block from linker configuration */
+#pragma section = "CSTACK"
+#define MEMMON_STACK_BOTTOM   ((uint32_t *)__section_begin("CSTACK"))
+#define MEMMON_STACK_TOP      ((uint32_t *)__section_end("CSTACK"))
+#elif defined(__GNUC__)
+/* GCC, symbols from linker script */
+extern uint32_t _estack;
+extern uint32_t _Min_Stack_Size;
+#define MEMMON_STACK_BOTTOM   (&_estack - (uint32_t)&_Min_Stack_Size / 4)
+#define MEMMON_STACK_TOP      (&_estack)
+#else
+/* Unknown compiler, top from vector table and size from MEMMON_STACK_SIZE */
+#define MEMMON_STACK_BOTTOM   (TM_MEMMON_INT_StackTop() - MEMMON_STACK_SIZE / 4)
+#define MEMMON_STACK_TOP      (TM_MEMMON_INT_StackTop())
+static uint32_t* TM_MEMMON_INT_StackTop(void);
+#endif
+
+/* Private functions */
+static void TM_MEMMON_INT_ProbeHeap(TM_MEMMON_Snapshot_t* Snapshot);
+
+void TM_MEMMON_Init(void) {
+	uint32_t* ptr;
+	uint32_t* sp;
+	
+	/* Fill from bottom of stack to current stack pointer with some margin */
+	ptr = MEMMON_STACK_BOTTOM;
+	sp = (uint32_t *)__get_MSP() - 16;
+	while (ptr < sp) {
+		*ptr++ = MEMMON_PATTERN;
+	}
+}
+
+void* TM_MEMMON_Malloc(size_t size) {
+	TM_MEMMON_Header_t* hdr;
+	uint32_t irq;
+	
+	/* Allocate block with header */
+	hdr = (TM_MEMMON_Header_t *) MEMMON_ALLOC_FUNC(size + sizeof(TM_MEMMON_Header_t));
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Update statistics */
+	if (hdr == NULL) {
+		MEMMON_Failed++;
+	} else {
+		hdr->Size = size;
+		hdr->Magic = MEMMON_MAGIC;
+		MEMMON_Allocs++;
+		MEMMON_Live += size;
+		if (MEMMON_Live > MEMMON_Peak) {
+			MEMMON_Peak = MEMMON_Live;
+		}
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Return pointer after header */
+	return hdr ? (void *)(hdr + 1) : NULL;
+}
+
+void TM_MEMMON_Free(void* ptr) {
+	TM_MEMMON_Header_t* hdr;
+	uint32_t irq;
+	
+	/* Check pointer */
+	if (ptr == NULL) {
+		return;
+	}
+	hdr = (TM_MEMMON_Header_t *)ptr - 1;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Check header, block was not allocated by library or already freed */
+	if (hdr->Magic != MEMMON_MAGIC) {
+		MEMMON_Errors++;
+		hdr = NULL;
+	} else {
+		hdr->Magic = 0;
+		MEMMON_Frees++;
+		MEMMON_Live -= hdr->Size;
+	}
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Free memory */
+	if (hdr) {
+		MEMMON_FREE_FUNC(hdr);
+	}
+}
+
+uint32_t TM_MEMMON_GetStackUsed(void) {
+	uint32_t* ptr;
+	uint32_t* top;
+	
+	/* Count words with pattern from bottom of stack */
+	top = MEMMON_STACK_TOP;
+	ptr = MEMMON_STACK_BOTTOM;
+	while (ptr < top && *ptr == MEMMON_PATTERN) {
+		ptr++;
+	}
+	
+	/* Return used bytes */
+	return (uint32_t)(top - ptr) * 4;
+}
+
+void TM_MEMMON_GetSnapshot(TM_MEMMON_Snapshot_t* Snapshot, uint8_t ProbeHeap) {
+	uint32_t irq;
+#if MEMMON_FREERTOS
+	UBaseType_t i, count;
+#endif
+	
+	/* Main stack */
+	Snapshot->StackSize = (uint32_t)(MEMMON_STACK_TOP - MEMMON_STACK_BOTTOM) * 4;
+	Snapshot->StackUsed = TM_MEMMON_GetStackUsed();
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Heap statistics */
+	Snapshot->HeapLive = MEMMON_Live;
+	Snapshot->HeapPeak = MEMMON_Peak;
+	Snapshot->HeapAllocs = MEMMON_Allocs;
+	Snapshot->HeapFrees = MEMMON_Frees;
+	Snapshot->HeapFailed = MEMMON_Failed;
+	Snapshot->HeapErrors = MEMMON_Errors;
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Probe heap */
+	Snapshot->HeapFree = 0;
+	Snapshot->HeapLargest = 0;
+	Snapshot->HeapFragmentation = 0;
+	if (ProbeHeap) {
+		TM_MEMMON_INT_ProbeHeap(Snapshot);
+	}
+	
+#if MEMMON_FREERTOS
+	/* FreeRTOS heap */
+	Snapshot->RTOSHeapFree = xPortGetFreeHeapSize();
+	Snapshot->RTOSHeapMinFree = xPortGetMinimumEverFreeHeapSize();
+	
+	/* Task stacks, high water mark is in units of words */
+	count = uxTaskGetSystemState(MEMMON_TaskStatus, MEMMON_MAX_TASKS, NULL);
+	
+	/* Nothing is filled when array is too small, there is always at least idle task */
+	Snapshot->TaskOverflow = count == 0;
+	for (i = 0; i < count; i++) {
+		Snapshot->Tasks[i].Name = MEMMON_TaskStatus[i].pcTaskName;
+		Snapshot->Tasks[i].Headroom = MEMMON_TaskStatus[i].usStackHighWaterMark * sizeof(StackType_t);
+	}
+	Snapshot->TaskCount = (uint8_t)count;
+#endif
+}
+
+/***************************************************/
+/*                Private functions                */
+/***************************************************/
+
+#if !defined(__CC_ARM) && !defined(__ARMCC_VERSION) && !defined(__ICCARM__) && !defined(__GNUC__)
+/* Gets initial main stack pointer from vector table */
+static uint32_t* TM_MEMMON_INT_StackTop(void) {
+#if defined(SCB_VTOR_TBLOFF_Msk)
+	return (uint32_t *)(*(uint32_t *)SCB->VTOR);
+#else
+	return (uint32_t *)(*(uint32_t *)0x00000000);
+#endif
+}
+#endif
+
+/* Allocates largest blocks until heap is full and frees them */
+static void TM_MEMMON_INT_ProbeHeap(TM_MEMMON_Snapshot_t* Snapshot) {
+	void* list = NULL;
+	void* block;
+	uint32_t low, high, mid, total = 0;
+	
+	while (1) {
+		/* Find largest block with binary search */
+		low = 0;
+		high = MEMMON_HEAP_SIZE;
+		while (low < high) {
+			mid = (low + high + 1) / 2;
+			if ((block = MEMMON_ALLOC_FUNC(mid)) != NULL) {
+				MEMMON_FREE_FUNC(block);
+				low = mid;
+			} else {
+				high = mid - 1;
+			}
+		}
+		
+		/* Block must be large enough to keep pointer to next block */
+		if (low < sizeof(void *) || (block = MEMMON_ALLOC_FUNC(low)) == NULL) {
+			break;
+		}
+		
+		/* Save first block size */
+		if (list == NULL) {
+			Snapshot->HeapLargest = low;
+		}
+		total += low;
+		
+		/* Link blocks together */
+		*(void **)block = list;
+		list = block;
+	}
+	
+	/* Free all blocks */
+	while (list != NULL) {
+		block = list;
+		list = *(void **)block;
+		MEMMON_FREE_FUNC(block);
+	}
+	
+	/* Calculate fragmentation */
+	Snapshot->HeapFree = total;
+	if (total) {
+		Snapshot->HeapFragmentation = (uint8_t)(100 - (uint64_t)Snapshot->HeapLargest * 100 / total);
+	}
+}
@@ -0,0 +1,275 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   Stack and heap usage monitor for STM32Fxxx devices
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_MEMMON_H
+#define TM_MEMMON_H 110
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_MEMMON
+ * @brief    Stack and heap usage monitor for STM32Fxxx devices
+ * @{
+ *
+ * Library measures how much of stack and heap memory is really used, so sizes can be reduced safely.
+ *
+ * \par Main stack
+ *
+ * On @ref TM_MEMMON_Init, unused part of main stack is filled with known pattern.
+ * Later, number of words which still contain pattern is counted and high-water mark is calculated.
+ * Stack limits are taken from linker, so there is nothing to keep in sync with startup file or linker script:
+ *  - Keil: <code>STACK</code> section from startup file (<code>STACK$$Base</code> and <code>STACK$$Limit</code>)
+ *  - GCC: <code>_estack</code> and <code>_Min_Stack_Size</code> symbols from linker script
+ *  - IAR: <code>CSTACK</code> block from linker configuration
+ *
+ * With other compilers, top of stack is read from vector table and stack size is set with <code>MEMMON_STACK_SIZE</code> macro.
+ *
+ * \par Heap
+ *
+ * Libraries allocate memory with <code>LIB_ALLOC_FUNC</code> and <code>LIB_FREE_FUNC</code> macros.
+ * When they are set to @ref TM_MEMMON_Malloc and @ref TM_MEMMON_Free, each block gets small header with its size
+ * and library counts live bytes, peak usage and number of allocations.
+ *
+@code
+//In defines.h file
+#include "stddef.h"
+void* TM_MEMMON_Malloc(size_t size);
+void TM_MEMMON_Free(void* ptr);
+
+#define LIB_ALLOC_FUNC      TM_MEMMON_Malloc
+#define LIB_FREE_FUNC       TM_MEMMON_Free
+@endcode
+ *
+ * Heap fragmentation is measured on request by allocating largest possible blocks until heap is full.
+ * Size of largest block and sum of all blocks give fragmentation, <code>100 - 100 * largest / free</code>.
+ * This takes some time and must not be done when other code can allocate memory meanwhile.
+ *
+ * \par FreeRTOS
+ *
+ * When <code>MEMMON_FREERTOS</code> is set to 1, snapshot also contains FreeRTOS heap free space
+ * and stack headroom of each task. <code>configUSE_TRACE_FACILITY</code> must be enabled in FreeRTOSConfig.h file.
+ * If there are more tasks than <code>MEMMON_MAX_TASKS</code>, FreeRTOS does not fill any of them,
+ * <code>TaskCount</code> is 0 and <code>TaskOverflow</code> is set to 1.
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Main stack limits are taken from linker symbols
+  - Snapshot reports when there are more tasks than MEMMON_MAX_TASKS
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - FreeRTOS, when MEMMON_FREERTOS is used
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+#include "stdlib.h"
+
+/**
+ * @defgroup TM_MEMMON_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Size of main stack in units of bytes, used only when compiler is not Keil, GCC or IAR
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef MEMMON_STACK_SIZE
+#define MEMMON_STACK_SIZE         0x400
+#endif
+
+/**
+ * @brief  Size of heap in units of bytes, used as upper limit for fragmentation measurement
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef MEMMON_HEAP_SIZE
+#define MEMMON_HEAP_SIZE          0x200
+#endif
+
+/**
+ * @brief  Allocation functions used by @ref TM_MEMMON_Malloc and @ref TM_MEMMON_Free
+ * @note   Should be changes in defines.h file if necessary, for example to pvPortMalloc and vPortFree
+ */
+#ifndef MEMMON_ALLOC_FUNC
+#define MEMMON_ALLOC_FUNC         malloc
+#endif
+#ifndef MEMMON_FREE_FUNC
+#define MEMMON_FREE_FUNC          free
+#endif
+
+/**
+ * @brief  Set to 1 to include FreeRTOS heap and task stacks to snapshot
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef MEMMON_FREERTOS
+#define MEMMON_FREERTOS           0
+#endif
+
+/**
+ * @brief  Maximal number of FreeRTOS tasks in snapshot
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef MEMMON_MAX_TASKS
+#define MEMMON_MAX_TASKS          8
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_MEMMON_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  FreeRTOS task stack information
+ */
+typedef struct {
+	const char* Name;           /*!< Task name */
+	uint32_t Headroom;          /*!< Minimal free stack since task was created in units of bytes */
+} TM_MEMMON_Task_t;
+
+/**
+ * @brief  Memory usage snapshot
+ */
+typedef struct {
+	uint32_t StackSize;         /*!< Main stack size in units of bytes */
+	uint32_t StackUsed;         /*!< Maximal main stack usage (high-water mark) in units of bytes */
+	uint32_t HeapLive;          /*!< Currently allocated bytes */
+	uint32_t HeapPeak;          /*!< Maximal allocated bytes at the same time */
+	uint32_t HeapAllocs;        /*!< Number of successful allocations */
+	uint32_t HeapFrees;         /*!< Number of frees */
+	uint32_t HeapFailed;        /*!< Number of failed allocations */
+	uint32_t HeapErrors;        /*!< Number of frees with invalid pointer */
+	uint32_t HeapFree;          /*!< Free heap bytes, valid only if heap was probed */
+	uint32_t HeapLargest;       /*!< Largest block which can be allocated, valid only if heap was probed */
+	uint8_t HeapFragmentation;  /*!< Heap fragmentation in percent, valid only if heap was probed */
+#if MEMMON_FREERTOS || defined(__DOXYGEN__)
+	uint32_t RTOSHeapFree;      /*!< FreeRTOS heap free bytes */
+	uint32_t RTOSHeapMinFree;   /*!< Minimal FreeRTOS heap free bytes since start */
+	uint8_t TaskCount;          /*!< Number of valid entries in Tasks array */
+	uint8_t TaskOverflow;       /*!< Set to 1 when there are more than MEMMON_MAX_TASKS tasks and Tasks array is not filled */
+	TM_MEMMON_Task_t Tasks[MEMMON_MAX_TASKS]; /*!< Stack headroom of tasks */
+#endif
+} TM_MEMMON_Snapshot_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_MEMMON_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Fills unused part of main stack with pattern
+ * @note   Call it as soon as possible in main function
+ * @param  None
+ * @retval None
+ */
+void TM_MEMMON_Init(void);
+
+/**
+ * @brief  Allocates memory and counts allocated bytes
+ * @param  size: Number of bytes to allocate
+ * @retval Pointer to allocated memory or NULL on failure
+ */
+void* TM_MEMMON_Malloc(size_t size);
+
+/**
+ * @brief  Frees memory allocated with @ref TM_MEMMON_Malloc
+ * @param  *ptr: Pointer to memory. NULL is ignored
+ * @retval None
+ */
+void TM_MEMMON_Free(void* ptr);
+
+/**
+ * @brief  Gets main stack high-water mark
+ * @param  None
+ * @retval Maximal number of used stack bytes since @ref TM_MEMMON_Init
+ */
+uint32_t TM_MEMMON_GetStackUsed(void);
+
+/**
+ * @brief  Gets memory usage snapshot
+ * @param  *Snapshot: Pointer to @ref TM_MEMMON_Snapshot_t structure to fill
+ * @param  ProbeHeap: Set to 1 to measure free heap and fragmentation, it takes some time
+ * @retval None
+ */
+void TM_MEMMON_GetSnapshot(TM_MEMMON_Snapshot_t* Snapshot, uint8_t ProbeHeap);
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
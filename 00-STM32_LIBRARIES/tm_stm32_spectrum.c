@@ -0,0 +1,233 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_spectrum.h"
+
+static float32_t TM_SPECTRUM_INT_Energy(const TM_SPECTRUM_t* Spectrum, uint32_t Start, uint32_t End);
+
+void TM_SPECTRUM_Init(TM_SPECTRUM_t* Spectrum, const float32_t* Data, uint16_t Bins, float32_t BinWidth, uint8_t Power) {
+	/* Save parameters */
+	Spectrum->Data = Data;
+	Spectrum->Bins = Bins;
+	Spectrum->BinWidth = BinWidth;
+	Spectrum->Power = Power;
+}
+
+uint16_t TM_SPECTRUM_Peaks(const TM_SPECTRUM_t* Spectrum, TM_SPECTRUM_Peak_t* Peaks, uint16_t Count, float32_t Threshold) {
+	const float32_t* d = Spectrum->Data;
+	float32_t a, b, c, p, v, den;
+	uint16_t i, j, found = 0;
+	
+	/* Check for space */
+	if (Count == 0) {
+		return 0;
+	}
+	
+	/* Check all local maxima */
+	for (i = 1; i + 1 < Spectrum->Bins; i++) {
+		b = d[i];
+		
+		/* Check threshold and neighbours */
+		if (b < Threshold || b <= d[i - 1] || b < d[i + 1]) {
+			continue;
+		}
+		
+		/* Parabolic interpolation through 3 points */
+		a = d[i - 1];
+		c = d[i + 1];
+		den = a - 2.0f * b + c;
+		p = den != 0.0f ? 0.5f * (a - c) / den : 0.0f;
+		v = b - 0.25f * (a - c) * p;
+		
+		/* Check if interpolated value is higher than lowest saved peak */
+		if (found == Count && v <= Peaks[found - 1].Value) {
+			continue;
+		}
+		
+		/* Insert peak to array sorted by interpolated value, lowest peak drops out if array is full */
+		if (found < Count) {
+			found++;
+		}
+		for (j = found - 1; j > 0 && Peaks[j - 1].Value < v; j--) {
+			Peaks[j] = Peaks[j - 1];
+		}
+		Peaks[j].Bin = (float32_t)i + p;
+		Peaks[j].Frequency = Peaks[j].Bin * Spectrum->BinWidth;
+		Peaks[j].Value = v;
+	}
+	
+	/* Return number of peaks */
+	return found;
+}
+
+void TM_SPECTRUM_BandEnergy(const TM_SPECTRUM_t* Spectrum, const TM_SPECTRUM_Band_t* Bands, float32_t* Energy, uint16_t Count) {
+	int32_t start, end;
+	
+	/* Calculate each band */
+	while (Count--) {
+		/* Get bins in band, rounded to nearest bin */
+		start = (int32_t)(Bands->Low / Spectrum->BinWidth + 0.5f);
+		end = (int32_t)(Bands->High / Spectrum->BinWidth + 0.5f);
+		if (start < 0) {
+			start = 0;
+		}
+		if (end > Spectrum->Bins) {
+			end = Spectrum->Bins;
+		}
+		
+		/* Calculate energy */
+		*Energy++ = start < end ? TM_SPECTRUM_INT_Energy(Spectrum, start, end) : 0;
+		Bands++;
+	}
+}
+
+float32_t TM_SPECTRUM_Centroid(const TM_SPECTRUM_t* Spectrum) {
+	const float32_t* d = Spectrum->Data;
+	float32_t sum, weighted = 0;
+	uint32_t i, n = Spectrum->Bins;
+	
+	/* Sum of all bins with vector function */
+	arm_mean_f32((float32_t *)d, n, &sum);
+	sum *= n;
+	if (sum <= 0.0f) {
+		return 0;
+	}
+	
+	/* Sum of bins weighted with index, 4 at a time */
+	for (i = 0; i + 4 <= n; i += 4) {
+		weighted += (float32_t)i * (d[i] + d[i + 1] + d[i + 2] + d[i + 3]) + d[i + 1] + 2.0f * d[i + 2] + 3.0f * d[i + 3];
+	}
+	for (; i < n; i++) {
+		weighted += (float32_t)i * d[i];
+	}
+	
+	/* Return center of mass in Hz */
+	return weighted / sum * Spectrum->BinWidth;
+}
+
+float32_t TM_SPECTRUM_THD(const TM_SPECTRUM_t* Spectrum, float32_t Fundamental, uint8_t Harmonics, float32_t* Levels) {
+	float32_t value, first = 0, rest = 0, energy, spacing;
+	uint32_t index, center, start, end, width, last = 1;
+	uint8_t h;
+	
+	/* There is no bin except DC */
+	if (Spectrum->Bins < 2) {
+		if (Levels) {
+			for (h = 1; h <= Harmonics; h++) {
+				Levels[h - 1] = 0;
+			}
+		}
+		return 0;
+	}
+	
+	/* Use highest bin as fundamental, DC is ignored */
+	if (Fundamental <= 0.0f) {
+		arm_max_f32((float32_t *)&Spectrum->Data[1], Spectrum->Bins - 1, &value, &index);
+		Fundamental = (float32_t)(index + 1) * Spectrum->BinWidth;
+	}
+	
+	/* Window around harmonic, at least 1 bin and not wider than half of distance between harmonics */
+	spacing = Fundamental / Spectrum->BinWidth;
+	width = SPECTRUM_HARMONIC_WIDTH > 0 ? SPECTRUM_HARMONIC_WIDTH : 1;
+	if (spacing < 2.0f * width + 1.0f) {
+		width = spacing >= 3.0f ? (uint32_t)((spacing - 1.0f) / 2.0f) : 1;
+	}
+	
+	/* Check each harmonic */
+	for (h = 1; h <= Harmonics; h++) {
+		/* Expected bin */
+		center = (uint32_t)(Fundamental * h / Spectrum->BinWidth + 0.5f);
+		if (center + width >= Spectrum->Bins) {
+			break;
+		}
+		
+		/* Find real peak near expected bin, bins of previous harmonic are not used again */
+		start = center > width ? center - width : 1;
+		if (start < last) {
+			start = last;
+		}
+		end = center + width + 1;
+		if (start >= end) {
+			break;
+		}
+		arm_max_f32((float32_t *)&Spectrum->Data[start], end - start, &value, &index);
+		center = start + index;
+		
+		/* Energy of peak with leakage to neighbour bins */
+		start = center > width ? center - width : 1;
+		if (start < last) {
+			start = last;
+		}
+		end = center + width + 1;
+		if (end > Spectrum->Bins) {
+			end = Spectrum->Bins;
+		}
+		energy = TM_SPECTRUM_INT_Energy(Spectrum, start, end);
+		last = end;
+		
+		/* Save level */
+		if (Levels) {
+			arm_sqrt_f32(energy, &Levels[h - 1]);
+		}
+		
+		/* Fundamental or harmonic */
+		if (h == 1) {
+			first = energy;
+		} else {
+			rest += energy;
+		}
+	}
+	
+	/* Set unused levels */
+	if (Levels) {
+		for (; h <= Harmonics; h++) {
+			Levels[h - 1] = 0;
+		}
+	}
+	
+	/* Check fundamental */
+	if (first <= 0.0f) {
+		return 0;
+	}
+	
+	/* Calculate THD */
+	arm_sqrt_f32(rest / first, &value);
+	return value;
+}
+
+/* Calculates sum of squared magnitudes between bins */
+static float32_t TM_SPECTRUM_INT_Energy(const TM_SPECTRUM_t* Spectrum, uint32_t Start, uint32_t End) {
+	float32_t result;
+	
+	if (Spectrum->Power) {
+		/* Bins are already squared, sum them */
+		arm_mean_f32((float32_t *)&Spectrum->Data[Start], End - Start, &result);
+		return result * (End - Start);
+	}
+	
+	/* Sum of squares */
+	arm_power_f32((float32_t *)&Spectrum->Data[Start], End - Start, &result);
+	return result;
+}
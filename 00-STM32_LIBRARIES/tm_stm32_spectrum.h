@@ -0,0 +1,254 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   Spectral feature extraction for FFT results on STM32Fxxx
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_SPECTRUM_H
+#define TM_SPECTRUM_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_SPECTRUM
+ * @brief    Spectral feature extraction for FFT results on STM32Fxxx
+ * @{
+ *
+ * Library reduces spectrum with thousands of bins, calculated with @ref TM_FFT or @ref TM_STFT,
+ * to a few numbers which describe it. It works directly on spectrum buffer and does not need any additional memory.
+ *
+ * Supported features:
+ *
+\verbatim
+ - Top N peaks:        Local maxima sorted by value, frequency and value refined with parabolic interpolation
+ - Band energies:      Energy in table of frequency bands, like octave or machine specific bands
+ - Spectral centroid:  Center of mass of spectrum in Hz
+ - Harmonics and THD:  Levels of fundamental and its harmonics and total harmonic distortion
+\endverbatim
+ *
+ * Spectrum can hold magnitude or power (magnitude squared) of each bin, what is set with <b>Power</b> parameter in @ref TM_SPECTRUM_Init.
+ * Energies are always calculated as sum of squared magnitudes.
+ *
+ * Bin width is sample rate divided by FFT size. For 20kHz sample rate and 4096 FFT, bin width is 4.8828125Hz.
+ *
+ * \par Example
+ *
+@code
+TM_SPECTRUM_t Spectrum;
+TM_SPECTRUM_Peak_t Peaks[5];
+const TM_SPECTRUM_Band_t Bands[] = {{10, 100}, {100, 1000}, {1000, 10000}};
+float32_t Energy[3], THD, Centroid;
+
+//Magnitude of 2048 bins from 4096 real FFT at 20kHz
+TM_FFT_Magnitude_Real_F32(&FFT, FFT.Input);
+TM_SPECTRUM_Init(&Spectrum, FFT.Input, 2048, 20000.0f / 4096, 0);
+
+//Get features
+TM_SPECTRUM_Peaks(&Spectrum, Peaks, 5, 0.01f);
+TM_SPECTRUM_BandEnergy(&Spectrum, Bands, Energy, 3);
+Centroid = TM_SPECTRUM_Centroid(&Spectrum);
+THD = TM_SPECTRUM_THD(&Spectrum, 0, 10, NULL);
+@endcode
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - ARM MATH
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+
+#include "arm_math.h"
+
+/**
+ * @defgroup TM_SPECTRUM_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Number of bins on each side of expected harmonic frequency where harmonic peak is searched
+ *         and summed for harmonic energy. Must cover main lobe of used window
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef SPECTRUM_HARMONIC_WIDTH
+#define SPECTRUM_HARMONIC_WIDTH      2
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_SPECTRUM_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Spectrum description
+ */
+typedef struct {
+	const float32_t* Data; /*!< Pointer to spectrum bins, bin 0 is DC */
+	uint16_t Bins;         /*!< Number of bins */
+	uint8_t Power;         /*!< Set to 1 if bins hold power, 0 if bins hold magnitude */
+	float32_t BinWidth;    /*!< Frequency width of one bin in units of Hz */
+} TM_SPECTRUM_t;
+
+/**
+ * @brief  Spectrum peak
+ */
+typedef struct {
+	float32_t Bin;         /*!< Interpolated position of peak in units of bins */
+	float32_t Frequency;   /*!< Interpolated frequency of peak in units of Hz */
+	float32_t Value;       /*!< Interpolated value of peak, the same unit as spectrum */
+} TM_SPECTRUM_Peak_t;
+
+/**
+ * @brief  Frequency band
+ */
+typedef struct {
+	float32_t Low;         /*!< Lower band frequency in units of Hz, included */
+	float32_t High;        /*!< Upper band frequency in units of Hz, not included */
+} TM_SPECTRUM_Band_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_SPECTRUM_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes spectrum description
+ * @param  *Spectrum: Pointer to empty @ref TM_SPECTRUM_t structure
+ * @param  *Data: Pointer to spectrum bins
+ * @param  Bins: Number of bins, usually FFT_Size / 2
+ * @param  BinWidth: Frequency width of one bin in units of Hz, sample rate / FFT_Size
+ * @param  Power: Set to 1 if bins hold power (magnitude squared) or 0 if bins hold magnitude
+ * @retval None
+ */
+void TM_SPECTRUM_Init(TM_SPECTRUM_t* Spectrum, const float32_t* Data, uint16_t Bins, float32_t BinWidth, uint8_t Power);
+
+/**
+ * @brief  Finds highest peaks in spectrum
+ * @note   Peak is bin which is higher than both neighbours. DC bin is not checked
+ * @param  *Spectrum: Pointer to @ref TM_SPECTRUM_t structure
+ * @param  *Peaks: Pointer to array of @ref TM_SPECTRUM_Peak_t structures, sorted from highest peak on return
+ * @param  Count: Maximal number of peaks to find
+ * @param  Threshold: Minimal bin value for peak
+ * @retval Number of found peaks
+ */
+uint16_t TM_SPECTRUM_Peaks(const TM_SPECTRUM_t* Spectrum, TM_SPECTRUM_Peak_t* Peaks, uint16_t Count, float32_t Threshold);
+
+/**
+ * @brief  Calculates energy in frequency bands
+ * @param  *Spectrum: Pointer to @ref TM_SPECTRUM_t structure
+ * @param  *Bands: Pointer to table of @ref TM_SPECTRUM_Band_t bands
+ * @param  *Energy: Pointer to output array with sum of squared magnitudes for each band
+ * @param  Count: Number of bands
+ * @retval None
+ */
+void TM_SPECTRUM_BandEnergy(const TM_SPECTRUM_t* Spectrum, const TM_SPECTRUM_Band_t* Bands, float32_t* Energy, uint16_t Count);
+
+/**
+ * @brief  Calculates spectral centroid
+ * @note   Bins are weighted with their values
+ * @param  *Spectrum: Pointer to @ref TM_SPECTRUM_t structure
+ * @retval Centroid frequency in units of Hz or 0 if spectrum is empty
+ */
+float32_t TM_SPECTRUM_Centroid(const TM_SPECTRUM_t* Spectrum);
+
+/**
+ * @brief  Detects fundamental and harmonics and calculates total harmonic distortion
+ * @note   Harmonic peak is searched in @ref SPECTRUM_HARMONIC_WIDTH bins around multiple of fundamental frequency
+ *         and its energy is sum of bins around peak, so leakage of window is included.
+ *         Width is at least 1 bin and is reduced for low fundamental frequency, so bins of one harmonic are not used for next one
+ * @param  *Spectrum: Pointer to @ref TM_SPECTRUM_t structure
+ * @param  Fundamental: Fundamental frequency in units of Hz. Set to 0 to use highest bin
+ * @param  Harmonics: Number of harmonics including fundamental. Harmonics above last bin are ignored
+ * @param  *Levels: Pointer to array of Harmonics length where RMS magnitude of each harmonic is saved, fundamental first.
+ *            Set to NULL if not used
+ * @retval THD as ratio between RMS of harmonics and fundamental, multiply by 100 for percent
+ */
+float32_t TM_SPECTRUM_THD(const TM_SPECTRUM_t* Spectrum, float32_t Fundamental, uint8_t Harmonics, float32_t* Levels);
+
+/**
+ * @brief  Converts bin position to frequency
+ * @param  Spectrum: Pointer to @ref TM_SPECTRUM_t structure
+ * @param  bin: Bin position
+ * @retval Frequency in units of Hz
+ * @note   Defined as macro for faster execution
+ */
+#define TM_SPECTRUM_BinToFrequency(Spectrum, bin)   ((float32_t)(bin) * (Spectrum)->BinWidth)
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -33,6 +33,8 @@ typedef struct {
 	DMA_Stream_TypeDef* RX_Stream;
 	uint32_t Dummy32;
 	uint16_t Dummy16;
+	uint8_t* RX_Buffer;
+	uint16_t RX_Count;
 } TM_SPI_DMA_INT_t;
 
 /* Private variables */
@@ -57,6 +59,7 @@ static TM_SPI_DMA_INT_t SPI6_DMA_INT = {SPI6_DMA_TX_CHANNEL, SPI6_DMA_TX_STREAM,
 
 /* Private functions */
 static TM_SPI_DMA_INT_t* TM_SPI_DMA_INT_GetSettings(SPI_TypeDef* SPIx);
+static uint8_t TM_SPI_DMA_INT_ProcessRX(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param);
 	
 void TM_SPI_DMA_Init(SPI_TypeDef* SPIx) {
 	/* Init DMA TX mode */
@@ -158,8 +161,15 @@ uint8_t TM_SPI_DMA_Transmit(SPI_TypeDef* SPIx, const uint8_t* TX_Buffer, const u
 	
 	/* Start DMA */
 	if (RX_Buffer != NULL) {
+		/* Write cached data to memory, buffer is invalidated in transfer complete interrupt */
+		TM_DMA_CleanDCache(RX_Buffer, count);
+		Settings->RX_Buffer = (uint8_t *)RX_Buffer;
+		Settings->RX_Count = count;
+		TM_DMA_SetHandler(Settings->RX_Stream, TM_SPI_DMA_INT_ProcessRX, Settings);
+		TM_DMA_EnableInterrupts(Settings->RX_Stream);
 		TM_DMA_Start(&DMA_InitStruct, (uint32_t) &SPIx->DR, (uint32_t) RX_Buffer, count);
 	} else {
+		Settings->RX_Buffer = NULL;
 		TM_DMA_Start(&DMA_InitStruct, (uint32_t) &SPIx->DR, (uint32_t) &Settings->Dummy32, count);
 	}
 	
@@ -188,6 +198,7 @@ uint8_t TM_SPI_DMA_Transmit(SPI_TypeDef* SPIx, const uint8_t* TX_Buffer, const u
 	
 	/* Start DMA */
 	if (TX_Buffer != NULL) {
+		TM_DMA_CleanDCache(TX_Buffer, count);
 		TM_DMA_Start(&DMA_InitStruct, (uint32_t) TX_Buffer, (uint32_t) &SPIx->DR, count);
 	} else {
 		TM_DMA_Start(&DMA_InitStruct, (uint32_t) &Settings->Dummy32, (uint32_t) &SPIx->DR, count);
@@ -230,6 +241,7 @@ uint8_t TM_SPI_DMA_SendByte(SPI_TypeDef* SPIx, uint8_t value, uint16_t count) {
 	
 	/* Set dummy memory to value we specify */
 	Settings->Dummy32 = value;
+	TM_DMA_CleanDCache(&Settings->Dummy32, sizeof(Settings->Dummy32));
 	
 	/* Deinit first TX stream */
 	TM_DMA_ClearFlag(Settings->TX_Stream, DMA_FLAG_ALL);
@@ -275,6 +287,7 @@ uint8_t TM_SPI_DMA_SendHalfWord(SPI_TypeDef* SPIx, uint16_t value, uint16_t coun
 	
 	/* Set dummy memory to value we specify */
 	Settings->Dummy16 = value;
+	TM_DMA_CleanDCache(&Settings->Dummy16, sizeof(Settings->Dummy16));
 	
 	/* Deinit first TX stream */
 	TM_DMA_ClearFlag(Settings->TX_Stream, DMA_FLAG_ALL);
@@ -292,16 +305,127 @@ uint8_t TM_SPI_DMA_SendHalfWord(SPI_TypeDef* SPIx, uint16_t value, uint16_t coun
 	return 1;
 }
 
+uint8_t TM_SPI_DMA_SendChain(SPI_TypeDef* SPIx, TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters) {
+	/* Get SPI settings */
+	TM_SPI_DMA_INT_t* Settings = TM_SPI_DMA_INT_GetSettings(SPIx);
+	
+	/* Check if DMA available */
+	if (Settings->TX_Stream->NDTR || (Settings->TX_Stream->CR & DMA_SxCR_EN)) {
+		return 0;
+	}
+	
+#if defined(STM32F7xx)
+    CLEAR_BIT(SPIx->CR1, SPI_CR1_SPE);
+    CLEAR_BIT(SPIx->CR2, SPI_CR2_LDMATX);
+    CLEAR_BIT(SPIx->CR2, SPI_CR2_DS_0 | SPI_CR2_DS_1 | SPI_CR2_DS_2 | SPI_CR2_DS_3);
+    SET_BIT(SPIx->CR2, SPI_CR2_DS_0 | SPI_CR2_DS_1 | SPI_CR2_DS_2);
+#endif
+	
+	/* Init chain on TX stream */
+	TM_DMA_SG_Init(SG, Settings->TX_Stream, Settings->TX_Channel, DMA_MEMORY_TO_PERIPH, (uint32_t) &SPIx->DR, 1);
+	
+	/* Enable SPI TX DMA */
+	SET_BIT(SPIx->CR2, SPI_CR2_TXDMAEN);
+	SET_BIT(SPIx->CR1, SPI_CR1_SPE);
+	
+	/* Start chain */
+	return TM_DMA_SG_Start(SG, First, Callback, UserParameters);
+}
+
+uint8_t TM_SPI_DMA_ReceiveDoubleBuffer(SPI_TypeDef* SPIx, TM_DMA_DB_t* DB, uint8_t* Buffer0, uint8_t* Buffer1, uint16_t Length, TM_DMA_DB_Callback_t Callback, void* UserParameters) {
+	DMA_HandleTypeDef DMA_InitStruct;
+	
+	/* Get SPI settings */
+	TM_SPI_DMA_INT_t* Settings = TM_SPI_DMA_INT_GetSettings(SPIx);
+	
+	/* Check if DMA available */
+	if (Settings->RX_Stream->NDTR || Settings->TX_Stream->NDTR) {
+		return 0;
+	}
+	
+#if defined(STM32F7xx)
+    CLEAR_BIT(SPIx->CR1, SPI_CR1_SPE);
+    CLEAR_BIT(SPIx->CR2, SPI_CR2_LDMATX);
+    CLEAR_BIT(SPIx->CR2, SPI_CR2_LDMARX);
+    CLEAR_BIT(SPIx->CR2, SPI_CR2_DS_0 | SPI_CR2_DS_1 | SPI_CR2_DS_2 | SPI_CR2_DS_3);
+    SET_BIT(SPIx->CR2, SPI_CR2_DS_0 | SPI_CR2_DS_1 | SPI_CR2_DS_2);
+#endif
+	
+	/* Start RX stream in double buffer mode */
+	TM_DMA_DB_Init(DB, Settings->RX_Stream, Settings->RX_Channel, DMA_PERIPH_TO_MEMORY, (uint32_t) &SPIx->DR, 1);
+	if (!TM_DMA_DB_Start(DB, Buffer0, Buffer1, Length, Callback, UserParameters)) {
+		return 0;
+	}
+	SET_BIT(SPIx->CR2, SPI_CR2_RXDMAEN);
+	
+	/* Master needs to send data to generate clock */
+	if (SPIx->CR1 & SPI_CR1_MSTR) {
+		/* Set DMA default */
+		DMA_InitStruct.Instance = Settings->TX_Stream;
+		DMA_InitStruct.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+		DMA_InitStruct.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+		DMA_InitStruct.Init.PeriphInc = DMA_PINC_DISABLE;
+		DMA_InitStruct.Init.Mode = DMA_CIRCULAR;
+		DMA_InitStruct.Init.Priority = DMA_PRIORITY_LOW;
+		DMA_InitStruct.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+		DMA_InitStruct.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+		DMA_InitStruct.Init.MemBurst = DMA_MBURST_SINGLE;
+		DMA_InitStruct.Init.PeriphBurst = DMA_PBURST_SINGLE;
+		DMA_InitStruct.Init.MemInc = DMA_MINC_DISABLE;
+		DMA_InitStruct.Init.Channel = Settings->TX_Channel;
+		DMA_InitStruct.Init.Direction = DMA_MEMORY_TO_PERIPH;
+		
+		/* Send zeros, write them to memory for DMA */
+		Settings->Dummy32 = 0;
+		TM_DMA_CleanDCache(&Settings->Dummy32, sizeof(Settings->Dummy32));
+		
+		/* Deinit first TX stream */
+		TM_DMA_ClearFlag(Settings->TX_Stream, DMA_FLAG_ALL);
+		
+		/* Init TX stream */
+		TM_DMA_Init(Settings->TX_Stream, &DMA_InitStruct);
+		
+		/* Start TX stream */
+		TM_DMA_Start(&DMA_InitStruct, (uint32_t) &Settings->Dummy32, (uint32_t) &SPIx->DR, Length);
+		
+		/* Enable SPI TX DMA */
+		SET_BIT(SPIx->CR2, SPI_CR2_TXDMAEN);
+	}
+	
+	/* Enable SPI */
+	SET_BIT(SPIx->CR1, SPI_CR1_SPE);
+	
+	/* Return OK */
+	return 1;
+}
+
+void TM_SPI_DMA_StopDoubleBuffer(SPI_TypeDef* SPIx, TM_DMA_DB_t* DB) {
+	/* Get SPI settings */
+	TM_SPI_DMA_INT_t* Settings = TM_SPI_DMA_INT_GetSettings(SPIx);
+	
+	/* Stop clock generation first */
+	Settings->TX_Stream->CR &= ~DMA_SxCR_EN;
+	CLEAR_BIT(SPIx->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+	
+	/* Stop RX stream */
+	TM_DMA_DB_Stop(DB);
+}
+
 uint8_t TM_SPI_DMA_Transmitting(SPI_TypeDef* SPIx) {
 	/* Get SPI settings */
 	TM_SPI_DMA_INT_t* Settings = TM_SPI_DMA_INT_GetSettings(SPIx);
 	
 	/* Check if TX or RX DMA are working */
-	return (
+	if (
 		Settings->RX_Stream->NDTR || /*!< RX is working */
 		Settings->TX_Stream->NDTR || /*!< TX is working */
 		SPI_IS_BUSY(SPIx)            /*!< SPI is busy */
-	);
+	) {
+		return 1;
+	}
+	
+	/* DMA is not working */
+	return 0;
 }
 
 DMA_Stream_TypeDef* TM_SPI_DMA_GetStreamTX(SPI_TypeDef* SPIx) {
@@ -333,6 +457,19 @@ void TM_SPI_DMA_DisableInterrupts(SPI_TypeDef* SPIx) {
 }
 
 /* Private functions */
+static uint8_t TM_SPI_DMA_INT_ProcessRX(DMA_Stream_TypeDef* DMA_Stream, uint32_t flags, void* Param) {
+	TM_SPI_DMA_INT_t* Settings = (TM_SPI_DMA_INT_t *)Param;
+	
+	/* Transfer done, drop cached lines of received data before user callback reads them */
+	if ((flags & DMA_FLAG_TCIF) && Settings->RX_Buffer != NULL) {
+		TM_DMA_InvalidateDCache(Settings->RX_Buffer, Settings->RX_Count);
+		Settings->RX_Buffer = NULL;
+	}
+	
+	/* Let user handle interrupts */
+	return 0;
+}
+
 static TM_SPI_DMA_INT_t* TM_SPI_DMA_INT_GetSettings(SPI_TypeDef* SPIx) {
 	TM_SPI_DMA_INT_t* result;
 #ifdef SPI1
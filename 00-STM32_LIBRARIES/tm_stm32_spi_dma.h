@@ -35,7 +35,7 @@
 @endverbatim
  */
 #ifndef TM_SPI_DMA_H
-#define TM_SPI_DMA_H 100
+#define TM_SPI_DMA_H 120
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -78,6 +78,14 @@ SPI6     | DMA2 | DMA Stream 5  | DMA Channel 1  | DMA Stream 6  | DMA Channel 0
 @verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added support for sending scatter-gather descriptor chains
+
+ Version 1.2
+  - October 19, 2026
+  - Added continuous receive with RX DMA in double buffer mode
 @endverbatim
  *
  * \par Dependencies
@@ -216,6 +224,8 @@ void TM_SPI_DMA_Deinit(SPI_TypeDef* SPIx);
 /**
  * @brief  Transmits (exchanges) data over SPI with DMA
  * @note   Try not to use local variables pointers for DMA memory as TX and RX Buffers
+ * @note   When RX_Buffer is used, RX stream interrupts are enabled. On STM32F7xx, data cache for RX buffer
+ *         is invalidated in transfer complete interrupt, before @ref TM_DMA_TransferCompleteHandler is called
  * @param  *SPIx: Pointer to SPIx where DMA transmission will happen
  * @param  *TX_Buffer: Pointer to TX_Buffer where DMA will take data to sent over SPI.
  *            Set this parameter to NULL, if you want to sent "0x00" and only receive data into *RX_Buffer pointer
@@ -276,6 +286,46 @@ uint8_t TM_SPI_DMA_SendByte(SPI_TypeDef* SPIx, uint8_t value, uint16_t count);
  */
 uint8_t TM_SPI_DMA_SendHalfWord(SPI_TypeDef* SPIx, uint16_t value, uint16_t count);
 
+/**
+ * @brief  Sends chain of descriptors over SPI with TX DMA, received data are ignored
+ * @note   Fragments are sent one after another without copying them to one buffer first. Check @ref TM_DMA for more info
+ * @note   Use @ref TM_DMA_SG_IsBusy to check if chain is still in transfer
+ * @param  *SPIx: Pointer to SPIx where DMA transmission will happen
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure for chain. It is initialized by this function
+ * @param  *First: Pointer to first descriptor in chain
+ * @param  Callback: Callback called when last descriptor is transferred to SPI. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Transmission started status:
+ *            - 0: DMA has not started with sending data
+ *            - > 0: DMA has started with sending data
+ */
+uint8_t TM_SPI_DMA_SendChain(SPI_TypeDef* SPIx, TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Starts continuous receive over SPI to 2 buffers with RX DMA in double buffer mode
+ * @note   When SPI is master, TX DMA sends dummy bytes (0x00) in circular mode to generate clock
+ * @note   Callback is called from DMA interrupt each time one buffer is full
+ * @param  *SPIx: Pointer to SPIx where DMA reception will happen
+ * @param  *DB: Pointer to empty @ref TM_DMA_DB_t structure
+ * @param  *Buffer0: Pointer to first buffer
+ * @param  *Buffer1: Pointer to second buffer
+ * @param  Length: Number of bytes in each buffer
+ * @param  Callback: Buffer full callback function. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Receiving started status:
+ *            - 0: DMA has not started with receiving data
+ *            - > 0: DMA has started with receiving data
+ */
+uint8_t TM_SPI_DMA_ReceiveDoubleBuffer(SPI_TypeDef* SPIx, TM_DMA_DB_t* DB, uint8_t* Buffer0, uint8_t* Buffer1, uint16_t Length, TM_DMA_DB_Callback_t Callback, void* UserParameters);
+
+/**
+ * @brief  Stops continuous receive started with @ref TM_SPI_DMA_ReceiveDoubleBuffer
+ * @param  *SPIx: Pointer to SPIx where DMA reception happens
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure used on start
+ * @retval None
+ */
+void TM_SPI_DMA_StopDoubleBuffer(SPI_TypeDef* SPIx, TM_DMA_DB_t* DB);
+
 /**
  * @brief  Checks if SPI DMA is still sending/receiving data
  * @param  *SPIx: Pointer to SPIx where you want to enable DMA TX mode
@@ -0,0 +1,317 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_stft.h"
+#include "stdlib.h"
+#include "string.h"
+
+static void TM_STFT_INT_Reset(TM_STFT_t* STFT);
+
+uint8_t TM_STFT_Init(TM_STFT_t* STFT, uint16_t FFT_Size, uint16_t Hop, TM_STFT_Window_t Window, uint16_t SpectraCount, uint8_t use_malloc) {
+	uint32_t size;
+	
+	/* Set default values */
+	memset(STFT, 0, sizeof(TM_STFT_t));
+	STFT->Gain = 1.0f;
+	STFT->WindowType = Window;
+	STFT->Hop = Hop;
+	STFT->SpectraCount = SpectraCount;
+	
+	/* Check parameters */
+	if (Hop == 0 || Hop > FFT_Size || SpectraCount == 0) {
+		return 1;
+	}
+	
+	/* Init real FFT */
+	if (TM_FFT_Init_Real_F32(&STFT->FFT, FFT_Size, use_malloc)) {
+		return use_malloc && STFT->FFT.FFT_Size ? 2 : 1;
+	}
+	
+	/* Allocate other buffers */
+	if (use_malloc) {
+		/* Sample ring length must be power of 2 */
+		size = (uint32_t)FFT_Size * STFT_SAMPLES_MULT;
+		while (size & (size - 1)) {
+			size &= size - 1;
+		}
+		if (size < (uint32_t)FFT_Size * STFT_SAMPLES_MULT) {
+			size <<= 1;
+		}
+		
+		/* Allocate memory */
+		STFT->UseMalloc = 1;
+		STFT->Window = (float32_t *) LIB_ALLOC_FUNC(FFT_Size * sizeof(float32_t));
+		STFT->Samples = (float32_t *) LIB_ALLOC_FUNC(size * sizeof(float32_t));
+		STFT->Spectra = (float32_t *) LIB_ALLOC_FUNC((uint32_t)SpectraCount * (FFT_Size / 2) * sizeof(float32_t));
+		STFT->SamplesSize = size;
+		
+		/* Check for success */
+		if (STFT->Window == NULL || STFT->Samples == NULL || STFT->Spectra == NULL) {
+			TM_STFT_Free(STFT);
+			return 2;
+		}
+		
+		/* Calculate window */
+		TM_STFT_CreateWindow(STFT->Window, FFT_Size, Window);
+	}
+	
+	/* Return OK */
+	return 0;
+}
+
+void TM_STFT_SetBuffers(TM_STFT_t* STFT, float32_t* Input, float32_t* Output, float32_t* Window, float32_t* Samples, uint32_t SamplesSize, float32_t* Spectra) {
+	/* If malloc is used, ignore */
+	if (STFT->UseMalloc) {
+		return;
+	}
+	
+	/* Set pointers */
+	TM_FFT_SetBuffers_Real_F32(&STFT->FFT, Input, Output);
+	STFT->Window = Window;
+	STFT->Samples = Samples;
+	STFT->SamplesSize = SamplesSize;
+	STFT->Spectra = Spectra;
+	
+	/* Calculate window */
+	TM_STFT_CreateWindow(STFT->Window, STFT->FFT.FFT_Size, STFT->WindowType);
+	
+	/* Start from the beginning */
+	TM_STFT_INT_Reset(STFT);
+}
+
+void TM_STFT_SetScale(TM_STFT_t* STFT, float32_t Offset, float32_t Gain) {
+	/* Set values */
+	STFT->Offset = Offset;
+	STFT->Gain = Gain;
+}
+
+void TM_STFT_AddSamples_U16(TM_STFT_t* STFT, const uint16_t* Data, uint16_t Count) {
+	uint32_t mask = STFT->SamplesSize - 1;
+	uint32_t pos = STFT->Written;
+	float32_t offset = STFT->Offset, gain = STFT->Gain;
+	
+	/* Mark samples which will be overwritten */
+	STFT->WriteEnd = pos + Count;
+	
+	/* Only last samples fit to ring, skipped samples are counted as written */
+	if (Count > STFT->SamplesSize) {
+		pos += Count - STFT->SamplesSize;
+		Data += Count - STFT->SamplesSize;
+		Count = STFT->SamplesSize;
+	}
+	
+	/* Convert samples to ring */
+	while (Count--) {
+		STFT->Samples[pos++ & mask] = ((float32_t)*Data++ - offset) * gain;
+	}
+	
+	/* Samples are valid */
+	STFT->Written = pos;
+}
+
+void TM_STFT_AddSamples_F32(TM_STFT_t* STFT, const float32_t* Data, uint16_t Count) {
+	uint32_t pos = STFT->Written;
+	uint32_t index = pos & (STFT->SamplesSize - 1);
+	uint32_t first;
+	
+	/* Mark samples which will be overwritten */
+	STFT->WriteEnd = pos + Count;
+	
+	/* Only last samples fit to ring, skipped samples are counted as written */
+	if (Count > STFT->SamplesSize) {
+		pos += Count - STFT->SamplesSize;
+		Data += Count - STFT->SamplesSize;
+		Count = STFT->SamplesSize;
+		index = pos & (STFT->SamplesSize - 1);
+	}
+	
+	/* Copy up to end of ring and then from beginning */
+	first = STFT->SamplesSize - index;
+	if (first > Count) {
+		first = Count;
+	}
+	memcpy(&STFT->Samples[index], Data, first * sizeof(float32_t));
+	memcpy(STFT->Samples, &Data[first], (Count - first) * sizeof(float32_t));
+	
+	/* Samples are valid */
+	STFT->Written = pos + Count;
+}
+
+#if defined(STM32F4xx) || defined(STM32F7xx)
+void TM_STFT_DMACallback(TM_DMA_DB_t* DB, void* Buffer, void* UserParameters) {
+	/* Ignore transfer error */
+	if (Buffer == NULL) {
+		return;
+	}
+	
+	/* Add completed buffer */
+	TM_STFT_AddSamples_U16((TM_STFT_t *)UserParameters, (const uint16_t *)Buffer, DB->Length);
+}
+#endif
+
+uint16_t TM_STFT_Process(TM_STFT_t* STFT) {
+	uint32_t size = STFT->FFT.FFT_Size;
+	uint32_t mask = STFT->SamplesSize - 1;
+	uint32_t index, first;
+	uint16_t count = 0;
+	float32_t* spectrum;
+	
+	/* Process all frames with enough samples */
+	while ((uint32_t)(STFT->Written - STFT->FrameStart) >= size) {
+		/* Skip frames which were already overwritten */
+		if ((uint32_t)(STFT->WriteEnd - STFT->FrameStart) > STFT->SamplesSize) {
+			STFT->FrameStart += STFT->Hop;
+			STFT->Dropped++;
+			continue;
+		}
+		
+		/* Multiply samples with window, in 2 parts if frame wraps in ring */
+		index = STFT->FrameStart & mask;
+		first = STFT->SamplesSize - index;
+		if (first > size) {
+			first = size;
+		}
+		arm_mult_f32(&STFT->Samples[index], STFT->Window, STFT->FFT.Input, first);
+		if (first < size) {
+			arm_mult_f32(STFT->Samples, &STFT->Window[first], &STFT->FFT.Input[first], size - first);
+		}
+		
+		/* Check if samples were overwritten during copy */
+		if ((uint32_t)(STFT->WriteEnd - STFT->FrameStart) > STFT->SamplesSize) {
+			STFT->FrameStart += STFT->Hop;
+			STFT->Dropped++;
+			continue;
+		}
+		
+		/* Next frame */
+		STFT->FrameStart += STFT->Hop;
+		
+		/* Calculate FFT */
+		TM_FFT_Process_Real_F32(&STFT->FFT);
+		
+		/* Overwrite oldest spectrum if ring is full */
+		if (STFT->Count >= STFT->SpectraCount) {
+			if (++STFT->Tail >= STFT->SpectraCount) {
+				STFT->Tail = 0;
+			}
+			STFT->Count--;
+			STFT->Overwritten++;
+		}
+		
+		/* Save spectrum */
+		spectrum = &STFT->Spectra[(uint32_t)STFT->Head * (size / 2)];
+		if (STFT->Power) {
+			TM_FFT_Power_Real_F32(&STFT->FFT, spectrum);
+		} else {
+			TM_FFT_Magnitude_Real_F32(&STFT->FFT, spectrum);
+		}
+		if (++STFT->Head >= STFT->SpectraCount) {
+			STFT->Head = 0;
+		}
+		STFT->Count++;
+		count++;
+	}
+	
+	/* Return number of new spectra */
+	return count;
+}
+
+float32_t* TM_STFT_GetSpectrum(TM_STFT_t* STFT) {
+	/* Check if empty */
+	if (STFT->Count == 0) {
+		return NULL;
+	}
+	
+	/* Return oldest spectrum */
+	return &STFT->Spectra[(uint32_t)STFT->Tail * (STFT->FFT.FFT_Size / 2)];
+}
+
+void TM_STFT_ReleaseSpectrum(TM_STFT_t* STFT) {
+	/* Remove oldest spectrum */
+	if (STFT->Count) {
+		if (++STFT->Tail >= STFT->SpectraCount) {
+			STFT->Tail = 0;
+		}
+		STFT->Count--;
+	}
+}
+
+void TM_STFT_CreateWindow(float32_t* Window, uint16_t Size, TM_STFT_Window_t Type) {
+	uint16_t i;
+	float32_t x;
+	
+	/* Calculate periodic window */
+	for (i = 0; i < Size; i++) {
+		x = 2.0f * PI * (float32_t)i / (float32_t)Size;
+		switch (Type) {
+			case TM_STFT_Window_Hann:
+				Window[i] = 0.5f - 0.5f * arm_cos_f32(x);
+				break;
+			case TM_STFT_Window_Hamming:
+				Window[i] = 0.54f - 0.46f * arm_cos_f32(x);
+				break;
+			case TM_STFT_Window_BlackmanHarris:
+				Window[i] = 0.35875f - 0.48829f * arm_cos_f32(x) + 0.14128f * arm_cos_f32(2.0f * x) - 0.01168f * arm_cos_f32(3.0f * x);
+				break;
+			default:
+				Window[i] = 1.0f;
+				break;
+		}
+	}
+}
+
+void TM_STFT_Free(TM_STFT_t* STFT) {
+	/* Return, malloc was not used for allocation */
+	if (!STFT->UseMalloc) {
+		return;
+	}
+	
+	/* Free FFT buffers */
+	TM_FFT_Free_Real_F32(&STFT->FFT);
+	
+	/* Free other buffers */
+	if (STFT->Window) {
+		LIB_FREE_FUNC(STFT->Window);
+	}
+	if (STFT->Samples) {
+		LIB_FREE_FUNC(STFT->Samples);
+	}
+	if (STFT->Spectra) {
+		LIB_FREE_FUNC(STFT->Spectra);
+	}
+	STFT->UseMalloc = 0;
+}
+
+/* Resets ring positions */
+static void TM_STFT_INT_Reset(TM_STFT_t* STFT) {
+	STFT->Written = 0;
+	STFT->WriteEnd = 0;
+	STFT->FrameStart = 0;
+	STFT->Head = 0;
+	STFT->Tail = 0;
+	STFT->Count = 0;
+	STFT->Dropped = 0;
+	STFT->Overwritten = 0;
+}
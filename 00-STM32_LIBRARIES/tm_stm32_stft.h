@@ -0,0 +1,383 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   Streaming short-time FFT with overlap and windowing for STM32Fxxx
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_STFT_H
+#define TM_STFT_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_STFT
+ * @brief    Streaming short-time FFT with overlap and windowing for STM32Fxxx
+ * @{
+ *
+ * @ref TM_FFT library processes blocks of samples which do not overlap and samples are added one by one.
+ * This library calculates spectrum of continuous signal every <b>Hop</b> samples over last <b>FFT_Size</b> samples.
+ *
+ * \par How it works
+ *
+ * Samples are added in blocks (directly from ADC DMA buffers) to sample ring with @ref TM_STFT_AddSamples_U16 or @ref TM_STFT_AddSamples_F32.
+ * This is fast and can be done in interrupt.
+ *
+ * @ref TM_STFT_Process is called from main loop or task. For each available frame, samples are multiplied by precomputed window,
+ * real FFT is calculated and magnitude or power spectrum of <b>FFT_Size / 2</b> bins is saved to ring of spectra.
+ * Spectra are then read with @ref TM_STFT_GetSpectrum and @ref TM_STFT_ReleaseSpectrum.
+ *
+ * Overlap is set with hop size. For 75% overlap, hop is FFT_Size / 4.
+ * For example, with 20kHz sample rate, 1024 FFT size and hop of 256 samples, 78 spectra are calculated each second.
+ *
+ * Sample ring is @ref STFT_SAMPLES_MULT times longer than FFT size. 
+ * If @ref TM_STFT_Process is not called fast enough and samples for frame are overwritten, frame is skipped
+ * and dropped frames counter is increased, read it with @ref TM_STFT_GetDropped.
+ * When more samples than ring length are added at once, only last samples are kept and frames over skipped samples are dropped too.
+ * If ring of spectra is full, oldest spectrum is overwritten and overwritten spectra counter is increased, read it with @ref TM_STFT_GetOverwritten.
+ *
+ * \note  @ref TM_STFT_Process, @ref TM_STFT_GetSpectrum and @ref TM_STFT_ReleaseSpectrum must be called from the same context.
+ *
+ * \par Windows
+ *
+ * Window table is calculated once on initialization. Supported windows are:
+ *
+\verbatim
+ - Rectangular:      No window
+ - Hann:             0.5 - 0.5 * cos(2 * pi * n / N)
+ - Hamming:          0.54 - 0.46 * cos(2 * pi * n / N)
+ - Blackman-Harris:  4-term, 0.35875, 0.48829, 0.14128, 0.01168
+\endverbatim
+ *
+ * \par Example with ADC in double buffer mode
+ *
+@code
+TM_STFT_t STFT;
+TM_DMA_DB_t ADC_DB;
+uint16_t ADC_Buffer[2][256];
+float32_t* spectrum;
+
+//1024 FFT, 75% overlap, Hann window, 8 spectra in ring, use malloc
+TM_STFT_Init(&STFT, 1024, 256, TM_STFT_Window_Hann, 8, 1);
+
+//Convert 12-bit ADC value to volts
+TM_STFT_SetScale(&STFT, 2048, 3.3f / 4096);
+
+//Start ADC, samples are added from DMA interrupt
+TM_ADC_DoubleBufferStart(ADC1, TM_ADC_Channel_0, &ADC_DB, ADC_Buffer[0], ADC_Buffer[1], 256, trigger, TM_STFT_DMACallback, &STFT);
+
+while (1) {
+	//Calculate available spectra
+	TM_STFT_Process(&STFT);
+	
+	//Use spectra
+	while ((spectrum = TM_STFT_GetSpectrum(&STFT)) != NULL) {
+		//Do something with 512 bins
+		
+		TM_STFT_ReleaseSpectrum(&STFT);
+	}
+}
+@endcode
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - TM FFT
+ - TM DMA (STM32F4xx and STM32F7xx only)
+ - ARM MATH
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+#include "tm_stm32_fft.h"
+#if defined(STM32F4xx) || defined(STM32F7xx)
+#include "tm_stm32_dma.h"
+#endif
+
+/**
+ * @defgroup TM_STFT_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Sample ring length as multiple of FFT size when malloc is used
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef STFT_SAMPLES_MULT
+#define STFT_SAMPLES_MULT       2
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_STFT_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Window types
+ */
+typedef enum {
+	TM_STFT_Window_Rectangular = 0x00, /*!< No window */
+	TM_STFT_Window_Hann,               /*!< Hann window */
+	TM_STFT_Window_Hamming,            /*!< Hamming window */
+	TM_STFT_Window_BlackmanHarris      /*!< 4-term Blackman-Harris window */
+} TM_STFT_Window_t;
+
+/**
+ * @brief  Streaming short-time FFT structure
+ */
+typedef struct {
+	TM_FFT_Real_F32_t FFT;       /*!< Real FFT instance. Meant for private use */
+	float32_t* Window;           /*!< Pointer to window table of FFT_Size length */
+	TM_STFT_Window_t WindowType; /*!< Window type. Meant for private use */
+	float32_t* Samples;          /*!< Pointer to sample ring. Meant for private use */
+	uint32_t SamplesSize;        /*!< Sample ring length, power of 2. Meant for private use */
+	__IO uint32_t Written;       /*!< Number of samples written to ring. Meant for private use */
+	__IO uint32_t WriteEnd;      /*!< Number of samples written including samples being written. Meant for private use */
+	uint32_t FrameStart;         /*!< Position of next frame in samples. Meant for private use */
+	uint16_t Hop;                /*!< Number of samples between frames */
+	uint8_t Power;               /*!< Set to 1 when power spectrum is saved instead of magnitude */
+	uint8_t UseMalloc;           /*!< Set to 1 when malloc is used for memory allocation. Meant for private use */
+	float32_t Offset;            /*!< Offset subtracted from 16-bit samples */
+	float32_t Gain;              /*!< Gain for 16-bit samples after offset */
+	float32_t* Spectra;          /*!< Pointer to ring of spectra, SpectraCount * FFT_Size / 2 long. Meant for private use */
+	uint16_t SpectraCount;       /*!< Number of spectra in ring */
+	uint16_t Head;               /*!< Index of next calculated spectrum in ring. Meant for private use */
+	uint16_t Tail;               /*!< Index of oldest spectrum in ring. Meant for private use */
+	uint16_t Count;              /*!< Number of spectra in ring. Meant for private use */
+	uint32_t Dropped;            /*!< Number of frames dropped because their samples were overwritten before processing */
+	uint32_t Overwritten;        /*!< Number of spectra overwritten because ring of spectra was full */
+} TM_STFT_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_STFT_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes streaming short-time FFT
+ * @param  *STFT: Pointer to empty @ref TM_STFT_t structure
+ * @param  FFT_Size: Frame length in samples. Any size supported by @ref TM_FFT_Init_Real_F32
+ * @param  Hop: Number of new samples between 2 frames, between 1 and FFT_Size. Overlap is (FFT_Size - Hop) / FFT_Size
+ * @param  Window: Window type. This parameter can be a value of @ref TM_STFT_Window_t enumeration
+ * @param  SpectraCount: Number of spectra in output ring
+ * @param  use_malloc: Set to 1 to allocate all buffers with @ref LIB_ALLOC_FUNC.
+ *            If set to 0, buffers must be set with @ref TM_STFT_SetBuffers
+ * @retval Initialization status:
+ *            - 0: Initialized OK, ready to use
+ *            - 1: Input parameters are not valid
+ *            - 2: Malloc failed
+ */
+uint8_t TM_STFT_Init(TM_STFT_t* STFT, uint16_t FFT_Size, uint16_t Hop, TM_STFT_Window_t Window, uint16_t SpectraCount, uint8_t use_malloc);
+
+/**
+ * @brief  Sets buffers for calculations and calculates window table
+ * @note   Use this function only if you set @arg use_malloc parameter to zero in @ref TM_STFT_Init function
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @param  *Input: Pointer to FFT input buffer of FFT_Size length
+ * @param  *Output: Pointer to FFT output buffer of FFT_Size length
+ * @param  *Window: Pointer to window table of FFT_Size length
+ * @param  *Samples: Pointer to sample ring
+ * @param  SamplesSize: Sample ring length. It must be power of 2 and at least FFT_Size + maximal block added at once
+ * @param  *Spectra: Pointer to ring of spectra of SpectraCount * FFT_Size / 2 length
+ * @retval None
+ */
+void TM_STFT_SetBuffers(TM_STFT_t* STFT, float32_t* Input, float32_t* Output, float32_t* Window, float32_t* Samples, uint32_t SamplesSize, float32_t* Spectra);
+
+/**
+ * @brief  Sets conversion for 16-bit samples added with @ref TM_STFT_AddSamples_U16
+ * @note   Sample value is calculated as (raw - Offset) * Gain. Default offset is 0 and gain is 1
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @param  Offset: Offset to subtract, like middle of ADC range
+ * @param  Gain: Gain after offset subtraction
+ * @retval None
+ */
+void TM_STFT_SetScale(TM_STFT_t* STFT, float32_t Offset, float32_t Gain);
+
+/**
+ * @brief  Sets output to power spectrum instead of magnitude
+ * @note   Power spectrum is faster as no square root is used
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @param  Power: Set to 1 for power spectrum or 0 for magnitude
+ * @retval None
+ */
+#define TM_STFT_SetPower(STFT, power)     ((STFT)->Power = (power))
+
+/**
+ * @brief  Adds block of 16-bit samples, like ADC DMA buffer
+ * @note   Function can be called from interrupt
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @param  *Data: Pointer to samples
+ * @param  Count: Number of samples. If more than sample ring length, only last samples are used
+ * @retval None
+ */
+void TM_STFT_AddSamples_U16(TM_STFT_t* STFT, const uint16_t* Data, uint16_t Count);
+
+/**
+ * @brief  Adds block of float samples
+ * @note   Function can be called from interrupt
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @param  *Data: Pointer to samples
+ * @param  Count: Number of samples. If more than sample ring length, only last samples are used
+ * @retval None
+ */
+void TM_STFT_AddSamples_F32(TM_STFT_t* STFT, const float32_t* Data, uint16_t Count);
+
+#if defined(STM32F4xx) || defined(STM32F7xx) || defined(__DOXYGEN__)
+/**
+ * @brief  Double buffer callback which adds completed 16-bit buffer to STFT
+ * @note   Pass this function as callback to @ref TM_ADC_DoubleBufferStart or @ref TM_DMA_DB_Start
+ *         and pointer to @ref TM_STFT_t structure as user parameters
+ * @note   Available on STM32F4xx and STM32F7xx devices only
+ * @param  *DB: Pointer to @ref TM_DMA_DB_t structure
+ * @param  *Buffer: Pointer to completed buffer
+ * @param  *UserParameters: Pointer to @ref TM_STFT_t structure
+ * @retval None
+ */
+void TM_STFT_DMACallback(TM_DMA_DB_t* DB, void* Buffer, void* UserParameters);
+#endif
+
+/**
+ * @brief  Calculates spectra for all available frames
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Number of calculated spectra
+ */
+uint16_t TM_STFT_Process(TM_STFT_t* STFT);
+
+/**
+ * @brief  Gets oldest calculated spectrum from ring
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Pointer to FFT_Size / 2 bins or NULL if ring is empty
+ */
+float32_t* TM_STFT_GetSpectrum(TM_STFT_t* STFT);
+
+/**
+ * @brief  Releases oldest spectrum returned with @ref TM_STFT_GetSpectrum
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @retval None
+ */
+void TM_STFT_ReleaseSpectrum(TM_STFT_t* STFT);
+
+/**
+ * @brief  Calculates window table
+ * @param  *Window: Pointer to table of Size length
+ * @param  Size: Number of coefficients
+ * @param  Type: Window type. This parameter can be a value of @ref TM_STFT_Window_t enumeration
+ * @retval None
+ */
+void TM_STFT_CreateWindow(float32_t* Window, uint16_t Size, TM_STFT_Window_t Type);
+
+/**
+ * @brief  Free buffers allocated with malloc
+ * @param  *STFT: Pointer to @ref TM_STFT_t structure
+ * @retval None
+ */
+void TM_STFT_Free(TM_STFT_t* STFT);
+
+/**
+ * @brief  Gets number of spectra ready in ring
+ * @param  STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Number of spectra
+ * @note   Defined as macro for faster execution
+ */
+#define TM_STFT_GetCount(STFT)         ((STFT)->Count)
+
+/**
+ * @brief  Gets number of frames dropped because samples were overwritten before @ref TM_STFT_Process was called
+ * @param  STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Number of dropped frames
+ * @note   Defined as macro for faster execution
+ */
+#define TM_STFT_GetDropped(STFT)       ((STFT)->Dropped)
+
+/**
+ * @brief  Gets number of spectra overwritten because they were not released in time
+ * @param  STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Number of overwritten spectra
+ * @note   Defined as macro for faster execution
+ */
+#define TM_STFT_GetOverwritten(STFT)   ((STFT)->Overwritten)
+
+/**
+ * @brief  Gets number of all lost frames, dropped and overwritten
+ * @param  STFT: Pointer to @ref TM_STFT_t structure
+ * @retval Number of lost frames
+ * @note   Defined as macro for faster execution
+ */
+#define TM_STFT_GetLost(STFT)          ((STFT)->Dropped + (STFT)->Overwritten)
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_trace.h"
+
+/* Sequence number of record which is being written */
+#define TRACE_SEQ_WRITING     0xFFFFFFFF
+
+/* Frame header size */
+#define TRACE_HEADER_SIZE     12
+
+/* Trace buffer */
+static TM_TRACE_Record_t* TRACE_Buffer = NULL;
+static uint32_t TRACE_Mask = 0;
+static __IO uint32_t TRACE_Head = 0;
+static __IO uint8_t TRACE_Enabled = 0;
+
+/* Exporter state */
+static uint32_t TRACE_Tail = 0;
+static uint32_t TRACE_Lost = 0;
+
+#if TRACE_EXPORT_USART_DMA || TRACE_EXPORT_USBD_CDC
+/* Buffer for export helpers */
+static uint8_t TRACE_ExportBuffer[TRACE_EXPORT_SIZE];
+#endif
+#if TRACE_EXPORT_USBD_CDC
+static uint32_t TRACE_ExportLength = 0;
+static uint32_t TRACE_ExportPos = 0;
+#endif
+
+uint8_t TM_TRACE_Init(TM_TRACE_Record_t* Buffer, uint32_t Count) {
+	uint32_t i;
+	
+	/* Check for power of 2 */
+	if (Count == 0 || (Count & (Count - 1))) {
+		return 0;
+	}
+	
+	/* Stop recording */
+	TRACE_Enabled = 0;
+	
+	/* Mark all records as invalid */
+	for (i = 0; i < Count; i++) {
+		Buffer[i].Seq = TRACE_SEQ_WRITING;
+	}
+	
+	/* Save settings */
+	TRACE_Buffer = Buffer;
+	TRACE_Mask = Count - 1;
+	TRACE_Head = 0;
+	TRACE_Tail = 0;
+	TRACE_Lost = 0;
+	
+	/* Start recording */
+	TRACE_Enabled = 1;
+	
+	/* Return OK */
+	return 1;
+}
+
+void TM_TRACE_Record(uint8_t Type, uint8_t Id, uint32_t Arg) {
+	TM_TRACE_Record_t* rec;
+	uint32_t index;
+	uint64_t time;
+	
+	/* Check if recording */
+	if (!TRACE_Enabled) {
+		return;
+	}
+	
+	/* Reserve record, lock-free between interrupts */
+	do {
+		index = __LDREXW((uint32_t *)&TRACE_Head);
+	} while (__STREXW(index + 1, (uint32_t *)&TRACE_Head));
+	
+	/* Invalidate record before it is changed */
+	rec = &TRACE_Buffer[index & TRACE_Mask];
+	rec->Seq = TRACE_SEQ_WRITING;
+	__DMB();
+	
+	/* Get time */
+	time = TM_CLOCK_GetCycles();
+	
+	/* Fill record */
+	rec->TimeLow = (uint32_t)time;
+	rec->TimeHigh = (uint16_t)(time >> 32);
+	rec->Type = Type;
+	rec->Id = Id;
+	rec->Arg = Arg;
+	
+	/* Record is valid now */
+	__DMB();
+	rec->Seq = index;
+}
+
+void TM_TRACE_Start(void) {
+	/* Start recording, buffer must be set first */
+	if (TRACE_Buffer != NULL) {
+		TRACE_Enabled = 1;
+	}
+}
+
+void TM_TRACE_Stop(void) {
+	/* Stop recording */
+	TRACE_Enabled = 0;
+}
+
+uint32_t TM_TRACE_Export(uint8_t* Buffer, uint32_t Size) {
+	TM_TRACE_Record_t* rec;
+	uint32_t head, max, count = 0;
+	uint8_t* ptr;
+	
+	/* Check buffer */
+	if (TRACE_Buffer == NULL || Size < (TRACE_HEADER_SIZE + sizeof(TM_TRACE_Record_t))) {
+		return 0;
+	}
+	max = (Size - TRACE_HEADER_SIZE) / sizeof(TM_TRACE_Record_t);
+	if (max > 0xFFFF) {
+		max = 0xFFFF;
+	}
+	
+	/* Skip overwritten records */
+	head = TRACE_Head;
+	if ((head - TRACE_Tail) > (TRACE_Mask + 1)) {
+		TRACE_Lost += head - TRACE_Tail - (TRACE_Mask + 1);
+		TRACE_Tail = head - (TRACE_Mask + 1);
+	}
+	
+	/* Copy records */
+	ptr = &Buffer[TRACE_HEADER_SIZE];
+	while (count < max && TRACE_Tail != head) {
+		rec = &TRACE_Buffer[TRACE_Tail & TRACE_Mask];
+		
+		/* Record is still being written or is reserved but still has sequence from previous lap */
+		if (rec->Seq == TRACE_SEQ_WRITING || (int32_t)(rec->Seq - TRACE_Tail) < 0) {
+			/* Continue in next call while recording, writer will finish it */
+			if (TRACE_Enabled) {
+				break;
+			}
+			
+			/* Recording is stopped, writer was interrupted by fault and record is never finished */
+			TRACE_Lost++;
+			TRACE_Tail++;
+			continue;
+		}
+		
+		/* Copy record and check if it was not overwritten meanwhile */
+		if (rec->Seq == TRACE_Tail) {
+			memcpy(ptr, rec, sizeof(TM_TRACE_Record_t));
+			__DMB();
+			if (rec->Seq == TRACE_Tail) {
+				ptr += sizeof(TM_TRACE_Record_t);
+				count++;
+				TRACE_Tail++;
+				continue;
+			}
+		}
+		
+		/* Record was overwritten */
+		TRACE_Lost++;
+		TRACE_Tail++;
+	}
+	
+	/* Nothing to send */
+	if (count == 0 && TRACE_Lost == 0) {
+		return 0;
+	}
+	
+	/* Fill header */
+	Buffer[0] = 'T';
+	Buffer[1] = 'M';
+	Buffer[2] = 'T';
+	Buffer[3] = 'R';
+	Buffer[4] = (uint8_t)count;
+	Buffer[5] = (uint8_t)(count >> 8);
+	if (TRACE_Lost > 0xFFFF) {
+		TRACE_Lost = 0xFFFF;
+	}
+	Buffer[6] = (uint8_t)TRACE_Lost;
+	Buffer[7] = (uint8_t)(TRACE_Lost >> 8);
+	TRACE_Lost = 0;
+	head = TM_CLOCK_GetFrequency();
+	memcpy(&Buffer[8], &head, 4);
+	
+	/* Return number of bytes */
+	return TRACE_HEADER_SIZE + count * sizeof(TM_TRACE_Record_t);
+}
+
+#if TRACE_EXPORT_USART_DMA
+uint32_t TM_TRACE_ExportUSART(USART_TypeDef* USARTx) {
+	uint32_t len;
+	
+	/* Export buffer is in use by DMA */
+	if (TM_USART_DMA_Transmitting(USARTx)) {
+		return 0;
+	}
+	
+	/* Get new records and start DMA */
+	len = TM_TRACE_Export(TRACE_ExportBuffer, sizeof(TRACE_ExportBuffer));
+	if (len && !TM_USART_DMA_Send(USARTx, TRACE_ExportBuffer, (uint16_t)len)) {
+		return 0;
+	}
+	
+	/* Return number of bytes */
+	return len;
+}
+#endif
+
+#if TRACE_EXPORT_USBD_CDC
+uint32_t TM_TRACE_ExportUSBD_CDC(TM_USB_t USB_Mode) {
+	uint32_t len;
+	
+	/* Get new records when previous frame is sent */
+	if (TRACE_ExportPos == TRACE_ExportLength) {
+		TRACE_ExportLength = TM_TRACE_Export(TRACE_ExportBuffer, sizeof(TRACE_ExportBuffer));
+		TRACE_ExportPos = 0;
+		if (TRACE_ExportLength == 0) {
+			return 0;
+		}
+	}
+	
+	/* Add as much as possible to CDC buffer, rest is sent in next call */
+	len = TM_USBD_CDC_PutArray(USB_Mode, &TRACE_ExportBuffer[TRACE_ExportPos], (uint16_t)(TRACE_ExportLength - TRACE_ExportPos));
+	TRACE_ExportPos += len;
+	
+	/* Return number of bytes */
+	return len;
+}
+#endif
@@ -0,0 +1,374 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   Binary event trace recorder for STM32F4xx and STM32F7xx devices
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_TRACE_H
+#define TM_TRACE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_TRACE
+ * @brief    Binary event trace recorder for STM32F4xx and STM32F7xx devices
+ * @{
+ *
+ * Library records timestamped events (interrupt entry and exit, DMA completion, task switches, user markers)
+ * to RAM ring buffer. When buffer is full, oldest records are overwritten, so last events before fault are always available.
+ *
+ * \par Records
+ *
+ * Each record has 16 bytes: 48-bit timestamp in CPU cycles from @ref TM_CLOCK library,
+ * event type, event ID, 32-bit argument and sequence number.
+ *
+ * Records can be written from main loop and from any interrupt without disabling interrupts.
+ * Record slot is reserved with exclusive access instructions and sequence number is written last,
+ * so exporter never sends record which is not complete.
+ *
+ * \par Buffer
+ *
+ * Buffer is provided by user and number of records must be power of 2.
+ * For long traces, buffer can be placed to external SDRAM:
+ *
+@code
+//Init SDRAM and use first 1MB for trace, 65536 records
+TM_SDRAM_Init();
+TM_TRACE_Init((TM_TRACE_Record_t *)SDRAM_START_ADR, 65536);
+@endcode
+ *
+ * \par Export
+ *
+ * @ref TM_TRACE_Export copies new records to linear buffer with 12-bytes frame header:
+ *
+\verbatim
+ - "TMTR" magic
+ - uint16_t: number of records in frame
+ - uint16_t: number of lost records since previous frame
+ - uint32_t: clock frequency in Hz
+\endverbatim
+ *
+ * All values are little endian. Frames can be sent over any interface.
+ * Helper functions for @ref TM_USART_DMA and @ref TM_USBD_CDC are available when enabled in defines.h file:
+ *
+@code
+//Enable export over USART with DMA
+#define TRACE_EXPORT_USART_DMA    1
+
+//Enable export over USB CDC
+#define TRACE_EXPORT_USBD_CDC     1
+@endcode
+ *
+ * \par Host decoder
+ *
+ * Python script <code>tools/tm_trace_decode.py</code> reads captured stream and creates
+ * Chrome trace JSON file, which can be opened in <code>chrome://tracing</code> or Perfetto.
+ *
+\verbatim
+python tm_trace_decode.py capture.bin -o trace.json --names names.txt
+\endverbatim
+ *
+ * \par Example
+ *
+@code
+//Init clock and trace
+TM_CLOCK_Init();
+TM_TRACE_Init(TraceBuffer, 1024);
+
+//Interrupt entry and exit
+void USART1_IRQHandler(void) {
+	TM_TRACE_Enter(EVENT_USART1);
+	//Process
+	TM_TRACE_Exit(EVENT_USART1);
+}
+
+//DMA transfer complete
+void TM_DMA_TransferCompleteHandler(DMA_Stream_TypeDef* DMA_Stream) {
+	TM_TRACE_Mark(EVENT_DMA_TC, (uint32_t)DMA_Stream);
+}
+
+//FreeRTOS task switches, in FreeRTOSConfig.h
+#define traceTASK_SWITCHED_IN()   TM_TRACE_TaskSwitch(uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle()))
+
+//Stop recording in fault handler to keep events before fault
+void HardFault_Handler(void) {
+	TM_TRACE_Stop();
+	while (1) {
+		TM_TRACE_ExportUSART(USART1);
+	}
+}
+@endcode
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+
+ Version 1.1
+  - October 19, 2026
+  - After TM_TRACE_Stop, records left unfinished by interrupted writer are counted as lost and skipped on export
+  - TM_TRACE_Start does not start recording before TM_TRACE_Init
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+ - TM CLOCK
+ - TM USART DMA, when TRACE_EXPORT_USART_DMA is used
+ - TM USB DEVICE CDC, when TRACE_EXPORT_USBD_CDC is used
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+#include "tm_stm32_clock.h"
+#include "string.h"
+
+/**
+ * @defgroup TM_TRACE_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  Set to 1 to enable export over USART with DMA
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef TRACE_EXPORT_USART_DMA
+#define TRACE_EXPORT_USART_DMA    0
+#endif
+
+/**
+ * @brief  Set to 1 to enable export over USB CDC
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef TRACE_EXPORT_USBD_CDC
+#define TRACE_EXPORT_USBD_CDC     0
+#endif
+
+/**
+ * @brief  Size of buffer in units of bytes used by export helper functions
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef TRACE_EXPORT_SIZE
+#define TRACE_EXPORT_SIZE         524
+#endif
+
+#if TRACE_EXPORT_USART_DMA
+#include "tm_stm32_usart_dma.h"
+#endif
+#if TRACE_EXPORT_USBD_CDC
+#include "tm_stm32_usb_device_cdc.h"
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_TRACE_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Event types
+ */
+typedef enum {
+	TM_TRACE_Type_Enter = 0x00,   /*!< Interrupt or function entry */
+	TM_TRACE_Type_Exit,           /*!< Interrupt or function exit */
+	TM_TRACE_Type_Mark,           /*!< Single event with argument */
+	TM_TRACE_Type_Counter,        /*!< Value of counter */
+	TM_TRACE_Type_TaskSwitch      /*!< Task with ID is switched in */
+} TM_TRACE_Type_t;
+
+/**
+ * @brief  Trace record, 16 bytes
+ */
+typedef struct {
+	uint32_t TimeLow;   /*!< Bits 0 to 31 of timestamp in CPU cycles */
+	uint16_t TimeHigh;  /*!< Bits 32 to 47 of timestamp in CPU cycles */
+	uint8_t Type;       /*!< Event type, member of @ref TM_TRACE_Type_t enumeration */
+	uint8_t Id;         /*!< Event ID */
+	uint32_t Arg;       /*!< Event argument */
+	__IO uint32_t Seq;  /*!< Record sequence number */
+} TM_TRACE_Record_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_TRACE_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes trace buffer and starts recording
+ * @note   @ref TM_CLOCK_Init must be called first
+ * @param  *Buffer: Pointer to buffer for records
+ * @param  Count: Number of records in buffer, must be power of 2
+ * @retval Initialization status:
+ *           - 0: Count is not power of 2
+ *           - > 0: Trace is ready
+ */
+uint8_t TM_TRACE_Init(TM_TRACE_Record_t* Buffer, uint32_t Count);
+
+/**
+ * @brief  Writes new record to trace buffer
+ * @note   Can be called from any context
+ * @param  Type: Event type, member of @ref TM_TRACE_Type_t enumeration
+ * @param  Id: Event ID
+ * @param  Arg: Event argument
+ * @retval None
+ */
+void TM_TRACE_Record(uint8_t Type, uint8_t Id, uint32_t Arg);
+
+/**
+ * @brief  Records interrupt or function entry
+ * @param  id: Event ID
+ * @retval None
+ * @note   Defined as macro for faster execution
+ */
+#define TM_TRACE_Enter(id)             TM_TRACE_Record(TM_TRACE_Type_Enter, (id), 0)
+
+/**
+ * @brief  Records interrupt or function exit
+ * @param  id: Event ID
+ * @retval None
+ * @note   Defined as macro for faster execution
+ */
+#define TM_TRACE_Exit(id)              TM_TRACE_Record(TM_TRACE_Type_Exit, (id), 0)
+
+/**
+ * @brief  Records single event
+ * @param  id: Event ID
+ * @param  arg: Event argument
+ * @retval None
+ * @note   Defined as macro for faster execution
+ */
+#define TM_TRACE_Mark(id, arg)         TM_TRACE_Record(TM_TRACE_Type_Mark, (id), (uint32_t)(arg))
+
+/**
+ * @brief  Records counter value
+ * @param  id: Counter ID
+ * @param  value: Counter value
+ * @retval None
+ * @note   Defined as macro for faster execution
+ */
+#define TM_TRACE_Counter(id, value)    TM_TRACE_Record(TM_TRACE_Type_Counter, (id), (uint32_t)(value))
+
+/**
+ * @brief  Records task switch
+ * @param  task: ID of task which is switched in
+ * @retval None
+ * @note   Defined as macro for faster execution
+ */
+#define TM_TRACE_TaskSwitch(task)      TM_TRACE_Record(TM_TRACE_Type_TaskSwitch, (uint8_t)(task), 0)
+
+/**
+ * @brief  Starts recording
+ * @note   Nothing is done if buffer was not set with @ref TM_TRACE_Init
+ * @param  None
+ * @retval None
+ */
+void TM_TRACE_Start(void);
+
+/**
+ * @brief  Stops recording, records already in buffer can be still exported
+ * @note   Use it in fault handler to keep events before fault.
+ *         Records which were not finished because writer was interrupted are counted as lost on export
+ * @param  None
+ * @retval None
+ */
+void TM_TRACE_Stop(void);
+
+/**
+ * @brief  Copies new records to buffer in export format
+ * @note   It must not be called from more than one place
+ * @param  *Buffer: Pointer to buffer to copy frame to
+ * @param  Size: Size of buffer in units of bytes, at least 28 bytes for one record
+ * @retval Number of bytes written to buffer, 0 if there are no new records
+ */
+uint32_t TM_TRACE_Export(uint8_t* Buffer, uint32_t Size);
+
+#if TRACE_EXPORT_USART_DMA || defined(__DOXYGEN__)
+/**
+ * @brief  Sends new records over USART with DMA
+ * @note   @ref TM_USART_DMA_Init must be called first. Call function periodically
+ * @param  *USARTx: Pointer to USARTx peripheral
+ * @retval Number of bytes started to send, 0 if DMA is busy or there are no new records
+ */
+uint32_t TM_TRACE_ExportUSART(USART_TypeDef* USARTx);
+#endif
+
+#if TRACE_EXPORT_USBD_CDC || defined(__DOXYGEN__)
+/**
+ * @brief  Sends new records over USB CDC
+ * @note   Call function periodically
+ * @param  USB_Mode: USB mode used for CDC
+ * @retval Number of bytes added to USB CDC buffer
+ */
+uint32_t TM_TRACE_ExportUSBD_CDC(TM_USB_t USB_Mode);
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -140,6 +140,9 @@ uint8_t TM_USART_DMA_Send(USART_TypeDef* USARTx, uint8_t* DataArray, uint16_t co
 	/* Init HAL */
 	TM_DMA_Init(Settings->DMA_Stream, &DMA_InitStruct);
 	
+	/* Write cached data to memory for DMA */
+	TM_DMA_CleanDCache(DataArray, count);
+	
 	/* Start transfer */
 	TM_DMA_Start(&DMA_InitStruct, (uint32_t) &DataArray[0], (uint32_t) &USART_TX_REG(USARTx), count);
 	
@@ -150,6 +153,26 @@ uint8_t TM_USART_DMA_Send(USART_TypeDef* USARTx, uint8_t* DataArray, uint16_t co
 	return 1;
 }
 
+uint8_t TM_USART_DMA_SendChain(USART_TypeDef* USARTx, TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters) {
+	/* Get USART settings */
+	TM_USART_DMA_INT_t* Settings = TM_USART_DMA_INT_GetSettings(USARTx);
+	
+	/* Check if DMA is working now */
+	if (Settings->DMA_Stream->NDTR || (Settings->DMA_Stream->CR & DMA_SxCR_EN)) {
+		/* DMA works right now */
+		return 0;
+	}
+	
+	/* Init chain on USART stream */
+	TM_DMA_SG_Init(SG, Settings->DMA_Stream, Settings->DMA_Channel, DMA_MEMORY_TO_PERIPH, (uint32_t) &USART_TX_REG(USARTx), 1);
+	
+	/* Enable USART TX DMA */
+	USARTx->CR3 |= USART_CR3_DMAT;
+	
+	/* Start chain */
+	return TM_DMA_SG_Start(SG, First, Callback, UserParameters);
+}
+
 uint8_t TM_USART_DMA_Puts(USART_TypeDef* USARTx, char* DataArray) {
 	/* Call DMA Send function */
 	return TM_USART_DMA_Send(USARTx, (uint8_t *)DataArray, strlen(DataArray));
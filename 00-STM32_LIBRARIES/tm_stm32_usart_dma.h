@@ -35,7 +35,7 @@
 @endverbatim
  */
 #ifndef TM_USART_DMA_H
-#define TM_USART_DMA_H 100
+#define TM_USART_DMA_H 110
 
 /* C++ detection */
 #ifdef __cplusplus
@@ -89,6 +89,10 @@ UART8      | DMA1 | DMA Stream 0 | DMA Channel 5
 @verbatim
  Version 1.0
   - First release
+
+ Version 1.1
+  - October 19, 2026
+  - Added support for sending scatter-gather descriptor chains
 @endverbatim
  *
  * \par Dependencies
@@ -268,6 +272,21 @@ uint8_t TM_USART_DMA_Send(USART_TypeDef* USARTx, uint8_t* DataArray, uint16_t co
  */
 uint16_t TM_USART_DMA_Transmitting(USART_TypeDef* USARTx);
 
+/**
+ * @brief  Sends chain of descriptors over USART with DMA TX functionality
+ * @note   Fragments are sent one after another without copying them to one buffer first. Check @ref TM_DMA for more info
+ * @note   Use @ref TM_DMA_SG_IsBusy to check if chain is still in transfer
+ * @param  *USARTx: Pointer to USARTx to use for send
+ * @param  *SG: Pointer to @ref TM_DMA_SG_t structure for chain. It is initialized by this function
+ * @param  *First: Pointer to first descriptor in chain
+ * @param  Callback: Callback called when last descriptor is transferred to USART. Set to NULL if not used
+ * @param  *UserParameters: Pointer to user parameters for callback
+ * @retval Sending started status:
+ *            - 0: DMA has not started with sending data
+ *            - > 0: DMA has started with sending data
+ */
+uint8_t TM_USART_DMA_SendChain(USART_TypeDef* USARTx, TM_DMA_SG_t* SG, const TM_DMA_SG_Desc_t* First, TM_DMA_SG_Callback_t Callback, void* UserParameters);
+
 /**
  * @}
  */
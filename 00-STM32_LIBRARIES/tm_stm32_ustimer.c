@@ -0,0 +1,263 @@
+/**	
+ * |----------------------------------------------------------------------
+ * | Copyright (c) 2016 Tilen MAJERLE
+ * |  
+ * | Permission is hereby granted, free of charge, to any person
+ * | obtaining a copy of this software and associated documentation
+ * | files (the "Software"), to deal in the Software without restriction,
+ * | including without limitation the rights to use, copy, modify, merge,
+ * | publish, distribute, sublicense, and/or sell copies of the Software, 
+ * | and to permit persons to whom the Software is furnished to do so, 
+ * | subject to the following conditions:
+ * | 
+ * | The above copyright notice and this permission notice shall be
+ * | included in all copies or substantial portions of the Software.
+ * | 
+ * | THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * | EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * | OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * | AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * | HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * | WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * | FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * | OTHER DEALINGS IN THE SOFTWARE.
+ * |----------------------------------------------------------------------
+ */
+#include "tm_stm32_ustimer.h"
+
+/* Running timers sorted by deadline */
+static TM_USTIMER_t* USTIMER_Active = NULL;
+
+/* Latency statistics */
+static TM_USTIMER_Stats_t USTIMER_Stats = {0, 0xFFFFFFFF, 0, 0, 0};
+
+/* Private functions */
+static void TM_USTIMER_INT_Insert(TM_USTIMER_t* Timer);
+static void TM_USTIMER_INT_Remove(TM_USTIMER_t* Timer);
+static void TM_USTIMER_INT_Program(void);
+
+void TM_USTIMER_Init(void) {
+	uint32_t clk;
+	
+	/* Get timer clock */
+#if defined(RCC_CFGR_PPRE2)
+	if ((uint32_t)USTIMER_TIM >= APB2PERIPH_BASE) {
+		clk = HAL_RCC_GetPCLK2Freq();
+		if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1) {
+			clk *= 2;
+		}
+	} else {
+		clk = HAL_RCC_GetPCLK1Freq();
+		if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+			clk *= 2;
+		}
+	}
+#else
+	clk = HAL_RCC_GetPCLK1Freq();
+	if ((RCC->CFGR & RCC_CFGR_PPRE) != RCC_CFGR_PPRE_DIV1) {
+		clk *= 2;
+	}
+#endif
+	
+	/* Free running counter with 1MHz clock */
+	USTIMER_TIM_CLK_ENABLE();
+	USTIMER_TIM->CR1 = 0;
+	USTIMER_TIM->PSC = clk / 1000000 - 1;
+	USTIMER_TIM->ARR = 0xFFFFFFFF;
+	USTIMER_TIM->CCMR1 = 0;
+	USTIMER_TIM->EGR = TIM_EGR_UG;
+	USTIMER_TIM->SR = 0;
+	USTIMER_TIM->DIER = 0;
+	
+	/* Enable interrupt */
+	HAL_NVIC_SetPriority(USTIMER_TIM_IRQ, USTIMER_NVIC_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(USTIMER_TIM_IRQ);
+	
+	/* Start timer */
+	USTIMER_TIM->CR1 = TIM_CR1_CEN;
+}
+
+void TM_USTIMER_Start(TM_USTIMER_t* Timer, uint32_t Delay, uint32_t Period, void (*Callback)(TM_USTIMER_t*, void*), void* UserParameters) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Remove if already running */
+	TM_USTIMER_INT_Remove(Timer);
+	
+	/* Fill settings */
+	Timer->Deadline = USTIMER_TIM->CNT + Delay;
+	Timer->Period = Period;
+	Timer->Callback = Callback;
+	Timer->UserParameters = UserParameters;
+	
+	/* Add to list and program first deadline */
+	TM_USTIMER_INT_Insert(Timer);
+	TM_USTIMER_INT_Program();
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+}
+
+void TM_USTIMER_Stop(TM_USTIMER_t* Timer) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Remove from list and program first deadline */
+	TM_USTIMER_INT_Remove(Timer);
+	TM_USTIMER_INT_Program();
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+}
+
+void TM_USTIMER_GetStats(TM_USTIMER_Stats_t* Stats) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Copy statistics */
+	*Stats = USTIMER_Stats;
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+	
+	/* Calculate average */
+	Stats->Avg = Stats->Count ? (uint32_t)(Stats->Total / Stats->Count) : 0;
+	if (!Stats->Count) {
+		Stats->Min = 0;
+	}
+}
+
+void TM_USTIMER_ResetStats(void) {
+	uint32_t irq;
+	
+	/* Get interrupt status and disable interrupts */
+	irq = __get_PRIMASK();
+	__disable_irq();
+	
+	/* Reset statistics */
+	USTIMER_Stats.Count = 0;
+	USTIMER_Stats.Min = 0xFFFFFFFF;
+	USTIMER_Stats.Max = 0;
+	USTIMER_Stats.Total = 0;
+	
+	/* Enable IRQ if necessary */
+	if (!irq) {
+		__enable_irq();
+	}
+}
+
+/***************************************************/
+/*                Interrupt handler                */
+/***************************************************/
+void USTIMER_TIM_IRQ_HANDLER(void) {
+	TM_USTIMER_t* tmp;
+	uint32_t latency;
+	
+	/* Clear compare flag */
+	USTIMER_TIM->SR = ~TIM_SR_CC1IF;
+	
+	/* Process all expired timers */
+	while ((tmp = USTIMER_Active) != NULL && (int32_t)(USTIMER_TIM->CNT - tmp->Deadline) >= 0) {
+		/* Measure latency */
+		latency = USTIMER_TIM->CNT - tmp->Deadline;
+		USTIMER_Stats.Count++;
+		USTIMER_Stats.Total += latency;
+		if (latency < USTIMER_Stats.Min) {
+			USTIMER_Stats.Min = latency;
+		}
+		if (latency > USTIMER_Stats.Max) {
+			USTIMER_Stats.Max = latency;
+		}
+		
+		/* Remove from list */
+		USTIMER_Active = tmp->Next;
+		tmp->Next = NULL;
+		tmp->Active = 0;
+		
+		/* Put periodic timer back with next deadline */
+		if (tmp->Period) {
+			tmp->Deadline += tmp->Period;
+			TM_USTIMER_INT_Insert(tmp);
+		}
+		
+		/* Call user callback function */
+		tmp->Callback(tmp, tmp->UserParameters);
+	}
+	
+	/* Program next deadline */
+	TM_USTIMER_INT_Program();
+}
+
+/***************************************************/
+/*                Private functions                */
+/***************************************************/
+
+/* Must be called with interrupts disabled or from timer interrupt */
+static void TM_USTIMER_INT_Insert(TM_USTIMER_t* Timer) {
+	TM_USTIMER_t** pos = &USTIMER_Active;
+	
+	/* Find first timer which expires later */
+	while (*pos && (int32_t)((*pos)->Deadline - Timer->Deadline) <= 0) {
+		pos = &(*pos)->Next;
+	}
+	
+	/* Link timer */
+	Timer->Next = *pos;
+	*pos = Timer;
+	Timer->Active = 1;
+}
+
+/* Must be called with interrupts disabled or from timer interrupt */
+static void TM_USTIMER_INT_Remove(TM_USTIMER_t* Timer) {
+	TM_USTIMER_t** pos = &USTIMER_Active;
+	
+	/* Check if timer is in list */
+	if (!Timer->Active) {
+		return;
+	}
+	
+	/* Find and unlink timer */
+	while (*pos) {
+		if (*pos == Timer) {
+			*pos = Timer->Next;
+			break;
+		}
+		pos = &(*pos)->Next;
+	}
+	Timer->Next = NULL;
+	Timer->Active = 0;
+}
+
+/* Must be called with interrupts disabled or from timer interrupt */
+static void TM_USTIMER_INT_Program(void) {
+	/* Disable interrupt if there is no timer */
+	if (USTIMER_Active == NULL) {
+		USTIMER_TIM->DIER &= ~TIM_DIER_CC1IE;
+		return;
+	}
+	
+	/* Set first deadline */
+	USTIMER_TIM->CCR1 = USTIMER_Active->Deadline;
+	USTIMER_TIM->SR = ~TIM_SR_CC1IF;
+	USTIMER_TIM->DIER |= TIM_DIER_CC1IE;
+	
+	/* Deadline might already passed, generate interrupt by software */
+	if ((int32_t)(USTIMER_TIM->CNT - USTIMER_Active->Deadline) >= 0) {
+		USTIMER_TIM->EGR = TIM_EGR_CC1G;
+	}
+}
@@ -0,0 +1,263 @@
+/**
+ * @author  Tilen MAJERLE
+ * @email   tilen@majerle.eu
+ * @website http://stm32f4-discovery.net
+ * @link    
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license MIT
+ * @brief   Microsecond software timers multiplexed on one 32-bit hardware timer for STM32Fxxx devices
+ *	
+\verbatim
+   ----------------------------------------------------------------------
+    Copyright (c) 2016 Tilen MAJERLE
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software, 
+    and to permit persons to whom the Software is furnished to do so, 
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+    AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+   ----------------------------------------------------------------------
+\endverbatim
+ */
+#ifndef TM_USTIMER_H
+#define TM_USTIMER_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup TM_STM32Fxxx_HAL_Libraries
+ * @{
+ */
+
+/**
+ * @defgroup TM_USTIMER
+ * @brief    Microsecond software timers multiplexed on one 32-bit hardware timer for STM32Fxxx devices
+ * @{
+ *
+ * Software timers in @ref TM_DELAY library have 1ms resolution. This library allows many one-shot or periodic timers
+ * with 1us resolution without busy waiting.
+ *
+ * \par How it works
+ *
+ * 32-bit timer runs freely with 1MHz clock. Running timers are kept in list sorted by deadline
+ * and only first deadline is programmed to output compare register of channel 1.
+ * When compare interrupt happens, all expired timers are removed from list, periodic timers are put back with new deadline,
+ * callbacks are called and next deadline is programmed.
+ *
+ * Periodic timers do not drift, because new deadline is calculated from previous deadline and not from interrupt time.
+ *
+ * Maximal delay and period is 2^31 - 1 microseconds, about 35 minutes.
+ *
+ * \par Latency statistics
+ *
+ * Each time callback is called, difference between timer counter and deadline is measured.
+ * Minimal, maximal and average latency can be read with @ref TM_USTIMER_GetStats function.
+ *
+ * \par Default timer
+ *
+ * By default, TIM5 is used on STM32F4xx and STM32F7xx and TIM2 on STM32F0xx. Both are 32-bit timers.
+ * To use other 32-bit timer, set macros in defines.h file:
+ *
+@code
+//Use TIM2 for microsecond timers
+#define USTIMER_TIM               TIM2
+#define USTIMER_TIM_CLK_ENABLE()  __HAL_RCC_TIM2_CLK_ENABLE()
+#define USTIMER_TIM_IRQ           TIM2_IRQn
+#define USTIMER_TIM_IRQ_HANDLER   TIM2_IRQHandler
+@endcode
+ *
+ * \par Example
+ *
+@code
+TM_USTIMER_t Trigger;
+
+//Called from timer interrupt
+void Trigger_Callback(TM_USTIMER_t* Timer, void* UserParameters) {
+	//Toggle pin every 250us
+	TM_GPIO_TogglePinValue(GPIOD, GPIO_PIN_12);
+}
+
+//Init library and start periodic timer
+TM_USTIMER_Init();
+TM_USTIMER_Start(&Trigger, 250, 250, Trigger_Callback, NULL);
+@endcode
+ *
+ * \par Changelog
+ *
+\verbatim
+ Version 1.0
+  - First release
+\endverbatim
+ *
+ * \par Dependencies
+ *
+\verbatim
+ - STM32Fxxx HAL
+ - defines.h
+\endverbatim
+ */
+
+#include "stm32fxxx_hal.h"
+#include "defines.h"
+
+/**
+ * @defgroup TM_USTIMER_Macros
+ * @brief    Library defines
+ * @{
+ */
+
+/**
+ * @brief  32-bit timer used for microsecond timers
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef USTIMER_TIM
+#if defined(STM32F0xx)
+#define USTIMER_TIM               TIM2
+#define USTIMER_TIM_CLK_ENABLE()  __HAL_RCC_TIM2_CLK_ENABLE()
+#define USTIMER_TIM_IRQ           TIM2_IRQn
+#define USTIMER_TIM_IRQ_HANDLER   TIM2_IRQHandler
+#else
+#define USTIMER_TIM               TIM5
+#define USTIMER_TIM_CLK_ENABLE()  __HAL_RCC_TIM5_CLK_ENABLE()
+#define USTIMER_TIM_IRQ           TIM5_IRQn
+#define USTIMER_TIM_IRQ_HANDLER   TIM5_IRQHandler
+#endif
+#endif
+
+/**
+ * @brief  NVIC preemption priority for timer interrupt
+ * @note   Should be changes in defines.h file if necessary
+ */
+#ifndef USTIMER_NVIC_PRIORITY
+#define USTIMER_NVIC_PRIORITY     0x00
+#endif
+
+/**
+ * @}
+ */
+ 
+/**
+ * @defgroup TM_USTIMER_Typedefs
+ * @brief    Library Typedefs
+ * @{
+ */
+
+/**
+ * @brief  Microsecond timer structure
+ * @note   Structure must stay valid while timer is running
+ */
+typedef struct _TM_USTIMER_t {
+	uint32_t Deadline;                               /*!< Timer counter value when timer expires. Meant for private use */
+	uint32_t Period;                                 /*!< Period in units of microseconds, 0 for one-shot timer */
+	__IO uint8_t Active;                             /*!< Set to 1 when timer is running */
+	struct _TM_USTIMER_t* Next;                      /*!< Next timer in list of running timers. Meant for private use */
+	void (*Callback)(struct _TM_USTIMER_t*, void*);  /*!< Callback function, called from timer interrupt */
+	void* UserParameters;                            /*!< Pointer to user parameters used for callback function */
+} TM_USTIMER_t;
+
+/**
+ * @brief  Callback latency statistics
+ */
+typedef struct {
+	uint32_t Count;   /*!< Number of called callbacks */
+	uint32_t Min;     /*!< Minimal latency in units of microseconds */
+	uint32_t Max;     /*!< Maximal latency in units of microseconds */
+	uint32_t Avg;     /*!< Average latency in units of microseconds */
+	uint64_t Total;   /*!< Sum of all latencies in units of microseconds */
+} TM_USTIMER_Stats_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup TM_USTIMER_Functions
+ * @brief    Library Functions
+ * @{
+ */
+
+/**
+ * @brief  Initializes timer with 1MHz clock and enables interrupt
+ * @param  None
+ * @retval None
+ */
+void TM_USTIMER_Init(void);
+
+/**
+ * @brief  Starts one-shot or periodic timer
+ * @note   If timer is already running, it is restarted with new settings
+ * @param  *Timer: Pointer to @ref TM_USTIMER_t structure
+ * @param  Delay: Number of microseconds to first callback
+ * @param  Period: Number of microseconds between next callbacks or 0 for one-shot timer
+ * @param  *Callback: Pointer to callback function called from timer interrupt
+ * @param  *UserParameters: Pointer to user parameters used for callback function
+ * @retval None
+ */
+void TM_USTIMER_Start(TM_USTIMER_t* Timer, uint32_t Delay, uint32_t Period, void (*Callback)(TM_USTIMER_t*, void*), void* UserParameters);
+
+/**
+ * @brief  Stops running timer
+ * @note   Can be called from callback function too
+ * @param  *Timer: Pointer to @ref TM_USTIMER_t structure
+ * @retval None
+ */
+void TM_USTIMER_Stop(TM_USTIMER_t* Timer);
+
+/**
+ * @brief  Gets current timer counter value
+ * @param  None
+ * @retval Number of microseconds since @ref TM_USTIMER_Init, value overflows after 2^32 microseconds
+ * @note   Defined as macro for faster execution
+ */
+#define TM_USTIMER_GetTime()      (USTIMER_TIM->CNT)
+
+/**
+ * @brief  Gets callback latency statistics
+ * @param  *Stats: Pointer to @ref TM_USTIMER_Stats_t structure to save statistics to
+ * @retval None
+ */
+void TM_USTIMER_GetStats(TM_USTIMER_Stats_t* Stats);
+
+/**
+ * @brief  Resets callback latency statistics
+ * @param  None
+ * @retval None
+ */
+void TM_USTIMER_ResetStats(void);
+
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+ 
+/**
+ * @}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
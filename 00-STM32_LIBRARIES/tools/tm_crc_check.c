@@ -0,0 +1,117 @@
+/*
+ * Host check for CRC calculation with custom parameters in TM CRC library
+ *
+ * Software path of library is compiled for host computer and each specification is checked
+ * against its check value, CRC of ASCII string "123456789", with and without slicing-by-8 tables
+ * and with data split to several updates. Result with tables is also compared to bit by bit result on longer random data.
+ *
+ * Build and run from 00-STM32_LIBRARIES folder, defines.h is taken from CRC example:
+ *
+ *   gcc -Wall -I../10-STM32Fxxx_CRC/User -o tm_crc_check tools/tm_crc_check.c && ./tm_crc_check
+ *
+ * Program returns 0 when all checks pass.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Host replacement for stm32fxxx_hal.h, only CRC registers are used by library */
+#define TM_STM32Fxxx_H
+#define __IO                              volatile
+typedef struct {
+	__IO uint32_t DR;
+	__IO uint32_t IDR;
+	__IO uint32_t CR;
+} CRC_TypeDef;
+static CRC_TypeDef CRC_Host;
+#define CRC                               (&CRC_Host)
+#define CRC_CR_RESET                      0x01
+#define __HAL_RCC_CRC_CLK_ENABLE()        (void)0
+#define __HAL_RCC_CRC_CLK_DISABLE()       (void)0
+
+/* Library source */
+#include "../tm_stm32_crc.c"
+
+/* Additional specifications with width which is not multiple of 8 and with not reflected 32-bit register */
+static const TM_CRC_Spec_t Spec_CRC7_MMC = {7, 0, 0, 0x09, 0x00, 0x00, 0x75};
+static const TM_CRC_Spec_t Spec_CRC12_DECT = {12, 0, 0, 0x80F, 0x000, 0x000, 0xF5B};
+static const TM_CRC_Spec_t Spec_CRC32_MPEG2 = {32, 0, 0, 0x04C11DB7, 0xFFFFFFFF, 0x00000000, 0x0376E6E7};
+static const TM_CRC_Spec_t Spec_CRC5_USB = {5, 1, 1, 0x05, 0x1F, 0x1F, 0x19};
+
+static const struct {
+	const char* Name;
+	const TM_CRC_Spec_t* Spec;
+} Specs[] = {
+	{"CRC-8/MAXIM-DOW", &TM_CRC_Spec_CRC8_Maxim},
+	{"CRC-16/MODBUS", &TM_CRC_Spec_CRC16_Modbus},
+	{"CRC-16/IBM-3740", &TM_CRC_Spec_CRC16_CCITT},
+	{"CRC-32/ISO-HDLC", &TM_CRC_Spec_CRC32_ISO_HDLC},
+	{"CRC-7/MMC", &Spec_CRC7_MMC},
+	{"CRC-12/DECT", &Spec_CRC12_DECT},
+	{"CRC-32/MPEG-2", &Spec_CRC32_MPEG2},
+	{"CRC-5/USB", &Spec_CRC5_USB},
+};
+
+static uint32_t Table[TM_CRC_TABLE_SIZE];
+static uint8_t Random[1000];
+
+/* Calculates check string in parts of given size */
+static uint32_t CheckSplit(TM_CRC_Ctx_t* Ctx, uint32_t Part) {
+	const char* str = "123456789";
+	uint32_t i, len;
+
+	TM_CRC_SpecStart(Ctx);
+	for (i = 0; i < 9; i += len) {
+		len = 9 - i < Part ? 9 - i : Part;
+		TM_CRC_SpecUpdate(Ctx, &str[i], len);
+	}
+	return TM_CRC_SpecFinish(Ctx);
+}
+
+int main(void) {
+	TM_CRC_Ctx_t bits, table;
+	uint32_t i, part, a, b;
+	int errors = 0;
+
+	/* Random data */
+	srand(1);
+	for (i = 0; i < sizeof(Random); i++) {
+		Random[i] = (uint8_t)rand();
+	}
+
+	for (i = 0; i < sizeof(Specs) / sizeof(Specs[0]); i++) {
+		TM_CRC_SpecInit(&bits, Specs[i].Spec, NULL);
+		TM_CRC_SpecInit(&table, Specs[i].Spec, Table);
+
+		/* Check value */
+		if (!TM_CRC_SpecCheck(&bits) || !TM_CRC_SpecCheck(&table)) {
+			printf("%-16s FAIL check: bits 0x%08X, table 0x%08X, expected 0x%08X\n", Specs[i].Name,
+				(unsigned)TM_CRC_SpecCalculate(&bits, "123456789", 9), (unsigned)TM_CRC_SpecCalculate(&table, "123456789", 9), (unsigned)Specs[i].Spec->Check);
+			errors++;
+			continue;
+		}
+
+		/* Split updates */
+		for (part = 1; part < 9; part++) {
+			if (CheckSplit(&bits, part) != Specs[i].Spec->Check || CheckSplit(&table, part) != Specs[i].Spec->Check) {
+				printf("%-16s FAIL split to parts of %u bytes\n", Specs[i].Name, (unsigned)part);
+				errors++;
+			}
+		}
+
+		/* Tables and bit by bit give the same result */
+		a = TM_CRC_SpecCalculate(&bits, &Random[1], sizeof(Random) - 1);
+		b = TM_CRC_SpecCalculate(&table, &Random[1], sizeof(Random) - 1);
+		if (a != b) {
+			printf("%-16s FAIL random data: bits 0x%08X, table 0x%08X\n", Specs[i].Name, (unsigned)a, (unsigned)b);
+			errors++;
+		}
+
+		printf("%-16s check 0x%08X OK\n", Specs[i].Name, (unsigned)Specs[i].Spec->Check);
+	}
+
+	/* Print result */
+	printf("%s\n", errors ? "FAILED" : "PASSED");
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Host benchmark for TM FFT library
+ *
+ * Same measurement as 14-STM32Fxxx_FFT_BENCHMARK example, but library is compiled for host computer.
+ * Time per transform is measured for float complex, float real, Q31 and Q15 FFT for each size,
+ * test signal is filled before each transform and its time is included in results, same as on target.
+ * Sizes which are not supported by FFT type are skipped and reported as 0, same as on target.
+ * Index of max bin is checked against fundamental of square wave for each type and size.
+ * Bit reversal used by ARM CFFT functions is only available in assembly for ARM cores,
+ * so C version of it is included in this file.
+ *
+ * Build and run from 00-STM32_LIBRARIES folder, defines.h is taken from FFT benchmark example:
+ *
+ *   gcc -O2 -Wall -DARM_MATH_CM0 -I../00-HAL_DRIVERS/CMSIS/Include -I../14-STM32Fxxx_FFT_BENCHMARK/User \
+ *       -o tm_fft_bench tools/tm_fft_bench.c $(find ../00-HAL_DRIVERS/CMSIS/DSP_Lib/Source -name "*.c") -lm && ./tm_fft_bench
+ *
+ * Program returns 0 when all max bins are correct.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Host replacement for stm32fxxx_hal.h, no peripherals are used by library */
+#define TM_STM32Fxxx_H
+
+/* Library source */
+#include "../tm_stm32_fft.c"
+
+/* C version of arm_bitreversal_32 from arm_bitreversal2.S, table holds byte offsets of 32-bit values */
+void arm_bitreversal_32(uint32_t* pSrc, const uint16_t bitRevLen, const uint16_t* pBitRevTab) {
+	uint32_t i, a, b, t;
+
+	for (i = 0; i < bitRevLen; i += 2) {
+		a = pBitRevTab[i] >> 2;
+		b = pBitRevTab[i + 1] >> 2;
+		t = pSrc[a]; pSrc[a] = pSrc[b]; pSrc[b] = t;
+		t = pSrc[a + 1]; pSrc[a + 1] = pSrc[b + 1]; pSrc[b + 1] = t;
+	}
+}
+
+/* C version of arm_bitreversal_16 from arm_bitreversal2.S, table holds double byte offsets of complex Q15 values */
+void arm_bitreversal_16(uint16_t* pSrc, const uint16_t bitRevLen, const uint16_t* pBitRevTab) {
+	uint32_t i, a, b;
+	uint16_t t;
+
+	for (i = 0; i < bitRevLen; i += 2) {
+		a = pBitRevTab[i] >> 2;
+		b = pBitRevTab[i + 1] >> 2;
+		t = pSrc[a]; pSrc[a] = pSrc[b]; pSrc[b] = t;
+		t = pSrc[a + 1]; pSrc[a + 1] = pSrc[b + 1]; pSrc[b + 1] = t;
+	}
+}
+
+/* FFT sizes from 16 to 4096 */
+#define SIZES               9
+
+/* Number of transforms for each measurement */
+#define REPEAT              1000
+
+/* FFT types */
+#define TYPE_F32            0
+#define TYPE_REAL_F32       1
+#define TYPE_Q31            2
+#define TYPE_Q15            3
+
+static const char* Names[] = {"F32", "RF32", "Q31", "Q15"};
+
+/* Buffers, shared between all types */
+static union {
+	float32_t F32[3 * 4096];
+	q31_t Q31[3 * 4096];
+	q15_t Q15[3 * 4096];
+} Buffer;
+
+/* FFT structures */
+static TM_FFT_F32_t FFT_F32;
+static TM_FFT_Real_F32_t FFT_Real_F32;
+static TM_FFT_Q31_t FFT_Q31;
+static TM_FFT_Q15_t FFT_Q15;
+
+/* Nanoseconds per transform for each type and size, 0 if size is not supported */
+static double Time[4][SIZES];
+
+/* Fills input buffer with square wave with period of 16 samples, same as on target */
+static void FillSignal(uint8_t type, uint16_t size) {
+	uint16_t i;
+	int8_t sign;
+
+	for (i = 0; i < size; i++) {
+		sign = (i & 0x08) ? 1 : -1;
+		switch (type) {
+			case TYPE_F32:
+				TM_FFT_AddToBuffer(&FFT_F32, sign * 0.5f);
+				break;
+			case TYPE_REAL_F32:
+				TM_FFT_AddToBufferReal(&FFT_Real_F32, sign * 0.5f);
+				break;
+			case TYPE_Q31:
+				TM_FFT_AddToBuffer_Q31(&FFT_Q31, sign * 0x40000000);
+				break;
+			default:
+				TM_FFT_AddToBuffer_Q15(&FFT_Q15, sign * 0x4000);
+				break;
+		}
+	}
+}
+
+/* Gets current time in nanoseconds */
+static double Now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Checks that max bin is at fundamental of square wave */
+static int Check(uint8_t type, uint16_t size, uint32_t index) {
+	if (index != size / 16) {
+		printf("%s FAIL size %u: max bin %u, expected %u\n", Names[type], (unsigned)size, (unsigned)index, (unsigned)(size / 16));
+		return 1;
+	}
+	return 0;
+}
+
+int main(void) {
+	uint16_t size;
+	uint8_t i;
+	uint32_t r;
+	double start;
+	int errors = 0;
+
+	/* Run benchmark for each size */
+	for (i = 0, size = 16; i < SIZES; i++, size <<= 1) {
+		/* Float complex FFT */
+		if (TM_FFT_Init_F32(&FFT_F32, size, 0) == 0) {
+			TM_FFT_SetBuffers_F32(&FFT_F32, Buffer.F32, &Buffer.F32[2 * size]);
+			start = Now();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_F32, size);
+				TM_FFT_Process_F32(&FFT_F32);
+			}
+			Time[TYPE_F32][i] = (Now() - start) / REPEAT;
+			errors += Check(TYPE_F32, size, FFT_F32.MaxIndex);
+		}
+
+		/* Float real FFT */
+		if (TM_FFT_Init_Real_F32(&FFT_Real_F32, size, 0) == 0) {
+			TM_FFT_SetBuffers_Real_F32(&FFT_Real_F32, Buffer.F32, &Buffer.F32[size]);
+			start = Now();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_REAL_F32, size);
+				TM_FFT_Process_Real_F32(&FFT_Real_F32);
+				TM_FFT_Magnitude_Real_F32(&FFT_Real_F32, Buffer.F32);
+			}
+			Time[TYPE_REAL_F32][i] = (Now() - start) / REPEAT;
+			errors += Check(TYPE_REAL_F32, size, FFT_Real_F32.MaxIndex);
+		}
+
+		/* Q31 FFT */
+		if (TM_FFT_Init_Q31(&FFT_Q31, size, 0) == 0) {
+			TM_FFT_SetBuffers_Q31(&FFT_Q31, Buffer.Q31, &Buffer.Q31[2 * size]);
+			start = Now();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_Q31, size);
+				TM_FFT_Process_Q31(&FFT_Q31);
+			}
+			Time[TYPE_Q31][i] = (Now() - start) / REPEAT;
+			errors += Check(TYPE_Q31, size, FFT_Q31.MaxIndex);
+		}
+
+		/* Q15 FFT */
+		if (TM_FFT_Init_Q15(&FFT_Q15, size, 0) == 0) {
+			TM_FFT_SetBuffers_Q15(&FFT_Q15, Buffer.Q15, &Buffer.Q15[2 * size]);
+			start = Now();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_Q15, size);
+				TM_FFT_Process_Q15(&FFT_Q15);
+			}
+			Time[TYPE_Q15][i] = (Now() - start) / REPEAT;
+			errors += Check(TYPE_Q15, size, FFT_Q15.MaxIndex);
+		}
+	}
+
+	/* Print results, 0 when size is not supported by FFT type */
+	printf("Nanoseconds per FFT\n");
+	printf(" Size       F32      RF32       Q31       Q15\n");
+	for (i = 0, size = 16; i < SIZES; i++, size <<= 1) {
+		printf("%5u %9.0f %9.0f %9.0f %9.0f\n", (unsigned)size,
+			Time[TYPE_F32][i], Time[TYPE_REAL_F32][i], Time[TYPE_Q31][i], Time[TYPE_Q15][i]);
+	}
+	printf("%s\n", errors ? "FAILED" : "PASSED");
+	return errors ? 1 : 0;
+}
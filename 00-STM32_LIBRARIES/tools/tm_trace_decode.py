@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Decoder for TM TRACE binary stream
+#
+# Reads frames exported with TM_TRACE_Export from file (captured from USART or USB CDC)
+# and writes Chrome trace JSON file, which can be opened in chrome://tracing or Perfetto.
+#
+# Usage: python tm_trace_decode.py capture.bin -o trace.json [--names names.txt]
+#
+# Names file has one event per line: "<id> <name>", lines starting with # are ignored.
+#
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"TMTR"
+HEADER = struct.Struct("<4sHHI")
+RECORD = struct.Struct("<IHBBII")
+
+TYPE_ENTER = 0
+TYPE_EXIT = 1
+TYPE_MARK = 2
+TYPE_COUNTER = 3
+TYPE_TASKSWITCH = 4
+
+# Thread ID used for task switches
+TASKS_TID = 1000
+
+
+def read_names(path):
+    names = {}
+    if path:
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+                parts = line.split(None, 1)
+                names[int(parts[0], 0)] = parts[1] if len(parts) > 1 else parts[0]
+    return names
+
+
+def read_frames(data):
+    """Find frames in stream and return list of records, frequency and number of lost records"""
+    records = []
+    freq = 0
+    lost = 0
+    pos = 0
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + HEADER.size > len(data):
+            break
+        _, count, frame_lost, frame_freq = HEADER.unpack_from(data, pos)
+        end = pos + HEADER.size + count * RECORD.size
+        if end > len(data) or frame_freq == 0:
+            # Incomplete frame or magic inside data, search again
+            pos += 1
+            continue
+        freq = frame_freq
+        lost += frame_lost
+        for i in range(count):
+            low, high, typ, eid, arg, seq = RECORD.unpack_from(data, pos + HEADER.size + i * RECORD.size)
+            records.append((low | (high << 32), typ, eid, arg, seq))
+        pos = end
+    return records, freq, lost
+
+
+def decode(records, freq, names):
+    events = []
+    task = None
+    records.sort(key=lambda r: (r[0], r[4]))
+
+    def name(eid):
+        return names.get(eid, "event %d" % eid)
+
+    for time, typ, eid, arg, seq in records:
+        ts = time * 1000000.0 / freq
+        if typ == TYPE_ENTER:
+            events.append({"name": name(eid), "ph": "B", "ts": ts, "pid": 0, "tid": eid})
+        elif typ == TYPE_EXIT:
+            events.append({"name": name(eid), "ph": "E", "ts": ts, "pid": 0, "tid": eid})
+        elif typ == TYPE_MARK:
+            events.append({"name": name(eid), "ph": "i", "s": "g", "ts": ts, "pid": 0, "tid": eid, "args": {"arg": arg}})
+        elif typ == TYPE_COUNTER:
+            events.append({"name": name(eid), "ph": "C", "ts": ts, "pid": 0, "args": {"value": arg}})
+        elif typ == TYPE_TASKSWITCH:
+            if task is not None:
+                events.append({"name": "task %d" % task, "ph": "E", "ts": ts, "pid": 0, "tid": TASKS_TID})
+            task = eid
+            events.append({"name": "task %d" % task, "ph": "B", "ts": ts, "pid": 0, "tid": TASKS_TID})
+
+    # Thread names
+    for tid in sorted(set(e["tid"] for e in events if "tid" in e)):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid,
+                       "args": {"name": "tasks" if tid == TASKS_TID else name(tid)}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert TM TRACE binary stream to Chrome trace JSON")
+    parser.add_argument("input", help="captured binary stream")
+    parser.add_argument("-o", "--output", default="trace.json", help="output JSON file")
+    parser.add_argument("--names", help="file with event names")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    records, freq, lost = read_frames(data)
+    if not records:
+        sys.exit("No records found")
+
+    events = decode(records, freq, read_names(args.names))
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+
+    print("%d records, %d lost, clock %d Hz" % (len(records), lost, freq))
+
+
+if __name__ == "__main__":
+    main()
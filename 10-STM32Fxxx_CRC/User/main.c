@@ -30,7 +30,24 @@ uint32_t data[16] = {
 /* Result variable */
 uint32_t result;
 
+/* Predefined specifications to check */
+const TM_CRC_Spec_t* Specs[] = {
+	&TM_CRC_Spec_CRC8_Maxim,
+	&TM_CRC_Spec_CRC16_Modbus,
+	&TM_CRC_Spec_CRC16_CCITT,
+	&TM_CRC_Spec_CRC32_ISO_HDLC
+};
+
+/* Context and slicing-by-8 table for CRC with custom parameters */
+TM_CRC_Ctx_t Ctx;
+uint32_t Table[TM_CRC_TABLE_SIZE];
+
+/* Number of passed checks */
+uint8_t checks;
+
 int main(void) {
+	uint8_t i;
+	
 	/* Init system clock for maximum system speed */
 	TM_RCC_InitSystem();
 	
@@ -49,6 +66,23 @@ int main(void) {
 	/* Calculate CRC from block of 32-bits data array, 16 elements in array, reset CRC unit before start with calculation */
 	result = TM_CRC_Calculate32(data, 16, 1);
 	
+	/* Check CRC of "123456789" for all predefined specifications, with table (or hardware) and bit by bit */
+	checks = 0;
+	for (i = 0; i < sizeof(Specs) / sizeof(Specs[0]); i++) {
+		TM_CRC_SpecInit(&Ctx, Specs[i], Table);
+		checks += TM_CRC_SpecCheck(&Ctx);
+		TM_CRC_SpecInit(&Ctx, Specs[i], NULL);
+		checks += TM_CRC_SpecCheck(&Ctx);
+	}
+	
+	/* Green LED when all checks passed, red otherwise */
+	TM_DISCO_LedOff(LED_ALL);
+	if (checks == 2 * sizeof(Specs) / sizeof(Specs[0])) {
+		TM_DISCO_LedOn(LED_GREEN);
+	} else {
+		TM_DISCO_LedOn(LED_RED);
+	}
+	
 	while (1) {
 		/* Do nothing */
 	}
@@ -0,0 +1,228 @@
+/**
+ * Keil project example for FFT benchmark
+ *
+ * Measures number of CPU cycles per transform for float complex, float real,
+ * Q31 and Q15 FFT for each supported size.
+ *
+ * Results are saved to Cycles array, which can be checked with debugger,
+ * and are printed on LCD on boards with LCD. LCD is not used on STM32F0xx.
+ *
+ * Before you start, select your target, on the right of the "Load" button
+ *
+ * @author    Tilen MAJERLE
+ * @email     tilen@majerle.eu
+ * @website   http://stm32f4-discovery.net
+ * @ide       Keil uVision 5
+ * @conf      PLL parameters are set in "Options for Target" -> "C/C++" -> "Defines"
+ * @packs     STM32F0xx/STM32F4xx/STM32F7xx Keil packs are requred with HAL driver support
+ * @stdperiph STM32F0xx/STM32F4xx/STM32F7xx HAL drivers required
+ *	Notes: 
+ *		- Under "Options for target" > "C/C++" > "Define" you must add 2 defines (I've already add them):
+ *			- ARM_MATH_CM0, ARM_MATH_CM4 or ARM_MATH_CM7
+ *			- __FPU_PRESENT=1 on STM32F4xx and STM32F7xx
+ */
+/* Include core modules */
+#include "stm32fxxx_hal.h"
+/* Include my libraries here */
+#include "defines.h"
+#include "tm_stm32_disco.h"
+#include "tm_stm32_delay.h"
+#include "tm_stm32_fft.h"
+#if !defined(STM32F0xx)
+#include "tm_stm32_general.h"
+#include "tm_stm32_lcd.h"
+#include "stdio.h"
+#endif
+
+/* Maximal FFT size, limited by RAM */
+#if defined(STM32F0xx)
+#define MAX_SIZE            512
+#else
+#define MAX_SIZE            4096
+#endif
+
+/* Number of sizes from 16 to MAX_SIZE */
+#if MAX_SIZE == 512
+#define SIZES               6
+#else
+#define SIZES               9
+#endif
+
+/* Number of transforms for each measurement */
+#define REPEAT              4
+
+/* FFT types */
+#define TYPE_F32            0
+#define TYPE_REAL_F32       1
+#define TYPE_Q31            2
+#define TYPE_Q15            3
+
+/* Buffers, shared between all types */
+static union {
+	float32_t F32[3 * MAX_SIZE];
+	q31_t Q31[3 * MAX_SIZE];
+	q15_t Q15[3 * MAX_SIZE];
+} Buffer;
+
+/* FFT structures */
+TM_FFT_F32_t FFT_F32;
+TM_FFT_Real_F32_t FFT_Real_F32;
+TM_FFT_Q31_t FFT_Q31;
+TM_FFT_Q15_t FFT_Q15;
+
+/* Cycles per transform for each type and size, 0 if size is not supported */
+uint32_t Cycles[4][SIZES];
+
+/* Starts cycle counter */
+static void Counter_Init(void);
+
+/* Gets current cycle counter value */
+static uint32_t Counter_Get(void);
+
+/* Fills input buffer of selected FFT type with test signal */
+static void FillSignal(uint8_t type, uint16_t size);
+
+int main(void) {
+	uint16_t size;
+	uint8_t i, r;
+	uint32_t start;
+#if !defined(STM32F0xx)
+	char str[50];
+#endif
+	
+	/* Init system clock for maximum system speed */
+	TM_RCC_InitSystem();
+	
+	/* Init HAL layer */
+	HAL_Init();
+	
+	/* Init cycle counter */
+	Counter_Init();
+	
+	/* Run benchmark for each size */
+	for (i = 0, size = 16; i < SIZES; i++, size <<= 1) {
+		/* Float complex FFT */
+		if (TM_FFT_Init_F32(&FFT_F32, size, 0) == 0) {
+			TM_FFT_SetBuffers_F32(&FFT_F32, Buffer.F32, &Buffer.F32[2 * size]);
+			start = Counter_Get();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_F32, size);
+				TM_FFT_Process_F32(&FFT_F32);
+			}
+			Cycles[TYPE_F32][i] = (Counter_Get() - start) / REPEAT;
+		}
+		
+		/* Float real FFT */
+		if (TM_FFT_Init_Real_F32(&FFT_Real_F32, size, 0) == 0) {
+			TM_FFT_SetBuffers_Real_F32(&FFT_Real_F32, Buffer.F32, &Buffer.F32[size]);
+			start = Counter_Get();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_REAL_F32, size);
+				TM_FFT_Process_Real_F32(&FFT_Real_F32);
+				TM_FFT_Magnitude_Real_F32(&FFT_Real_F32, Buffer.F32);
+			}
+			Cycles[TYPE_REAL_F32][i] = (Counter_Get() - start) / REPEAT;
+		}
+		
+		/* Q31 FFT */
+		if (TM_FFT_Init_Q31(&FFT_Q31, size, 0) == 0) {
+			TM_FFT_SetBuffers_Q31(&FFT_Q31, Buffer.Q31, &Buffer.Q31[2 * size]);
+			start = Counter_Get();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_Q31, size);
+				TM_FFT_Process_Q31(&FFT_Q31);
+			}
+			Cycles[TYPE_Q31][i] = (Counter_Get() - start) / REPEAT;
+		}
+		
+		/* Q15 FFT */
+		if (TM_FFT_Init_Q15(&FFT_Q15, size, 0) == 0) {
+			TM_FFT_SetBuffers_Q15(&FFT_Q15, Buffer.Q15, &Buffer.Q15[2 * size]);
+			start = Counter_Get();
+			for (r = 0; r < REPEAT; r++) {
+				FillSignal(TYPE_Q15, size);
+				TM_FFT_Process_Q15(&FFT_Q15);
+			}
+			Cycles[TYPE_Q15][i] = (Counter_Get() - start) / REPEAT;
+		}
+	}
+	
+#if !defined(STM32F0xx)
+	/* Print results on LCD if available */
+	if (TM_LCD_Init() == TM_LCD_Result_Ok) {
+		TM_LCD_SetFont(&TM_Font_7x10);
+		TM_LCD_SetXY(10, 10);
+		TM_LCD_Puts("Cycles per FFT");
+		TM_LCD_SetXY(10, 30);
+		TM_LCD_Puts(" Size      F32    RF32     Q31     Q15");
+		for (i = 0, size = 16; i < SIZES; i++, size <<= 1) {
+			sprintf(str, "%5u %8u%8u%8u%8u", size,
+				(unsigned)Cycles[TYPE_F32][i], (unsigned)Cycles[TYPE_REAL_F32][i],
+				(unsigned)Cycles[TYPE_Q31][i], (unsigned)Cycles[TYPE_Q15][i]);
+			TM_LCD_SetXY(10, 45 + 15 * i);
+			TM_LCD_Puts(str);
+		}
+	}
+#endif
+	
+	/* Benchmark done */
+	TM_DISCO_LedInit();
+	TM_DISCO_LedOn(LED_ALL);
+	
+	while (1) {
+		
+	}
+}
+
+/* Fills input buffer with square wave, time is included in results */
+static void FillSignal(uint8_t type, uint16_t size) {
+	uint16_t i;
+	int8_t sign;
+	
+	for (i = 0; i < size; i++) {
+		sign = (i & 0x08) ? 1 : -1;
+		switch (type) {
+			case TYPE_F32:
+				TM_FFT_AddToBuffer(&FFT_F32, sign * 0.5f);
+				break;
+			case TYPE_REAL_F32:
+				TM_FFT_AddToBufferReal(&FFT_Real_F32, sign * 0.5f);
+				break;
+			case TYPE_Q31:
+				TM_FFT_AddToBuffer_Q31(&FFT_Q31, sign * 0x40000000);
+				break;
+			default:
+				TM_FFT_AddToBuffer_Q15(&FFT_Q15, sign * 0x4000);
+				break;
+		}
+	}
+}
+
+#if defined(DWT)
+/* Use DWT cycle counter on Cortex-M4 and Cortex-M7, it is not reset and only differences are used */
+static void Counter_Init(void) {
+	TM_GENERAL_DWTCounterEnable();
+}
+
+static uint32_t Counter_Get(void) {
+	return TM_GENERAL_DWTCounterGetValue();
+}
+#else
+/* Cortex-M0 does not have DWT counter, use SysTick which runs at core clock with 1ms period */
+static void Counter_Init(void) {
+	
+}
+
+static uint32_t Counter_Get(void) {
+	uint32_t tick, val;
+	
+	/* Read until tick did not change */
+	do {
+		tick = HAL_GetTick();
+		val = SysTick->VAL;
+	} while (tick != HAL_GetTick());
+	
+	/* Calculate cycles */
+	return tick * (SysTick->LOAD + 1) + (SysTick->LOAD - val);
+}
+#endif
@@ -3,6 +3,9 @@
  *
  * This example works for STM32F4xx and STM32F7xx devices only!
  *
+ * At the end, FIR filter bank for 8 interleaved channels is compared with 8 separate FIR filters.
+ * Cycles per block are saved to Bank_Cycles and Channel_Cycles variables and printed on LCD.
+ *
  * Before you start, select your target, on the right of the "Load" button
  *
  * @author    Tilen MAJERLE
@@ -22,6 +25,7 @@
 #include "tm_stm32_usart.h"
 #include "tm_stm32_lcd.h"
 #include "tm_stm32_filters.h"
+#include "stdio.h"
 
 #define SAMPLING_FREQ      100.0f /* We virtually have 100 samples per second */
 #define SIN_FREQ           1.1f
@@ -61,7 +65,25 @@ const float32_t IIRFilter_Coeffs[5] = {
 	1.0, -1.0, 0, 0.95, 0
 };
 
+/* Filter bank benchmark, 8 interleaved channels, 16 samples per channel per block */
+#define BANK_CHANNELS      8
+#define BANK_BLOCK         16
+
+/* Filter bank and separate filter for each channel with the same coefficients */
+TM_FILTER_FIR_BANK_F32_DEFINE(Bank, BANK_CHANNELS, 51, BANK_BLOCK);
+TM_FILTER_FIR_F32_t Channel_FIR[BANK_CHANNELS];
+float32_t Channel_States[BANK_CHANNELS][TM_FILTER_FIR_F32_STATES(51, BANK_BLOCK)];
+
+/* Interleaved input and output, de-interleaved data for separate filters */
+float32_t Bank_In[BANK_CHANNELS * BANK_BLOCK];
+float32_t Bank_Out[BANK_CHANNELS * BANK_BLOCK];
+float32_t Channel_In[BANK_BLOCK], Channel_Out[BANK_BLOCK];
+
+/* Cycles per block for filter bank and for separate filters */
+uint32_t Bank_Cycles, Channel_Cycles;
+
 /* Private functions */
+static void Bank_Benchmark(void);
 static void LCD_DrawSignal(float32_t* InputArray, size_t size, uint16_t color);
 
 /* Filter instances */
@@ -141,12 +163,61 @@ int main(void) {
 		TM_LCD_Puts("FIR Init failed! Increase heap memory!");
 	}
 	
+	/*****************************************/
+	/* FIR filter bank benchmark             */
+	/*****************************************/
+	Bank_Benchmark();
+	
 	/* Do nothing */
 	while (1) {
 		
 	}
 }
 
+/* Measures cycles for filter bank and for the same filter on each channel separately */
+static void Bank_Benchmark(void) {
+	uint32_t start;
+	uint16_t i, ch;
+	char str[50];
+	
+	/* Enable DWT cycle counter */
+	TM_DELAY_Init();
+	
+	/* Fill interleaved samples */
+	for (i = 0; i < BANK_CHANNELS * BANK_BLOCK; i++) {
+		Bank_In[i] = Data[i];
+	}
+	
+	/* Init filters */
+	TM_FILTER_FIR_BANK_F32_INIT_STATIC(Bank, BANK_CHANNELS, FIRFilter_CoeffsSize, FIRFilter_Coeffs, 0, BANK_BLOCK);
+	for (ch = 0; ch < BANK_CHANNELS; ch++) {
+		TM_FILTER_FIR_F32_InitStatic(&Channel_FIR[ch], FIRFilter_CoeffsSize, FIRFilter_Coeffs, Channel_States[ch], BANK_BLOCK);
+	}
+	
+	/* Filter bank, one call for all channels */
+	start = DWT->CYCCNT;
+	TM_FILTER_FIR_BANK_F32_Process(&Bank, Bank_In, Bank_Out);
+	Bank_Cycles = DWT->CYCCNT - start;
+	
+	/* Separate filters, de-interleave, arm_fir_f32 and interleave back for each channel */
+	start = DWT->CYCCNT;
+	for (ch = 0; ch < BANK_CHANNELS; ch++) {
+		for (i = 0; i < BANK_BLOCK; i++) {
+			Channel_In[i] = Bank_In[i * BANK_CHANNELS + ch];
+		}
+		TM_FILTER_FIR_F32_Process(&Channel_FIR[ch], Channel_In, Channel_Out);
+		for (i = 0; i < BANK_BLOCK; i++) {
+			Bank_Out[i * BANK_CHANNELS + ch] = Channel_Out[i];
+		}
+	}
+	Channel_Cycles = DWT->CYCCNT - start;
+	
+	/* Show results */
+	sprintf(str, "FIR bank: %u, %u x FIR: %u cycles", (unsigned)Bank_Cycles, BANK_CHANNELS, (unsigned)Channel_Cycles);
+	TM_LCD_SetXY(0, 60);
+	TM_LCD_Puts(str);
+}
+
 /* Draws graph to LCD */
 static void LCD_DrawSignal(float32_t* InputArray, size_t size, uint16_t color) {
 	float32_t sx, sy, nx, ny;
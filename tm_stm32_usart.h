@@ -0,0 +1,6 @@
+#pragma once
+typedef enum { TM_USART_PinsPack_1, TM_USART_PinsPack_2 } TM_USART_PinsPack_t;
+void TM_USART_Init(USART_TypeDef*, TM_USART_PinsPack_t, uint32_t);
+uint8_t TM_USART_BufferEmpty(USART_TypeDef*);
+uint8_t TM_USART_Getc(USART_TypeDef*);
+void TM_USART_Send(USART_TypeDef*, uint8_t*, uint16_t);